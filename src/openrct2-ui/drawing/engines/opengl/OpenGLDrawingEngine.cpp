@@ -312,6 +312,16 @@ public:
                        ->InvalidateImage(image);
     }
 
+    const drawing_engine_stats * GetStats() override
+    {
+        // The whole screen is redrawn every frame
+        return nullptr;
+    }
+
+    void ResetStats() override
+    {
+    }
+
     rct_drawpixelinfo * GetDPI()
     {
         return &_bitsDPI;
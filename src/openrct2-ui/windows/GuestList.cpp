@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include <cmath>
+#include <vector>
 
 #include <openrct2/config/Config.h>
 #include <openrct2-ui/windows/Window.h>
@@ -90,6 +91,10 @@ static rct_widget window_guest_list_widgets[] = {
 };
 
 static constexpr const uint8_t SUMMARISED_GUEST_ROW_HEIGHT = SCROLLABLE_ROW_HEIGHT + 11;
+static constexpr const int32_t GUESTS_PER_PAGE = 3173;
+static constexpr const int32_t GUEST_PAGE_HEIGHT = GUESTS_PER_PAGE * SCROLLABLE_ROW_HEIGHT;
+// Number of window updates before the individual guest list is rebuilt to pick up guest state changes
+static constexpr const uint32_t GUEST_LIST_REFRESH_INTERVAL = 40;
 
 static void window_guest_list_mouseup(rct_window *w, rct_widgetindex widgetIndex);
 static void window_guest_list_resize(rct_window *w);
@@ -159,12 +164,20 @@ static uint8_t _window_guest_list_group_index[240];
 
 static char _window_guest_list_filter_name[32];
 
+// Sprite indices of the guests shown on the individual tab, in list order
+static std::vector<uint16_t> _window_guest_list_guests;
+static bool _window_guest_list_guests_invalid;
+static uint32_t _window_guest_list_guests_refresh_wait;
+
 static int32_t window_guest_list_is_peep_in_filter(rct_peep* peep);
 static void window_guest_list_find_groups();
 
 static void get_arguments_from_peep(rct_peep *peep, uint32_t *argument_1, uint32_t* argument_2);
 
 static bool guest_should_be_visible(rct_peep *peep);
+static void window_guest_list_invalidate_guests();
+static void window_guest_list_build_guests();
+static rct_peep * window_guest_list_get_guest(size_t index);
 
 void window_guest_list_init_vars()
 {
@@ -173,6 +186,8 @@ void window_guest_list_init_vars()
     _window_guest_list_last_find_groups_tick = 0xFFFFFFFF;
     _window_guest_list_selected_filter = 0xFF;
     _window_guest_list_last_find_groups_wait = 0;
+    _window_guest_list_guests.clear();
+    _window_guest_list_guests_invalid = true;
 }
 
 /**
@@ -211,6 +226,7 @@ rct_window * window_guest_list_open()
     _window_guest_list_num_pages = 1;
     _window_guest_list_tracking_only = false;
     _window_guest_list_filter_name[0] = '\0';
+    window_guest_list_invalidate_guests();
     window_guest_list_widgets[WIDX_TRACKING].type = WWT_FLATBTN;
     window_guest_list_widgets[WIDX_FILTER_BY_NAME].type = WWT_FLATBTN;
     window_guest_list_widgets[WIDX_PAGE_DROPDOWN].type = WWT_EMPTY;
@@ -229,6 +245,7 @@ void window_guest_list_refresh_list()
     _window_guest_list_last_find_groups_wait = 0;
     _window_guest_list_last_find_groups_tick = 0;
     window_guest_list_find_groups();
+    window_guest_list_invalidate_guests();
 }
 
 /**
@@ -305,6 +322,7 @@ rct_window * window_guest_list_open_with_filter(int32_t type, int32_t index)
         break;
     }
     }
+    window_guest_list_invalidate_guests();
 
     return w;
 }
@@ -328,6 +346,7 @@ static void window_guest_list_mouseup(rct_window *w, rct_widgetindex widgetIndex
             w->pressed_widgets |= (1 << WIDX_TRACKING);
         else
             w->pressed_widgets &= ~(1 << WIDX_TRACKING);
+        window_guest_list_invalidate_guests();
         window_invalidate(w);
         w->scrolls[0].v_top = 0;
         break;
@@ -337,6 +356,7 @@ static void window_guest_list_mouseup(rct_window *w, rct_widgetindex widgetIndex
             // Unset the search filter.
             _window_guest_list_filter_name[0] = '\0';
             w->pressed_widgets &= ~(1 << WIDX_FILTER_BY_NAME);
+            window_guest_list_invalidate_guests();
         }
         else
         {
@@ -398,6 +418,7 @@ static void window_guest_list_mousedown(rct_window *w, rct_widgetindex widgetInd
         window_guest_list_widgets[WIDX_PAGE_DROPDOWN_BUTTON].type = WWT_EMPTY;
         w->list_information_type = 0;
         _window_guest_list_selected_filter = -1;
+        window_guest_list_invalidate_guests();
         window_invalidate(w);
         w->scrolls[0].v_top = 0;
         break;
@@ -476,6 +497,13 @@ static void window_guest_list_update(rct_window *w)
     if (_window_guest_list_last_find_groups_wait != 0) {
         _window_guest_list_last_find_groups_wait--;
     }
+    if (_window_guest_list_guests_refresh_wait != 0) {
+        _window_guest_list_guests_refresh_wait--;
+    } else if (_window_guest_list_selected_tab == PAGE_INDIVIDUAL) {
+        // Guests change action, thoughts and location all the time, so periodically refresh the list
+        window_guest_list_invalidate_guests();
+        window_invalidate(w);
+    }
     w->list_information_type++;
     if (w->list_information_type >= (_window_guest_list_selected_tab == PAGE_INDIVIDUAL ? 24 : 32))
         w->list_information_type = 0;
@@ -488,27 +516,17 @@ static void window_guest_list_update(rct_window *w)
  */
 static void window_guest_list_scrollgetsize(rct_window *w, int32_t scrollIndex, int32_t *width, int32_t *height)
 {
-    int32_t i, y, numGuests, spriteIndex;
-    rct_peep *peep;
+    int32_t i, y, numGuests;
 
     switch (_window_guest_list_selected_tab) {
     case PAGE_INDIVIDUAL:
-        // Count the number of guests
-        numGuests = 0;
+        if (_window_guest_list_guests_invalid)
+            window_guest_list_build_guests();
 
-        FOR_ALL_GUESTS(spriteIndex, peep) {
-            if (peep->outside_of_park != 0)
-                continue;
-            if (_window_guest_list_selected_filter != -1)
-                if (window_guest_list_is_peep_in_filter(peep))
-                    continue;
-            if (!guest_should_be_visible(peep))
-                continue;
-            numGuests++;
-        }
+        numGuests = (int32_t)_window_guest_list_guests.size();
         w->var_492 = numGuests;
         y = numGuests * SCROLLABLE_ROW_HEIGHT;
-        _window_guest_list_num_pages = (int32_t) std::ceil((float)numGuests / 3173);
+        _window_guest_list_num_pages = (int32_t) std::ceil((float)numGuests / GUESTS_PER_PAGE);
         if (_window_guest_list_num_pages == 0)
             _window_guest_list_selected_page = 0;
         else if (_window_guest_list_selected_page >= _window_guest_list_num_pages)
@@ -527,11 +545,11 @@ static void window_guest_list_scrollgetsize(rct_window *w, int32_t scrollIndex,
 
     i = _window_guest_list_selected_page;
     for (i = _window_guest_list_selected_page - 1; i >= 0; i--)
-        y -= 0x7BF2;
+        y -= GUEST_PAGE_HEIGHT;
     if (y < 0)
         y = 0;
-    if (y > 0x7BF2)
-        y = 0x7BF2;
+    if (y > GUEST_PAGE_HEIGHT)
+        y = GUEST_PAGE_HEIGHT;
     if (_window_guest_list_highlighted_index != -1) {
         _window_guest_list_highlighted_index = -1;
         window_invalidate(w);
@@ -555,30 +573,17 @@ static void window_guest_list_scrollgetsize(rct_window *w, int32_t scrollIndex,
  */
 static void window_guest_list_scrollmousedown(rct_window *w, int32_t scrollIndex, int32_t x, int32_t y)
 {
-    int32_t i, spriteIndex;
+    int32_t i;
     rct_peep *peep;
 
     switch (_window_guest_list_selected_tab) {
     case PAGE_INDIVIDUAL:
         i = y / SCROLLABLE_ROW_HEIGHT;
-        i += _window_guest_list_selected_page * 3173;
-        FOR_ALL_GUESTS(spriteIndex, peep) {
-            if (peep->outside_of_park != 0)
-                continue;
-            if (_window_guest_list_selected_filter != -1)
-                if (window_guest_list_is_peep_in_filter(peep))
-                    continue;
-            if (!guest_should_be_visible(peep))
-                continue;
-
-            if (i == 0) {
-                // Open guest window
-                window_guest_open(peep);
-
-                break;
-            } else {
-                i--;
-            }
+        i += _window_guest_list_selected_page * GUESTS_PER_PAGE;
+        peep = window_guest_list_get_guest(i);
+        if (peep != nullptr) {
+            // Open guest window
+            window_guest_open(peep);
         }
         break;
     case PAGE_SUMMARISED:
@@ -589,6 +594,7 @@ static void window_guest_list_scrollmousedown(rct_window *w, int32_t scrollIndex
             _window_guest_list_selected_filter = _window_guest_list_selected_view;
             _window_guest_list_selected_tab = PAGE_INDIVIDUAL;
             window_guest_list_widgets[WIDX_TRACKING].type = WWT_FLATBTN;
+            window_guest_list_invalidate_guests();
             window_invalidate(w);
             w->scrolls[0].v_top = 0;
         }
@@ -605,7 +611,7 @@ static void window_guest_list_scrollmouseover(rct_window *w, int32_t scrollIndex
     int32_t i;
 
     i = y / (_window_guest_list_selected_tab == PAGE_INDIVIDUAL ? SCROLLABLE_ROW_HEIGHT : SUMMARISED_GUEST_ROW_HEIGHT);
-    i += _window_guest_list_selected_page * 3173;
+    i += _window_guest_list_selected_page * GUESTS_PER_PAGE;
     if (i != _window_guest_list_highlighted_index) {
         _window_guest_list_highlighted_index = i;
         window_invalidate(w);
@@ -726,7 +732,7 @@ static void window_guest_list_paint(rct_window *w, rct_drawpixelinfo *dpi)
  */
 static void window_guest_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi, int32_t scrollIndex)
 {
-    int32_t spriteIndex, numGuests, i, j, y;
+    int32_t numGuests, i, j, y;
     rct_string_id format;
     rct_peep *peep;
     rct_peep_thought *thought;
@@ -737,82 +743,74 @@ static void window_guest_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi,
 
     switch (_window_guest_list_selected_tab) {
     case PAGE_INDIVIDUAL:
-        i = 0;
-        y = _window_guest_list_selected_page * -0x7BF2;
-
-        // For each guest
-        FOR_ALL_GUESTS(spriteIndex, peep) {
-            sprite_set_flashing((rct_sprite*)peep, false);
-            if (peep->outside_of_park != 0)
-                continue;
-            if (_window_guest_list_selected_filter != -1) {
-                if (window_guest_list_is_peep_in_filter(peep))
-                    continue;
-                gWindowMapFlashingFlags |= (1 << 0);
-                sprite_set_flashing((rct_sprite*)peep, true);
-            }
-            if (!guest_should_be_visible(peep))
+    {
+        if (_window_guest_list_selected_filter != -1 && !_window_guest_list_guests.empty())
+            gWindowMapFlashingFlags |= (1 << 0);
+
+        // Only visit the rows that intersect the area being drawn
+        int32_t pageOffset = _window_guest_list_selected_page * GUEST_PAGE_HEIGHT;
+        int32_t firstRow = std::max(0, (dpi->y + pageOffset) / SCROLLABLE_ROW_HEIGHT - 1);
+        numGuests = (int32_t)_window_guest_list_guests.size();
+        for (i = firstRow; i < numGuests; i++) {
+            y = i * SCROLLABLE_ROW_HEIGHT - pageOffset;
+            if (y >= 0x7FFF || y >= dpi->y + dpi->height)
+                break;
+            if (y + SCROLLABLE_ROW_HEIGHT + 1 < -0x7FFF || y + SCROLLABLE_ROW_HEIGHT + 1 <= dpi->y)
                 continue;
 
-            // Check if y is beyond the scroll control
-            if (y + SCROLLABLE_ROW_HEIGHT + 1 >= -0x7FFF &&
-                y + SCROLLABLE_ROW_HEIGHT + 1 > dpi->y &&
-                y < 0x7FFF &&
-                y < dpi->y + dpi->height) {
+            peep = window_guest_list_get_guest(i);
+            if (peep == nullptr)
+                continue;
 
-                // Highlight backcolour and text colour (format)
-                format = STR_BLACK_STRING;
-                if (i == _window_guest_list_highlighted_index) {
-                    gfx_filter_rect(dpi, 0, y, 800, y + SCROLLABLE_ROW_HEIGHT - 1, PALETTE_DARKEN_1);
-                    format = STR_WINDOW_COLOUR_2_STRINGID;
-                }
+            // Highlight backcolour and text colour (format)
+            format = STR_BLACK_STRING;
+            if (i == _window_guest_list_highlighted_index) {
+                gfx_filter_rect(dpi, 0, y, 800, y + SCROLLABLE_ROW_HEIGHT - 1, PALETTE_DARKEN_1);
+                format = STR_WINDOW_COLOUR_2_STRINGID;
+            }
 
-                // Guest name
-                set_format_arg(0, rct_string_id, peep->name_string_idx);
-                set_format_arg(2, uint32_t, peep->id);
-                gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 0, y, 113);
+            // Guest name
+            set_format_arg(0, rct_string_id, peep->name_string_idx);
+            set_format_arg(2, uint32_t, peep->id);
+            gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 0, y, 113);
 
-                switch (_window_guest_list_selected_view) {
-                case VIEW_ACTIONS:
-                    // Guest face
-                    gfx_draw_sprite(dpi, get_peep_face_sprite_small(peep), 118, y + 1, 0);
+            switch (_window_guest_list_selected_view) {
+            case VIEW_ACTIONS:
+                // Guest face
+                gfx_draw_sprite(dpi, get_peep_face_sprite_small(peep), 118, y + 1, 0);
 
-                    // Tracking icon
-                    if (peep->peep_flags & PEEP_FLAGS_TRACKING)
-                        gfx_draw_sprite(dpi, STR_ENTER_SELECTION_SIZE, 112, y + 1, 0);
+                // Tracking icon
+                if (peep->peep_flags & PEEP_FLAGS_TRACKING)
+                    gfx_draw_sprite(dpi, STR_ENTER_SELECTION_SIZE, 112, y + 1, 0);
 
-                    // Action
+                // Action
 
-                    get_arguments_from_action(peep, &argument_1, &argument_2);
+                get_arguments_from_action(peep, &argument_1, &argument_2);
 
-                    set_format_arg(0, uint32_t, argument_1);
-                    set_format_arg(4, uint32_t, argument_2);
-                    gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 133, y, 314);
-                    break;
-                case VIEW_THOUGHTS:
-                    // For each thought
-                    for (j = 0; j < PEEP_MAX_THOUGHTS; j++) {
-                        thought = &peep->thoughts[j];
-                        if (thought->type == PEEP_THOUGHT_TYPE_NONE)
-                            break;
-                        if (thought->freshness == 0)
-                            continue;
-                        if (thought->freshness > 5)
-                            break;
-
-                        peep_thought_set_format_args(&peep->thoughts[j]);
-                        gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 118, y, 329);
+                set_format_arg(0, uint32_t, argument_1);
+                set_format_arg(4, uint32_t, argument_2);
+                gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 133, y, 314);
+                break;
+            case VIEW_THOUGHTS:
+                // For each thought
+                for (j = 0; j < PEEP_MAX_THOUGHTS; j++) {
+                    thought = &peep->thoughts[j];
+                    if (thought->type == PEEP_THOUGHT_TYPE_NONE)
                         break;
-                    }
+                    if (thought->freshness == 0)
+                        continue;
+                    if (thought->freshness > 5)
+                        break;
+
+                    peep_thought_set_format_args(&peep->thoughts[j]);
+                    gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 118, y, 329);
                     break;
                 }
+                break;
             }
-
-            // Increment list item index and y
-            i++;
-            y += SCROLLABLE_ROW_HEIGHT;
         }
         break;
+    }
     case PAGE_SUMMARISED:
         y = 0;
 
@@ -858,6 +856,7 @@ static void window_guest_list_textinput(rct_window *w, rct_widgetindex widgetInd
     {
         safe_strcpy(_window_guest_list_filter_name, text, sizeof(_window_guest_list_filter_name));
         w->pressed_widgets |= (1 << WIDX_FILTER_BY_NAME);
+        window_guest_list_invalidate_guests();
     }
 }
 
@@ -1064,3 +1063,54 @@ static bool guest_should_be_visible(rct_peep *peep)
 
     return true;
 }
+
+static void window_guest_list_invalidate_guests()
+{
+    _window_guest_list_guests_invalid = true;
+}
+
+/**
+ * Rebuilds the list of guests shown on the individual tab so that painting and hit testing
+ * only need to look at the visible rows rather than filtering every guest in the park.
+ */
+static void window_guest_list_build_guests()
+{
+    uint16_t spriteIndex;
+    rct_peep *peep;
+
+    _window_guest_list_guests.clear();
+    _window_guest_list_guests_invalid = false;
+    _window_guest_list_guests_refresh_wait = GUEST_LIST_REFRESH_INTERVAL;
+
+    FOR_ALL_GUESTS(spriteIndex, peep) {
+        sprite_set_flashing((rct_sprite*)peep, false);
+        if (peep->outside_of_park != 0)
+            continue;
+        if (_window_guest_list_selected_filter != -1) {
+            if (window_guest_list_is_peep_in_filter(peep))
+                continue;
+            sprite_set_flashing((rct_sprite*)peep, true);
+        }
+        if (!guest_should_be_visible(peep))
+            continue;
+
+        _window_guest_list_guests.push_back(spriteIndex);
+    }
+}
+
+/**
+ * Gets the guest at the given list index, or nullptr if the guest has left since the list was built.
+ * The list is then rebuilt on the next update so that the guest count is correct again.
+ */
+static rct_peep * window_guest_list_get_guest(size_t index)
+{
+    if (index >= _window_guest_list_guests.size())
+        return nullptr;
+
+    rct_peep * peep = GET_PEEP(_window_guest_list_guests[index]);
+    if (peep->sprite_identifier != SPRITE_IDENTIFIER_PEEP || peep->type != PEEP_TYPE_GUEST || peep->outside_of_park != 0) {
+        window_guest_list_invalidate_guests();
+        return nullptr;
+    }
+    return peep;
+}
@@ -170,10 +170,19 @@ static rct_window_event_list window_map_events = {
 static uint8_t _activeTool;
 
 /** rct2: 0x00F1AD6C */
-static uint32_t _currentLine;
+static uint32_t _currentLine[4];
+
+// Not every change to the map is reported as a changed tile (e.g. ride colours after a ride is demolished or land
+// ownership), so a complete image is still slowly redrawn line by line to pick those up.
+constexpr int32_t MAP_WINDOW_REFRESH_LINES_PER_UPDATE = 2;
+static uint32_t _refreshLine[4];
 
 /** rct2: 0x00F1AD68 */
-static std::vector<uint8_t> _mapImageData;
+// A minimap image is kept for each rotation. Each one is drawn line by line when first needed
+// and afterwards the tiles reported as changed by the map are redrawn straight away.
+static std::vector<uint8_t> _mapImageData[4];
+
+static std::vector<TileCoordsXY> _mapChangedTiles;
 
 static uint16_t _landRightsToolSize;
 
@@ -194,7 +203,9 @@ static void window_map_place_park_entrance_tool_down(int32_t x, int32_t y);
 static void window_map_set_peep_spawn_tool_down(int32_t x, int32_t y);
 static void map_window_increase_map_size();
 static void map_window_decrease_map_size();
-static void map_window_set_pixels(rct_window *w);
+static bool map_window_allocate_image(int32_t rotation);
+static void map_window_set_pixels(rct_window *w, int32_t rotation, int32_t line);
+static void map_window_update_changed_tiles(rct_window *w);
 
 static CoordsXY map_window_screen_to_map(int32_t screenX, int32_t screenY);
 
@@ -214,11 +225,8 @@ rct_window * window_map_open()
         return w;
     }
 
-    try
-    {
-        _mapImageData.resize(MAP_WINDOW_MAP_SIZE * MAP_WINDOW_MAP_SIZE);
-    }
-    catch (const std::bad_alloc &)
+    window_map_init_map();
+    if (!map_window_allocate_image(get_current_rotation()))
     {
         return nullptr;
     }
@@ -255,7 +263,6 @@ rct_window * window_map_open()
 
     w->map.rotation = get_current_rotation();
 
-    window_map_init_map();
     gWindowSceneryRotation = 0;
     window_map_centre_on_view_point();
 
@@ -285,8 +292,13 @@ void window_map_reset()
 */
 static void window_map_close(rct_window *w)
 {
-    _mapImageData.clear();
-    _mapImageData.shrink_to_fit();
+    for (auto &imageData : _mapImageData)
+    {
+        imageData.clear();
+        imageData.shrink_to_fit();
+    }
+    _mapChangedTiles.clear();
+    _mapChangedTiles.shrink_to_fit();
     if ((input_test_flag(INPUT_FLAG_TOOL_ACTIVE)) &&
         gCurrentToolWidget.window_classification == w->classification &&
         gCurrentToolWidget.window_number == w->number) {
@@ -387,6 +399,9 @@ static void window_map_mouseup(rct_window *w, rct_widgetindex widgetIndex)
 
             w->selected_tab = widgetIndex;
             w->list_information_type = 0;
+
+            // The tabs colour the map differently so the cached images need to be redrawn
+            window_map_init_map();
         }
     }
  }
@@ -440,12 +455,25 @@ static void window_map_update(rct_window *w)
 {
     if (get_current_rotation() != w->map.rotation) {
         w->map.rotation = get_current_rotation();
-        window_map_init_map();
+        if (!map_window_allocate_image(w->map.rotation)) {
+            window_close(w);
+            return;
+        }
         window_map_centre_on_view_point();
     }
 
-    for (int32_t i = 0; i < 16; i++)
-        map_window_set_pixels(w);
+    map_window_update_changed_tiles(w);
+
+    int32_t rotation = w->map.rotation;
+    if (_currentLine[rotation] < MAXIMUM_MAP_SIZE_TECHNICAL) {
+        for (int32_t i = 0; i < 16 && _currentLine[rotation] < MAXIMUM_MAP_SIZE_TECHNICAL; i++)
+            map_window_set_pixels(w, rotation, _currentLine[rotation]++);
+    } else {
+        for (int32_t i = 0; i < MAP_WINDOW_REFRESH_LINES_PER_UPDATE; i++) {
+            map_window_set_pixels(w, rotation, _refreshLine[rotation]);
+            _refreshLine[rotation] = (_refreshLine[rotation] + 1) % MAXIMUM_MAP_SIZE_TECHNICAL;
+        }
+    }
 
     window_invalidate(w);
 
@@ -888,7 +916,7 @@ static void window_map_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi, int32_
     gfx_clear(dpi, PALETTE_INDEX_10);
 
     rct_g1_element g1temp = {};
-    g1temp.offset = _mapImageData.data();
+    g1temp.offset = _mapImageData[w->map.rotation].data();
     g1temp.width = MAP_WINDOW_MAP_SIZE;
     g1temp.height = MAP_WINDOW_MAP_SIZE;
     g1temp.x_offset = -8;
@@ -913,8 +941,15 @@ static void window_map_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi, int32_
  */
 static void window_map_init_map()
 {
-    std::fill(_mapImageData.begin(), _mapImageData.end(), PALETTE_INDEX_10);
-    _currentLine = 0;
+    for (int32_t rotation = 0; rotation < 4; rotation++) {
+        std::fill(_mapImageData[rotation].begin(), _mapImageData[rotation].end(), PALETTE_INDEX_10);
+        _currentLine[rotation] = 0;
+        _refreshLine[rotation] = 0;
+    }
+
+    // Anything changed up to now is covered by redrawing the images from scratch
+    map_take_changed_tiles(_mapChangedTiles);
+    _mapChangedTiles.clear();
 }
 
 /**
@@ -1609,36 +1644,124 @@ static uint16_t map_window_get_pixel_colour_ride(CoordsXY c)
     return colourB;
 }
 
-static void map_window_set_pixels(rct_window *w)
+static bool map_window_allocate_image(int32_t rotation)
+{
+    if (!_mapImageData[rotation].empty())
+        return true;
+
+    try
+    {
+        _mapImageData[rotation].resize(MAP_WINDOW_MAP_SIZE * MAP_WINDOW_MAP_SIZE, PALETTE_INDEX_10);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return false;
+    }
+    _currentLine[rotation] = 0;
+    return true;
+}
+
+static uint16_t map_window_get_pixel_colour(rct_window *w, CoordsXY c)
+{
+    switch (w->selected_tab) {
+    case PAGE_PEEPS:
+        return map_window_get_pixel_colour_peep(c);
+    case PAGE_RIDES:
+        return map_window_get_pixel_colour_ride(c);
+    }
+    return 0;
+}
+
+/**
+ * Gets the line (as used by map_window_set_pixels) and the position along that line for a tile.
+ */
+static void map_window_get_tile_line(int32_t rotation, TileCoordsXY tile, int32_t *line, int32_t *position)
+{
+    constexpr int32_t last = MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+    switch (rotation) {
+    case 0:
+        *line = tile.x;
+        *position = tile.y;
+        break;
+    case 1:
+        *line = tile.y;
+        *position = last - tile.x;
+        break;
+    case 2:
+        *line = last - tile.x;
+        *position = last - tile.y;
+        break;
+    default:
+        *line = last - tile.y;
+        *position = tile.x;
+        break;
+    }
+}
+
+static uint8_t * map_window_get_line_destination(int32_t rotation, int32_t line, int32_t position)
+{
+    int32_t pos = (line * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+    int32_t x = (pos % MAP_WINDOW_MAP_SIZE) + position;
+    int32_t y = (pos / MAP_WINDOW_MAP_SIZE) + position;
+    return _mapImageData[rotation].data() + (y * MAP_WINDOW_MAP_SIZE) + x;
+}
+
+/**
+ * Redraws the tiles that have changed since the last update in all of the cached images.
+ */
+static void map_window_update_changed_tiles(rct_window *w)
+{
+    if (map_take_changed_tiles(_mapChangedTiles)) {
+        window_map_init_map();
+        return;
+    }
+
+    for (const auto &tile : _mapChangedTiles) {
+        CoordsXY c = { tile.x * 32, tile.y * 32 };
+        if (c.x <= 0 || c.y <= 0 || c.x >= gMapSizeUnits || c.y >= gMapSizeUnits)
+            continue;
+
+        uint16_t colour = map_window_get_pixel_colour(w, c);
+        for (int32_t rotation = 0; rotation < 4; rotation++) {
+            if (_mapImageData[rotation].empty())
+                continue;
+
+            int32_t line, position;
+            map_window_get_tile_line(rotation, tile, &line, &position);
+            uint8_t * destination = map_window_get_line_destination(rotation, line, position);
+            destination[0] = (colour >> 8) & 0xFF;
+            destination[1] = colour;
+        }
+    }
+}
+
+static void map_window_set_pixels(rct_window *w, int32_t rotation, int32_t currentLine)
 {
     uint16_t colour = 0;
     int32_t x = 0, y = 0, dx = 0, dy = 0;
 
-    int32_t pos = (_currentLine * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1;
-    LocationXY16 destinationPosition = MakeXY16(pos % MAP_WINDOW_MAP_SIZE, pos / MAP_WINDOW_MAP_SIZE);
-    auto destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
-    switch (get_current_rotation()) {
+    switch (rotation) {
     case 0:
-        x = _currentLine * 32;
+        x = currentLine * 32;
         y = 0;
         dx = 0;
         dy = 32;
         break;
     case 1:
         x = (MAXIMUM_MAP_SIZE_TECHNICAL - 1) * 32;
-        y = _currentLine * 32;
+        y = currentLine * 32;
         dx = -32;
         dy = 0;
         break;
     case 2:
-        x = ((MAXIMUM_MAP_SIZE_TECHNICAL - 1) - _currentLine) * 32;
+        x = ((MAXIMUM_MAP_SIZE_TECHNICAL - 1) - currentLine) * 32;
         y = (MAXIMUM_MAP_SIZE_TECHNICAL - 1) * 32;
         dx = 0;
         dy = -32;
         break;
     case 3:
         x = 0;
-        y = ((MAXIMUM_MAP_SIZE_TECHNICAL - 1) - _currentLine) * 32;
+        y = ((MAXIMUM_MAP_SIZE_TECHNICAL - 1) - currentLine) * 32;
         dx = 32;
         dy = 0;
         break;
@@ -1651,27 +1774,14 @@ static void map_window_set_pixels(rct_window *w)
             x < gMapSizeUnits &&
             y < gMapSizeUnits
         ) {
-            switch (w->selected_tab) {
-            case PAGE_PEEPS:
-                colour = map_window_get_pixel_colour_peep({x, y});
-                break;
-            case PAGE_RIDES:
-                colour = map_window_get_pixel_colour_ride({x, y});
-                break;
-            }
+            colour = map_window_get_pixel_colour(w, {x, y});
+            uint8_t * destination = map_window_get_line_destination(rotation, currentLine, i);
             destination[0] = (colour >> 8) & 0xFF;
             destination[1] = colour;
         }
         x += dx;
         y += dy;
-
-        destinationPosition.x++;
-        destinationPosition.y++;
-        destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
     }
-    _currentLine++;
-    if (_currentLine >= MAXIMUM_MAP_SIZE_TECHNICAL)
-        _currentLine = 0;
 }
 
 static CoordsXY map_window_screen_to_map(int32_t screenX, int32_t screenY)
@@ -582,8 +582,13 @@ static void window_ride_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi,
 
     gfx_fill_rect(dpi, dpi->x, dpi->y, dpi->x + dpi->width, dpi->y + dpi->height, ColourMapA[w->colours[1]].mid_light);
 
-    y = 0;
-    for (i = 0; i < w->no_list_items; i++) {
+    // Only visit the rows that intersect the area being drawn
+    i = std::max(0, dpi->y / SCROLLABLE_ROW_HEIGHT - 1);
+    y = i * SCROLLABLE_ROW_HEIGHT;
+    for (; i < w->no_list_items; i++) {
+        if (y - 1 >= dpi->y + dpi->height)
+            break;
+
         format = (_quickDemolishMode ? STR_RED_STRINGID : STR_BLACK_STRING);
 
         // Background highlight
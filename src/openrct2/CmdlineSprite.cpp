@@ -12,8 +12,10 @@
 #include <cmath>
 #include <cstring>
 #include <jansson.h>
+#include <vector>
 #include "CmdlineSprite.h"
 #include "core/Imaging.h"
+#include "core/JobPool.hpp"
 #include "drawing/Drawing.h"
 #include "drawing/ImageImporter.h"
 #include "localisation/Language.h"
@@ -274,6 +276,27 @@ static bool sprite_file_import(const char *path, int16_t x_offset, int16_t y_off
     }
 }
 
+struct sprite_build_entry {
+    char * imagePath = nullptr;
+    int16_t x_offset = 0;
+    int16_t y_offset = 0;
+    bool keep_palette = false;
+    bool imported = false;
+    rct_g1_element element = {};
+    uint8_t * buffer = nullptr;
+    int bufferLength = 0;
+};
+
+static void sprite_build_entries_free(std::vector<sprite_build_entry>& entries)
+{
+    for (auto& entry : entries)
+    {
+        free(entry.imagePath);
+        free(entry.buffer);
+    }
+    entries.clear();
+}
+
 int32_t cmdline_for_sprite(const char **argv, int32_t argc)
 {
     gOpenRCT2Headless = true;
@@ -523,6 +546,9 @@ int32_t cmdline_for_sprite(const char **argv, int32_t argc)
 
         fprintf(stdout, "Building: %s\n", spriteFilePath);
 
+        std::vector<sprite_build_entry> buildEntries;
+        buildEntries.reserve(json_array_size(sprite_list));
+
         size_t i;
         json_t* sprite_description;
 
@@ -531,6 +557,7 @@ int32_t cmdline_for_sprite(const char **argv, int32_t argc)
             if(!json_is_object(sprite_description))
             {
                 fprintf(stderr, "Error: expected object for sprite %lu\n", (unsigned long)i);
+                sprite_build_entries_free(buildEntries);
                 json_decref(sprite_list);
                 return -1;
             }
@@ -539,6 +566,7 @@ int32_t cmdline_for_sprite(const char **argv, int32_t argc)
             if(!path || !json_is_string(path))
             {
                 fprintf(stderr, "Error: no path provided for sprite %lu\n", (unsigned long)i);
+                sprite_build_entries_free(buildEntries);
                 json_decref(sprite_list);
                 return -1;
             }
@@ -558,62 +586,70 @@ int32_t cmdline_for_sprite(const char **argv, int32_t argc)
                 }
             }
 
+            sprite_build_entry entry;
             // Resolve absolute sprite path
-            char *imagePath = platform_get_absolute_path(json_string_value(path), directoryPath);
-
-            rct_g1_element spriteElement;
-            uint8_t *buffer;
-            int bufferLength;
+            entry.imagePath = platform_get_absolute_path(json_string_value(path), directoryPath);
+            entry.x_offset = x_offset == nullptr ? 0 : (int16_t)json_integer_value(x_offset);
+            entry.y_offset = y_offset == nullptr ? 0 : (int16_t)json_integer_value(y_offset);
+            entry.keep_palette = keep_palette;
+            buildEntries.push_back(entry);
+        }
 
-            if (!sprite_file_import(imagePath,
-                                    x_offset == nullptr ? 0 : json_integer_value(x_offset),
-                                    y_offset == nullptr ? 0 : json_integer_value(y_offset),
-                                    keep_palette, &spriteElement, &buffer, &bufferLength, gSpriteMode))
+        // The images do not depend on each other, so import them all at once
+        {
+            JobPool jobPool;
+            for (auto& entry : buildEntries)
             {
-                fprintf(stderr, "Could not import image file: %s\nCanceling\n", imagePath);
-                json_decref(sprite_list);
-                free(imagePath);
-                return -1;
+                jobPool.AddTask([&entry]() {
+                    entry.imported = sprite_file_import(entry.imagePath, entry.x_offset, entry.y_offset, entry.keep_palette,
+                                                        &entry.element, &entry.buffer, &entry.bufferLength, gSpriteMode);
+                });
             }
+            jobPool.Join();
+        }
 
-            if (!sprite_file_open(spriteFilePath))
+        uint32_t totalSize = 0;
+        for (const auto& entry : buildEntries)
+        {
+            if (!entry.imported)
             {
-                fprintf(stderr, "Unable to open sprite file: %s\nCanceling\n", spriteFilePath);
+                fprintf(stderr, "Could not import image file: %s\nCanceling\n", entry.imagePath);
+                sprite_build_entries_free(buildEntries);
                 json_decref(sprite_list);
-                free(imagePath);
                 return -1;
             }
+            totalSize += entry.bufferLength;
+        }
 
-            spriteFileHeader.num_entries++;
-            spriteFileHeader.total_size += bufferLength;
-            spriteFileEntries = (rct_g1_element *)realloc(spriteFileEntries, spriteFileHeader.num_entries * sizeof(rct_g1_element));
-
-            sprite_entries_make_relative();
-            spriteFileData = (uint8_t *)realloc(spriteFileData, spriteFileHeader.total_size);
-            sprite_entries_make_absolute();
-
-            spriteFileEntries[spriteFileHeader.num_entries - 1] = spriteElement;
-            memcpy(spriteFileData + (spriteFileHeader.total_size - bufferLength), buffer, bufferLength);
-            spriteFileEntries[spriteFileHeader.num_entries - 1].offset = spriteFileData + (spriteFileHeader.total_size - bufferLength);
-
-            free(buffer);
+        spriteFileHeader.num_entries = (uint32_t)buildEntries.size();
+        spriteFileHeader.total_size = totalSize;
+        spriteFileEntries = (rct_g1_element *)malloc(spriteFileHeader.num_entries * sizeof(rct_g1_element));
+        spriteFileData = (uint8_t *)malloc(spriteFileHeader.total_size);
 
-            if (!sprite_file_save(spriteFilePath))
-            {
-                fprintf(stderr, "Could not save sprite file: %s\nCanceling\n", imagePath);
-                json_decref(sprite_list);
-                free(imagePath);
-                return -1;
-            }
+        uint32_t dataOffset = 0;
+        for (size_t j = 0; j < buildEntries.size(); j++)
+        {
+            const auto& entry = buildEntries[j];
+            spriteFileEntries[j] = entry.element;
+            memcpy(spriteFileData + dataOffset, entry.buffer, entry.bufferLength);
+            spriteFileEntries[j].offset = spriteFileData + dataOffset;
+            dataOffset += entry.bufferLength;
 
             if (!silent)
-                fprintf(stdout, "Added: %s\n", imagePath);
+                fprintf(stdout, "Added: %s\n", entry.imagePath);
+        }
 
-            free(imagePath);
+        if (!sprite_file_save(spriteFilePath))
+        {
+            fprintf(stderr, "Could not save sprite file: %s\nCanceling\n", spriteFilePath);
             sprite_file_close();
-
+            sprite_build_entries_free(buildEntries);
+            json_decref(sprite_list);
+            return -1;
         }
 
+        sprite_file_close();
+        sprite_build_entries_free(buildEntries);
         json_decref(sprite_list);
         free(directoryPath);
 
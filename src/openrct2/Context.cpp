@@ -8,10 +8,14 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <exception>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 #ifdef __EMSCRIPTEN__
     #include <emscripten.h>
 #endif // __EMSCRIPTEN__
@@ -23,6 +27,7 @@
 #include "core/FileScanner.h"
 #include "core/FileStream.hpp"
 #include "core/Guard.hpp"
+#include "core/JobPool.hpp"
 #include "core/Math.hpp"
 #include "core/MemoryStream.h"
 #include "core/Path.hpp"
@@ -40,6 +45,7 @@
 #include "ParkImporter.h"
 #include "platform/Crash.h"
 #include "PlatformEnvironment.h"
+#include "Profiling.h"
 #include "ride/TrackDesignRepository.h"
 #include "scenario/Scenario.h"
 #include "scenario/ScenarioRepository.h"
@@ -78,6 +84,77 @@ using namespace OpenRCT2::Ui;
 
 namespace OpenRCT2
 {
+    /**
+     * Measures the stages of the start up, which can run on any thread, for --startup-profile.
+     */
+    class StartupProfile
+    {
+    private:
+        using Clock = std::chrono::high_resolution_clock;
+
+        struct StageTiming
+        {
+            std::string Name;
+            double StartTime;
+            double Duration;
+        };
+
+        Clock::time_point const _startTime = Clock::now();
+        std::vector<StageTiming> _stages;
+        std::mutex _mutex;
+
+    public:
+        class Stage
+        {
+        private:
+            StartupProfile& _profile;
+            const char * _name;
+            Clock::time_point const _startTime = Clock::now();
+
+        public:
+            Stage(StartupProfile& profile, const char * name)
+                : _profile(profile),
+                  _name(name)
+            {
+            }
+
+            Stage(const Stage&) = delete;
+
+            ~Stage()
+            {
+                _profile.Record(_name, _startTime, Clock::now());
+            }
+        };
+
+        Stage BeginStage(const char * name)
+        {
+            return Stage(*this, name);
+        }
+
+        void Print()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            Console::WriteLine("Startup profile:");
+            for (const auto& stage : _stages)
+            {
+                Console::WriteLine("  %-20s %8.1f ms (started at %.1f ms)", stage.Name.c_str(), stage.Duration, stage.StartTime);
+            }
+            Console::WriteLine("  %-20s %8.1f ms", "Total", GetMilliseconds(_startTime, Clock::now()));
+        }
+
+    private:
+        void Record(const char * name, Clock::time_point startTime, Clock::time_point endTime)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stages.push_back({ name, GetMilliseconds(_startTime, startTime), GetMilliseconds(startTime, endTime) });
+        }
+
+        static double GetMilliseconds(Clock::time_point startTime, Clock::time_point endTime)
+        {
+            return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        }
+    };
+
     class Context : public IContext
     {
     private:
@@ -352,6 +429,14 @@ namespace OpenRCT2
                 _env->SetBasePath(DIRBASE::RCT2, rct2InstallPath);
             }
 
+            StartupProfile startupProfile;
+            bool g1Loaded = false;
+            bool g2Loaded = false;
+            std::promise<bool> languageOpened;
+            std::promise<void> baseGraphicsLoaded;
+            std::shared_future<void> baseGraphicsFuture = baseGraphicsLoaded.get_future().share();
+            JobPool startupJobs;
+
             _objectRepository = std::shared_ptr<IObjectRepository>(CreateObjectRepository(_env));
             _objectManager = std::shared_ptr<IObjectManager>(CreateObjectManager(_objectRepository));
             _trackDesignRepository = CreateTrackDesignRepository(_env);
@@ -360,24 +445,89 @@ namespace OpenRCT2
             _discordService = std::make_unique<DiscordService>();
 #endif
 
-            try
-            {
-                _localisationService->OpenLanguage(gConfigGeneral.language, *_objectManager);
-            }
-            catch (const std::exception& e)
+            // The jobs are started in the order they are added, so a job may only wait for jobs added before it.
+            startupJobs.AddTask([this, &startupProfile, &languageOpened]()
             {
-                log_error("Failed to open configured language: %s", e.what());
+                auto stage = startupProfile.BeginStage("Language");
                 try
                 {
-                    _localisationService->OpenLanguage(LANGUAGE_ENGLISH_UK, *_objectManager);
+                    _localisationService->OpenLanguage(gConfigGeneral.language, *_objectManager);
+                    languageOpened.set_value(true);
                 }
-                catch (const std::exception&)
+                catch (const std::exception& e)
                 {
-                    log_fatal("Failed to open fallback language: %s", e.what());
-                    return false;
+                    log_error("Failed to open configured language: %s", e.what());
+                    try
+                    {
+                        _localisationService->OpenLanguage(LANGUAGE_ENGLISH_UK, *_objectManager);
+                        languageOpened.set_value(true);
+                    }
+                    catch (const std::exception&)
+                    {
+                        log_fatal("Failed to open fallback language: %s", e.what());
+                        languageOpened.set_value(false);
+                    }
                 }
+            });
+
+            // Failures are reported once the jobs have finished as message boxes can only be shown from this thread.
+            if (!gOpenRCT2NoGraphics)
+            {
+                startupJobs.AddTask([this, &startupProfile, &g1Loaded, &g2Loaded, &baseGraphicsLoaded]()
+                {
+                    {
+                        auto stage = startupProfile.BeginStage("Base graphics");
+                        g1Loaded = gfx_load_g1(*_env);
+                        if (g1Loaded)
+                        {
+                            g2Loaded = gfx_load_g2();
+                            gfx_load_csg();
+                        }
+                    }
+                    baseGraphicsLoaded.set_value();
+                });
+            }
+            else
+            {
+                baseGraphicsLoaded.set_value();
             }
 
+            startupJobs.AddTask([&startupProfile]()
+            {
+                auto stage = startupProfile.BeginStage("Title sequences");
+                TitleSequenceManager::Scan();
+            });
+
+            // The indexes of the repositories are cached per language, so they can only be loaded once the language
+            // is known. They are independent of each other, except that scenario names can come from objects.
+            // TODO Ideally we want to delay this until we show the title so that we can
+            //      still open the game window and draw a progress screen for the creation
+            //      of the object cache.
+            if (!languageOpened.get_future().get())
+            {
+                startupJobs.Join();
+                return false;
+            }
+            int32_t language = _localisationService->GetCurrentLanguage();
+            startupJobs.AddTask([this, &startupProfile, language, baseGraphicsFuture]()
+            {
+                {
+                    // When the index has to be rebuilt, JSON objects whose images refer to $G1 or $CSG sprites copy
+                    // them with gfx_get_g1_element and is_csg_loaded, which read the tables gfx_load_g1 and
+                    // gfx_load_csg are filling in.
+                    baseGraphicsFuture.wait();
+                    auto stage = startupProfile.BeginStage("Objects");
+                    _objectRepository->LoadOrConstruct(language);
+                }
+                auto stage = startupProfile.BeginStage("Scenarios");
+                _scenarioRepository->Scan(language);
+            });
+            startupJobs.AddTask([this, &startupProfile, language]()
+            {
+                auto stage = startupProfile.BeginStage("Track designs");
+                _trackDesignRepository->Scan(language);
+            });
+
             if (platform_process_is_elevated())
             {
                 std::string elevationWarning = _localisationService->GetString(STR_ADMIN_NOT_RECOMMENDED);
@@ -393,24 +543,11 @@ namespace OpenRCT2
 
             if (!gOpenRCT2Headless)
             {
-                _uiContext->CreateWindow();
-            }
-
-            // TODO Ideally we want to delay this until we show the title so that we can
-            //      still open the game window and draw a progress screen for the creation
-            //      of the object cache.
-            _objectRepository->LoadOrConstruct(_localisationService->GetCurrentLanguage());
-
-            // TODO Like objects, this can take a while if there are a lot of track designs
-            //      its also really something really we might want to do in the background
-            //      as its not required until the player wants to place a new ride.
-            _trackDesignRepository->Scan(_localisationService->GetCurrentLanguage());
-
-            _scenarioRepository->Scan(_localisationService->GetCurrentLanguage());
-            TitleSequenceManager::Scan();
-
-            if (!gOpenRCT2Headless)
-            {
+                {
+                    auto stage = startupProfile.BeginStage("Window");
+                    _uiContext->CreateWindow();
+                }
+                auto stage = startupProfile.BeginStage("Audio");
                 audio_init();
                 audio_populate_devices();
                 audio_init_ride_sounds_and_info();
@@ -418,14 +555,25 @@ namespace OpenRCT2
 
             network_set_env(_env);
             chat_init();
+
+            startupJobs.Join();
             CopyOriginalUserFilesOver();
 
             if (!gOpenRCT2NoGraphics)
             {
-                if (!LoadBaseGraphics())
+                if (!g1Loaded)
                 {
+                    if (!gOpenRCT2Headless)
+                    {
+                        _uiContext->ShowMessageBox("Unable to load g1.dat. Your RollerCoaster Tycoon 2 path may be incorrectly set.");
+                    }
                     return false;
                 }
+                if (!g2Loaded && !gOpenRCT2Headless)
+                {
+                    _uiContext->ShowMessageBox("Unable to load g2.dat");
+                }
+                font_sprite_initialise_characters();
 #ifdef __ENABLE_LIGHTFX__
                 lightfx_init();
 #endif
@@ -439,6 +587,11 @@ namespace OpenRCT2
             _gameState->InitAll(150);
 
             _titleScreen = std::make_unique<TitleScreen>(*_gameState);
+
+            if (gOpenRCT2StartupProfile)
+            {
+                startupProfile.Print();
+            }
             return true;
         }
 
@@ -525,6 +678,7 @@ namespace OpenRCT2
 
         bool LoadParkFromStream(IStream * stream, const std::string &path, bool loadTitleScreenFirstOnFail) final override
         {
+            PROFILE_SCOPE("Context::LoadParkFromStream");
             ClassifiedFileInfo info;
             if (TryClassifyFile(stream, &info))
             {
@@ -662,18 +816,6 @@ namespace OpenRCT2
             return result;
         }
 
-        bool LoadBaseGraphics()
-        {
-            if (!gfx_load_g1(*_env))
-            {
-                return false;
-            }
-            gfx_load_g2();
-            gfx_load_csg();
-            font_sprite_initialise_characters();
-            return true;
-        }
-
         /**
          * Launches the game, after command line arguments have been parsed and processed.
          */
@@ -842,6 +984,7 @@ namespace OpenRCT2
 
         void RunFrame()
         {
+            PROFILE_SCOPE("Context::RunFrame");
             // Make sure we catch the state change and reset it.
             bool useVariableFrame = ShouldRunVariableFrame();
             if (_variableFrame != useVariableFrame)
@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include <memory>
+#include <string>
 #include "audio/audio.h"
 #include "Cheats.h"
 #include "config/Config.h"
@@ -19,6 +20,7 @@
 #include "FileClassifier.h"
 #include "Game.h"
 #include "Input.h"
+#include "Journal.h"
 #include "interface/Screenshot.h"
 #include "interface/Viewport.h"
 #include "interface/Window.h"
@@ -464,6 +466,11 @@ int32_t game_do_command_p(uint32_t command, int32_t * eax, int32_t * ebx, int32_
                 }
             }
 
+            if (gGameCommandNestLevel == 1)
+            {
+                journal_record_command(command, *eax, *ebx, *ecx, *edx, *esi, *edi, *ebp);
+            }
+
             // Second call to actually perform the operation
             new_game_command_table[command](eax, ebx, ecx, edx, esi, edi, ebp);
 
@@ -1114,6 +1121,9 @@ void game_load_init()
 {
     rct_window * mainWindow;
 
+    // A journal only describes the park it was started on
+    journal_stop();
+
     gScreenFlags = SCREEN_FLAGS_PLAYING;
     audio_stop_all_music_and_sounds();
     if (!gLoadKeepWindowsOpen)
@@ -1163,7 +1173,7 @@ void game_load_init()
  */
 void reset_all_sprite_quadrant_placements()
 {
-    for (size_t i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < sprite_get_capacity(); i++)
     {
         rct_sprite * spr = get_sprite(i);
         if (spr->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL)
@@ -1323,7 +1333,7 @@ void game_autosave()
              currentDate.year, currentDate.month, currentDate.day, currentTime.hour,
              currentTime.minute, currentTime.second, fileExtension);
 
-    limit_autosave_count(NUMBER_OF_AUTOSAVES_TO_KEEP, (gScreenFlags & SCREEN_FLAGS_EDITOR));
+    bool processLandscapeFolder = (gScreenFlags & SCREEN_FLAGS_EDITOR) != 0;
 
     utf8 path[MAX_PATH];
     utf8 backupPath[MAX_PATH];
@@ -1336,12 +1346,16 @@ void game_autosave()
     safe_strcat(backupPath, fileExtension, sizeof(backupPath));
     safe_strcat(backupPath, ".bak", sizeof(backupPath));
 
-    if (platform_file_exists(path))
-    {
-        platform_file_copy(path, backupPath, true);
-    }
-
-    scenario_save(path, saveFlags);
+    // Tidying up old autosaves and making the backup are left to the save's worker thread
+    std::string pathCopy = path;
+    std::string backupPathCopy = backupPath;
+    scenario_save_async(path, saveFlags, [pathCopy, backupPathCopy, processLandscapeFolder]() {
+        limit_autosave_count(NUMBER_OF_AUTOSAVES_TO_KEEP, processLandscapeFolder);
+        if (platform_file_exists(pathCopy.c_str()))
+        {
+            platform_file_copy(pathCopy.c_str(), backupPathCopy.c_str(), true);
+        }
+    });
 }
 
 static void game_load_or_quit_no_save_prompt_callback(int32_t result, const utf8 * path)
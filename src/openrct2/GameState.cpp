@@ -12,6 +12,7 @@
 #include "core/Math.hpp"
 #include "Editor.h"
 #include "Input.h"
+#include "Journal.h"
 #include "interface/Screenshot.h"
 #include "localisation/Date.h"
 #include "localisation/Localisation.h"
@@ -19,6 +20,7 @@
 #include "network/network.h"
 #include "OpenRCT2.h"
 #include "platform/Platform2.h"
+#include "Profiling.h"
 #include "scenario/Scenario.h"
 #include "title/TitleScreen.h"
 #include "title/TitleSequencePlayer.h"
@@ -71,6 +73,7 @@ void GameState::InitAll(int32_t mapSize)
 
 void GameState::Update()
 {
+    PROFILE_SCOPE("GameState::Update");
     gInUpdateCode = true;
 
     uint32_t numUpdates;
@@ -180,6 +183,7 @@ void GameState::Update()
     {
         scenario_autosave_check();
     }
+    scenario_save_async_update();
 
     window_dispatch_update_all();
 
@@ -189,6 +193,7 @@ void GameState::Update()
 
 void GameState::UpdateLogic()
 {
+    PROFILE_SCOPE("GameState::UpdateLogic");
     gScreenAge++;
     if (gScreenAge == 0)
         gScreenAge--;
@@ -218,11 +223,14 @@ void GameState::UpdateLogic()
         network_check_desynchronization();
     }
 
+    journal_record_tick();
+
     date_update();
     _date = Date(gDateMonthTicks, gDateMonthTicks);
 
     scenario_update();
     climate_update();
+    map_update_tile_element_index();
     map_update_tiles();
     // Temporarily remove provisional paths to prevent peep from interacting with them
     map_remove_provisional_elements();
@@ -0,0 +1,359 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "actions/GameAction.h"
+#include "Cheats.h"
+#include "Context.h"
+#include "core/Console.hpp"
+#include "core/DataSerialiser.h"
+#include "core/FileStream.hpp"
+#include "core/MemoryStream.h"
+#include "Game.h"
+#include "GameState.h"
+#include "Journal.h"
+#include "object/ObjectManager.h"
+#include "OpenRCT2.h"
+#include "rct2/S6Exporter.h"
+#include "world/Park.h"
+#include "world/Sprite.h"
+
+using namespace OpenRCT2;
+
+constexpr uint32_t JOURNAL_MAGIC = 0x4C4E524A; // JRNL
+constexpr uint16_t JOURNAL_VERSION = 2;
+
+enum JOURNAL_RECORD : uint8_t
+{
+    JOURNAL_RECORD_END,
+    JOURNAL_RECORD_TICK,
+    JOURNAL_RECORD_COMMAND,
+    JOURNAL_RECORD_ACTION,
+};
+
+static std::unique_ptr<FileStream> _journalStream;
+static uint32_t _journalActionDepth;
+
+/**
+ * Writes the state needed to continue the simulation that is not part of a normal save file,
+ * mirroring what the server sends to joining clients.
+ */
+static void journal_write_extra_state(IStream * stream)
+{
+    stream->Write(gSpriteSpatialIndex, sizeof(gSpriteSpatialIndex));
+    stream->WriteValue<uint32_t>(gGamePaused);
+    stream->WriteValue<uint32_t>(_guestGenerationProbability);
+    stream->WriteValue<uint32_t>(_suggestedGuestMaximum);
+    stream->WriteValue<uint8_t>(gCheatsSandboxMode);
+    stream->WriteValue<uint8_t>(gCheatsDisableClearanceChecks);
+    stream->WriteValue<uint8_t>(gCheatsDisableSupportLimits);
+    stream->WriteValue<uint8_t>(gCheatsDisableTrainLengthLimit);
+    stream->WriteValue<uint8_t>(gCheatsEnableChainLiftOnAllTrack);
+    stream->WriteValue<uint8_t>(gCheatsShowAllOperatingModes);
+    stream->WriteValue<uint8_t>(gCheatsShowVehiclesFromOtherTrackTypes);
+    stream->WriteValue<uint8_t>(gCheatsFastLiftHill);
+    stream->WriteValue<uint8_t>(gCheatsDisableBrakesFailure);
+    stream->WriteValue<uint8_t>(gCheatsDisableAllBreakdowns);
+    stream->WriteValue<uint8_t>(gCheatsBuildInPauseMode);
+    stream->WriteValue<uint8_t>(gCheatsIgnoreRideIntensity);
+    stream->WriteValue<uint8_t>(gCheatsDisableVandalism);
+    stream->WriteValue<uint8_t>(gCheatsDisableLittering);
+    stream->WriteValue<uint8_t>(gCheatsNeverendingMarketing);
+    stream->WriteValue<uint8_t>(gCheatsFreezeClimate);
+    stream->WriteValue<uint8_t>(gCheatsDisablePlantAging);
+    stream->WriteValue<uint8_t>(gCheatsAllowArbitraryRideTypeChanges);
+    stream->WriteValue<uint8_t>(gCheatsDisableRideValueAging);
+    stream->WriteValue<uint8_t>(gCheatsIgnoreResearchStatus);
+}
+
+static void journal_read_extra_state(IStream * stream)
+{
+    stream->Read(gSpriteSpatialIndex, sizeof(gSpriteSpatialIndex));
+    gGamePaused = stream->ReadValue<uint32_t>();
+    _guestGenerationProbability = stream->ReadValue<uint32_t>();
+    _suggestedGuestMaximum = stream->ReadValue<uint32_t>();
+    gCheatsSandboxMode = stream->ReadValue<uint8_t>() != 0;
+    gCheatsDisableClearanceChecks = stream->ReadValue<uint8_t>() != 0;
+    gCheatsDisableSupportLimits = stream->ReadValue<uint8_t>() != 0;
+    gCheatsDisableTrainLengthLimit = stream->ReadValue<uint8_t>() != 0;
+    gCheatsEnableChainLiftOnAllTrack = stream->ReadValue<uint8_t>() != 0;
+    gCheatsShowAllOperatingModes = stream->ReadValue<uint8_t>() != 0;
+    gCheatsShowVehiclesFromOtherTrackTypes = stream->ReadValue<uint8_t>() != 0;
+    gCheatsFastLiftHill = stream->ReadValue<uint8_t>() != 0;
+    gCheatsDisableBrakesFailure = stream->ReadValue<uint8_t>() != 0;
+    gCheatsDisableAllBreakdowns = stream->ReadValue<uint8_t>() != 0;
+    gCheatsBuildInPauseMode = stream->ReadValue<uint8_t>() != 0;
+    gCheatsIgnoreRideIntensity = stream->ReadValue<uint8_t>() != 0;
+    gCheatsDisableVandalism = stream->ReadValue<uint8_t>() != 0;
+    gCheatsDisableLittering = stream->ReadValue<uint8_t>() != 0;
+    gCheatsNeverendingMarketing = stream->ReadValue<uint8_t>() != 0;
+    gCheatsFreezeClimate = stream->ReadValue<uint8_t>() != 0;
+    gCheatsDisablePlantAging = stream->ReadValue<uint8_t>() != 0;
+    gCheatsAllowArbitraryRideTypeChanges = stream->ReadValue<uint8_t>() != 0;
+    gCheatsDisableRideValueAging = stream->ReadValue<uint8_t>() != 0;
+    gCheatsIgnoreResearchStatus = stream->ReadValue<uint8_t>() != 0;
+}
+
+/**
+ * Stops recording after a failed write so that a full disk does not interrupt the game.
+ */
+template<typename TWriteFunc>
+static void journal_write(TWriteFunc writeFunc)
+{
+    try
+    {
+        writeFunc(_journalStream.get());
+    }
+    catch (const std::exception &e)
+    {
+        log_error("Unable to write to journal: %s", e.what());
+        _journalStream = nullptr;
+    }
+}
+
+bool journal_start(const utf8 * path)
+{
+    journal_stop();
+
+    try
+    {
+        auto snapshot = MemoryStream();
+        auto s6exporter = std::make_unique<S6Exporter>();
+        s6exporter->ExportObjectsList = GetContext()->GetObjectManager()->GetPackableObjects();
+        s6exporter->Export();
+        s6exporter->SaveGame(&snapshot);
+
+        auto stream = std::make_unique<FileStream>(path, FILE_MODE_WRITE);
+        stream->WriteValue<uint32_t>(JOURNAL_MAGIC);
+        stream->WriteValue<uint16_t>(JOURNAL_VERSION);
+        stream->WriteValue<uint32_t>((uint32_t)snapshot.GetLength());
+        stream->Write(snapshot.GetData(), snapshot.GetLength());
+        journal_write_extra_state(stream.get());
+
+        _journalStream = std::move(stream);
+        _journalActionDepth = 0;
+        log_verbose("Recording journal to '%s'", path);
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        log_error("Unable to start journal: %s", e.what());
+        return false;
+    }
+}
+
+void journal_stop()
+{
+    if (_journalStream != nullptr)
+    {
+        journal_write([](IStream * stream) { stream->WriteValue<uint8_t>(JOURNAL_RECORD_END); });
+        _journalStream = nullptr;
+    }
+}
+
+bool journal_is_recording()
+{
+    return _journalStream != nullptr;
+}
+
+void journal_record_tick()
+{
+    if (_journalStream != nullptr)
+    {
+        journal_write([](IStream * stream)
+        {
+            stream->WriteValue<uint8_t>(JOURNAL_RECORD_TICK);
+            stream->WriteValue<uint32_t>(gCurrentTicks);
+        });
+    }
+}
+
+void journal_record_command(uint32_t command, int32_t eax, int32_t ebx, int32_t ecx, int32_t edx, int32_t esi, int32_t edi, int32_t ebp)
+{
+    if (_journalStream != nullptr && _journalActionDepth == 0)
+    {
+        journal_write([&](IStream * stream)
+        {
+            stream->WriteValue<uint8_t>(JOURNAL_RECORD_COMMAND);
+            stream->WriteValue<uint32_t>(command);
+            stream->WriteValue<int32_t>(game_command_playerid);
+            for (int32_t reg : { eax, ebx, ecx, edx, esi, edi, ebp })
+            {
+                stream->WriteValue<int32_t>(reg);
+            }
+        });
+    }
+}
+
+void journal_record_action(const GameAction * action)
+{
+    // Actions run from within a game command or another action are replayed by their parent
+    if (_journalStream != nullptr && _journalActionDepth == 0 && gGameCommandNestLevel == 0)
+    {
+        DataSerialiser ds(true);
+        action->Serialise(ds);
+        const MemoryStream &data = ds.GetStream();
+
+        journal_write([&](IStream * stream)
+        {
+            stream->WriteValue<uint8_t>(JOURNAL_RECORD_ACTION);
+            stream->WriteValue<uint32_t>(action->GetType());
+            stream->WriteValue<uint32_t>((uint32_t)data.GetLength());
+            stream->Write(data.GetData(), data.GetLength());
+        });
+    }
+}
+
+void journal_begin_action()
+{
+    _journalActionDepth++;
+}
+
+void journal_end_action()
+{
+    _journalActionDepth--;
+}
+
+static bool journal_replay_load(IContext * context, IStream * stream, const utf8 * path)
+{
+    if (stream->ReadValue<uint32_t>() != JOURNAL_MAGIC)
+    {
+        Console::Error::WriteLine("'%s' is not a journal.", path);
+        return false;
+    }
+    uint16_t version = stream->ReadValue<uint16_t>();
+    if (version != JOURNAL_VERSION)
+    {
+        Console::Error::WriteLine("Unsupported journal version: %u", version);
+        return false;
+    }
+
+    uint32_t snapshotLength = stream->ReadValue<uint32_t>();
+    auto snapshotData = std::make_unique<uint8_t[]>(snapshotLength);
+    stream->Read(snapshotData.get(), snapshotLength);
+    auto snapshot = MemoryStream(snapshotData.get(), snapshotLength);
+    if (!context->LoadParkFromStream(&snapshot, path))
+    {
+        return false;
+    }
+
+    journal_read_extra_state(stream);
+    return true;
+}
+
+/**
+ * Runs a recorded command the same way the network game command queue does, on behalf of the player
+ * that issued it.
+ */
+static void journal_replay_command(IStream * stream)
+{
+    uint32_t command = stream->ReadValue<uint32_t>();
+    int32_t playerId = stream->ReadValue<int32_t>();
+    int32_t regs[7];
+    for (auto &reg : regs)
+    {
+        reg = stream->ReadValue<int32_t>();
+    }
+    game_command_callback = nullptr;
+    game_command_playerid = playerId;
+    game_do_command_p(command, &regs[0], &regs[1], &regs[2], &regs[3], &regs[4], &regs[5], &regs[6]);
+}
+
+static void journal_replay_action(IStream * stream)
+{
+    uint32_t type = stream->ReadValue<uint32_t>();
+    uint32_t length = stream->ReadValue<uint32_t>();
+
+    DataSerialiser ds(false);
+    std::vector<uint8_t> data(length);
+    stream->Read(data.data(), length);
+    ds.GetStream().Write(data.data(), length);
+    ds.GetStream().SetPosition(0);
+
+    GameAction::Ptr action = GameActions::Create(type);
+    if (action == nullptr)
+    {
+        log_warning("Skipping unknown game action %u", type);
+        return;
+    }
+    action->Serialise(ds);
+    GameActions::Execute(action.get());
+}
+
+int32_t journal_replay(const utf8 * path, uint32_t checksumInterval)
+{
+    auto context = GetContext();
+    auto gameState = context->GetGameState();
+
+    int32_t numTicks = 0;
+    try
+    {
+        FileStream stream(path, FILE_MODE_OPEN);
+        if (!journal_replay_load(context, &stream, path))
+        {
+            return -1;
+        }
+
+        if (checksumInterval != 0 && sprite_checksum() == nullptr)
+        {
+            Console::Error::WriteLine("Sprite checksums are not available in this build.");
+            checksumInterval = 0;
+        }
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        bool finished = false;
+        while (!finished && stream.GetPosition() < stream.GetLength())
+        {
+            switch (stream.ReadValue<uint8_t>())
+            {
+            case JOURNAL_RECORD_TICK:
+            {
+                uint32_t tick = stream.ReadValue<uint32_t>();
+                if (tick != gCurrentTicks)
+                {
+                    log_warning("Journal tick %u replayed at tick %u", tick, gCurrentTicks);
+                }
+                gameState->UpdateLogic();
+                numTicks++;
+                if (checksumInterval != 0 && gCurrentTicks % checksumInterval == 0)
+                {
+                    Console::WriteLine("%u %s", gCurrentTicks, sprite_checksum());
+                }
+                break;
+            }
+            case JOURNAL_RECORD_COMMAND:
+                journal_replay_command(&stream);
+                break;
+            case JOURNAL_RECORD_ACTION:
+                journal_replay_action(&stream);
+                break;
+            case JOURNAL_RECORD_END:
+                finished = true;
+                break;
+            default:
+                Console::Error::WriteLine("Corrupt journal record at offset %u.", (uint32_t)stream.GetPosition() - 1);
+                finished = true;
+                break;
+            }
+        }
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> duration = endTime - startTime;
+        Console::WriteLine("Replayed %d ticks in %.2f seconds (%.0f ticks per second).",
+            numTicks, duration.count(), duration.count() > 0 ? numTicks / duration.count() : 0.0);
+    }
+    catch (const std::exception &e)
+    {
+        // A journal that was not stopped cleanly ends part way through a record
+        Console::Error::WriteLine("Journal ended unexpectedly after %d ticks: %s", numTicks, e.what());
+    }
+    return numTicks;
+}
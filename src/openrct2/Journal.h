@@ -0,0 +1,37 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+class GameAction;
+
+/**
+ * A journal is a snapshot of the park followed by every game command and game action in the order
+ * they were executed, interleaved with a marker for each game tick. Replaying it on the snapshot
+ * reproduces the same game state, which makes it useful for profiling the simulation and for
+ * bisecting desynchronisations.
+ */
+bool journal_start(const utf8 * path);
+void journal_stop();
+bool journal_is_recording();
+
+void journal_record_tick();
+void journal_record_command(uint32_t command, int32_t eax, int32_t ebx, int32_t ecx, int32_t edx, int32_t esi, int32_t edi, int32_t ebp);
+void journal_record_action(const GameAction * action);
+void journal_begin_action();
+void journal_end_action();
+
+/**
+ * Loads the journal snapshot and re-runs every recorded tick and command as fast as possible.
+ * If checksumInterval is not zero, the sprite checksum is printed every checksumInterval ticks.
+ * @returns the number of ticks replayed or -1 if the journal could not be read.
+ */
+int32_t journal_replay(const utf8 * path, uint32_t checksumInterval);
@@ -23,6 +23,7 @@ bool gOpenRCT2NoGraphics = false;
 
 bool gOpenRCT2ShowChangelog;
 bool gOpenRCT2SilentBreakpad;
+bool gOpenRCT2StartupProfile;
 
 uint32_t gCurrentDrawCount = 0;
 uint8_t gScreenFlags;
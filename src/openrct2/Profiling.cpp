@@ -0,0 +1,282 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "core/FileStream.hpp"
+#include "Profiling.h"
+
+// Stop recording a thread's scopes after this many rather than running out of memory
+constexpr size_t MAX_PROFILE_EVENTS_PER_THREAD = 1024 * 1024;
+
+struct profile_event
+{
+    const char * name;
+    uint64_t start;
+    uint64_t duration;
+    uint32_t depth;
+};
+
+struct profile_thread_buffer
+{
+    uint32_t id;
+    std::mutex mutex;
+    std::vector<profile_event> events;
+};
+
+std::atomic<bool> gProfilingRunning;
+
+static std::mutex _profileBuffersMutex;
+static std::vector<std::shared_ptr<profile_thread_buffer>> _profileBuffers;
+static uint64_t _profileStartTime;
+
+static thread_local std::shared_ptr<profile_thread_buffer> _profileThreadBuffer;
+static thread_local uint32_t _profileDepth;
+
+static uint64_t profiling_get_time()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+static profile_thread_buffer * profiling_get_thread_buffer()
+{
+    if (_profileThreadBuffer == nullptr)
+    {
+        // Buffers are kept after their thread exits so that short lived worker threads still show up in the report
+        std::lock_guard<std::mutex> lock(_profileBuffersMutex);
+        _profileThreadBuffer = std::make_shared<profile_thread_buffer>();
+        _profileThreadBuffer->id = (uint32_t)_profileBuffers.size();
+        _profileBuffers.push_back(_profileThreadBuffer);
+    }
+    return _profileThreadBuffer.get();
+}
+
+/**
+ * Copies the events recorded by every thread, each sorted so that a scope comes before the scopes it called.
+ */
+static std::vector<std::pair<uint32_t, std::vector<profile_event>>> profiling_get_events()
+{
+    std::vector<std::pair<uint32_t, std::vector<profile_event>>> result;
+    std::lock_guard<std::mutex> lock(_profileBuffersMutex);
+    for (const auto &buffer : _profileBuffers)
+    {
+        std::vector<profile_event> events;
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            events = buffer->events;
+        }
+        if (!events.empty())
+        {
+            std::sort(events.begin(), events.end(), [](const profile_event &a, const profile_event &b)
+            {
+                return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+            });
+            result.emplace_back(buffer->id, std::move(events));
+        }
+    }
+    return result;
+}
+
+void ProfileScope::Begin(const char * name)
+{
+    _name = name;
+    _profileDepth++;
+    _start = profiling_get_time();
+}
+
+void ProfileScope::End()
+{
+    uint64_t end = profiling_get_time();
+    _profileDepth--;
+    if (gProfilingRunning.load(std::memory_order_relaxed))
+    {
+        auto buffer = profiling_get_thread_buffer();
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        if (buffer->events.size() < MAX_PROFILE_EVENTS_PER_THREAD)
+        {
+            buffer->events.push_back({ _name, _start, end - _start, _profileDepth });
+        }
+    }
+}
+
+void profiling_start()
+{
+    std::lock_guard<std::mutex> lock(_profileBuffersMutex);
+    for (const auto &buffer : _profileBuffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->events.clear();
+        buffer->events.shrink_to_fit();
+    }
+    _profileStartTime = profiling_get_time();
+    gProfilingRunning = true;
+}
+
+void profiling_stop()
+{
+    gProfilingRunning = false;
+}
+
+bool profiling_is_running()
+{
+    return gProfilingRunning;
+}
+
+uint64_t profiling_get_event_count()
+{
+    uint64_t count = 0;
+    std::lock_guard<std::mutex> lock(_profileBuffersMutex);
+    for (const auto &buffer : _profileBuffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        count += buffer->events.size();
+    }
+    return count;
+}
+
+std::vector<profile_report_entry> profiling_get_report()
+{
+    struct scope_stats
+    {
+        const char * name;
+        uint32_t depth;
+        std::vector<uint64_t> durations;
+        std::vector<size_t> children;
+    };
+
+    // Each scope is identified by the scope that called it and its name
+    std::vector<scope_stats> scopes;
+    std::vector<size_t> roots;
+    std::unordered_map<std::string, size_t> scopeIndices;
+    for (const auto &threadEvents : profiling_get_events())
+    {
+        std::vector<std::string> keys;
+        std::vector<size_t> indices;
+        for (const auto &ev : threadEvents.second)
+        {
+            // Events are sorted by start time, so the last event seen one level up is the caller
+            keys.resize(ev.depth + 1);
+            indices.resize(ev.depth + 1, SIZE_MAX);
+            size_t parent = ev.depth == 0 ? SIZE_MAX : indices[ev.depth - 1];
+            keys[ev.depth] = (ev.depth == 0 ? std::string() : keys[ev.depth - 1] + '\n') + ev.name;
+
+            auto it = scopeIndices.find(keys[ev.depth]);
+            if (it == scopeIndices.end())
+            {
+                it = scopeIndices.emplace(keys[ev.depth], scopes.size()).first;
+                scopes.push_back({ ev.name, ev.depth, {}, {} });
+                if (parent == SIZE_MAX)
+                {
+                    roots.push_back(it->second);
+                }
+                else
+                {
+                    scopes[parent].children.push_back(it->second);
+                }
+            }
+            scopes[it->second].durations.push_back(ev.duration);
+            indices[ev.depth] = it->second;
+        }
+    }
+
+    // List the scopes depth first in the order they were first called
+    std::vector<profile_report_entry> report;
+    std::vector<size_t> pending(roots.rbegin(), roots.rend());
+    while (!pending.empty())
+    {
+        auto &scope = scopes[pending.back()];
+        pending.pop_back();
+        pending.insert(pending.end(), scope.children.rbegin(), scope.children.rend());
+
+        auto &durations = scope.durations;
+        std::sort(durations.begin(), durations.end());
+        auto percentile = [&durations](double p) -> double
+        {
+            size_t rank = (size_t)std::ceil(p * durations.size());
+            return durations[std::max<size_t>(rank, 1) - 1] / 1000000.0;
+        };
+
+        uint64_t total = 0;
+        for (auto duration : durations)
+        {
+            total += duration;
+        }
+
+        profile_report_entry entry;
+        entry.name = scope.name;
+        entry.depth = scope.depth;
+        entry.calls = durations.size();
+        entry.total_milliseconds = total / 1000000.0;
+        entry.mean_milliseconds = entry.total_milliseconds / durations.size();
+        entry.p50_milliseconds = percentile(0.50);
+        entry.p95_milliseconds = percentile(0.95);
+        entry.p99_milliseconds = percentile(0.99);
+        entry.max_milliseconds = durations.back() / 1000000.0;
+        report.push_back(entry);
+    }
+    return report;
+}
+
+static void profiling_append_json_string(std::string &json, const char * str)
+{
+    json += '"';
+    for (const char * ch = str; *ch != '\0'; ch++)
+    {
+        if (*ch == '"' || *ch == '\\')
+        {
+            json += '\\';
+        }
+        json += *ch;
+    }
+    json += '"';
+}
+
+bool profiling_write_trace(const utf8 * path)
+{
+    try
+    {
+        auto fs = FileStream(path, FILE_MODE_WRITE);
+        std::string json = "{\"traceEvents\":[";
+        bool first = true;
+        for (const auto &threadEvents : profiling_get_events())
+        {
+            for (const auto &ev : threadEvents.second)
+            {
+                char buffer[128];
+                json += first ? "\n{\"name\":" : ",\n{\"name\":";
+                profiling_append_json_string(json, ev.name);
+                snprintf(buffer, sizeof(buffer), ",\"cat\":\"openrct2\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                    (int64_t)(ev.start - _profileStartTime) / 1000.0, ev.duration / 1000.0, threadEvents.first);
+                json += buffer;
+                first = false;
+
+                // Write out in chunks to avoid holding the whole trace in memory
+                if (json.size() >= 1024 * 1024)
+                {
+                    fs.Write(json.data(), json.size());
+                    json.clear();
+                }
+            }
+        }
+        json += "\n]}\n";
+        fs.Write(json.data(), json.size());
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        log_error("Unable to write profile trace: %s", e.what());
+        return false;
+    }
+}
@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "common.h"
+
+struct profile_report_entry
+{
+    std::string name;
+    uint32_t depth;
+    uint64_t calls;
+    double total_milliseconds;
+    double mean_milliseconds;
+    double p50_milliseconds;
+    double p95_milliseconds;
+    double p99_milliseconds;
+    double max_milliseconds;
+};
+
+/**
+ * The profiler records how long each PROFILE_SCOPE took between profiling_start and profiling_stop.
+ * Scopes are grouped by the chain of scopes they were called from, so the report reads like a call tree.
+ * Recording is cheap enough to leave the scopes in release builds; when it is not running, a scope only
+ * checks a flag. Building with DISABLE_PROFILING removes the scopes altogether.
+ */
+void profiling_start();
+void profiling_stop();
+bool profiling_is_running();
+uint64_t profiling_get_event_count();
+
+/**
+ * Summarises the recorded scopes, with each scope following its parent.
+ */
+std::vector<profile_report_entry> profiling_get_report();
+
+/**
+ * Writes the recorded scopes in the Chrome trace event format, which chrome://tracing and other trace
+ * viewers can open.
+ */
+bool profiling_write_trace(const utf8 * path);
+
+extern std::atomic<bool> gProfilingRunning;
+
+class ProfileScope final
+{
+private:
+    const char * _name = nullptr;
+    uint64_t _start = 0;
+
+public:
+    explicit ProfileScope(const char * name)
+    {
+        if (gProfilingRunning.load(std::memory_order_relaxed))
+        {
+            Begin(name);
+        }
+    }
+
+    ~ProfileScope()
+    {
+        if (_name != nullptr)
+        {
+            End();
+        }
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope & operator=(const ProfileScope &) = delete;
+
+private:
+    void Begin(const char * name);
+    void End();
+};
+
+#ifndef DISABLE_PROFILING
+    #define PROFILE_CONCAT_INNER(a, b) a##b
+    #define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+    // The name must be a string literal, or at least outlive the profile
+    #define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(_profileScope, __LINE__)(name)
+#else
+    #define PROFILE_SCOPE(name) ((void)0)
+#endif
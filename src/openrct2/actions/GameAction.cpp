@@ -13,6 +13,7 @@
 #include "../core/Memory.hpp"
 #include "../core/MemoryStream.h"
 #include "../core/Util.hpp"
+#include "../Journal.h"
 #include "../localisation/Localisation.h"
 #include "../network/network.h"
 #include "../platform/platform.h"
@@ -41,16 +42,44 @@ GameActionResult::GameActionResult(GA_ERROR error, rct_string_id title, rct_stri
     std::copy_n(args, ErrorMessageArgs.size(), ErrorMessageArgs.begin());
 }
 
+void * GameActionPool::Allocate(size_t size)
+{
+    if (size == BlockSize && Count > 0)
+    {
+        return Blocks[--Count];
+    }
+    return ::operator new(size);
+}
+
+void GameActionPool::Free(void * ptr, size_t size)
+{
+    if (BlockSize == 0)
+    {
+        BlockSize = size;
+    }
+    if (size == BlockSize && Count < CAPACITY)
+    {
+        Blocks[Count++] = ptr;
+    }
+    else
+    {
+        ::operator delete(ptr);
+    }
+}
+
 namespace GameActions
 {
     static GameActionFactory _actions[GAME_COMMAND_COUNT];
+    static GameActionCloner _cloners[GAME_COMMAND_COUNT];
 
-    GameActionFactory Register(uint32_t id, GameActionFactory factory)
+    GameActionFactory Register(uint32_t id, GameActionFactory factory, GameActionCloner cloner)
     {
         Guard::Assert(id < Util::CountOf(_actions));
         Guard::ArgumentNotNull(factory);
+        Guard::ArgumentNotNull(cloner);
 
         _actions[id] = factory;
+        _cloners[id] = cloner;
         return factory;
     }
 
@@ -82,6 +111,21 @@ namespace GameActions
         return std::unique_ptr<GameAction>(result);
     }
 
+    GameAction::Ptr Clone(const GameAction * action)
+    {
+        Guard::ArgumentNotNull(action);
+        Initialize();
+
+        uint32_t id = action->GetType();
+        GameAction * result = nullptr;
+        if (id < Util::CountOf(_cloners) && _cloners[id] != nullptr)
+        {
+            result = _cloners[id](action);
+        }
+        Guard::ArgumentNotNull(result, "Attempting to clone unregistered gameaction: %u", id);
+        return std::unique_ptr<GameAction>(result);
+    }
+
     static bool CheckActionInPausedMode(uint32_t actionFlags)
     {
         if (gGamePaused == 0) return true;
@@ -170,7 +214,10 @@ namespace GameActions
             log_verbose("[%s] GameAction::Execute\n", "sv");
 
             // Execute the action, changing the game state
+            journal_record_action(action);
+            journal_begin_action();
             result = action->Execute();
+            journal_end_action();
 
             gCommandPosition.x = result->Position.x;
             gCommandPosition.y = result->Position.y;
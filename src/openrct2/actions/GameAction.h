@@ -52,6 +52,22 @@ namespace GA_FLAGS
     constexpr uint16_t EDITOR_ONLY        = 1 << 2;
 }
 
+/**
+ * Keeps a few freed allocations of one game action type for reuse, network games create and
+ * destroy an action for every command they receive.
+ */
+struct GameActionPool
+{
+    static constexpr size_t CAPACITY = 32;
+
+    void * Blocks[CAPACITY];
+    size_t Count;
+    size_t BlockSize;
+
+    void * Allocate(size_t size);
+    void Free(void * ptr, size_t size);
+};
+
 #ifdef __WARN_SUGGEST_FINAL_METHODS__
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wsuggest-final-methods"
@@ -216,24 +232,44 @@ public:
         });
     }
 
+    static void * operator new(size_t size)
+    {
+        return GetPool().Allocate(size);
+    }
+
+    static void operator delete(void * ptr, size_t size)
+    {
+        GetPool().Free(ptr, size);
+    }
+
 protected:
     template<class... TTypes>
     static constexpr std::unique_ptr<TResultType> MakeResult(TTypes&&... args)
     {
         return std::make_unique<TResultType>(std::forward<TTypes>(args)...);
     }
+
+private:
+    static GameActionPool& GetPool()
+    {
+        // Zero initialised and never destroyed, so actions can still be freed during shutdown
+        static thread_local GameActionPool pool;
+        return pool;
+    }
 };
 
 using GameActionFactory = GameAction *(*)();
+using GameActionCloner = GameAction *(*)(const GameAction *);
 
 namespace GameActions
 {
     void                    Initialize();
     void                    Register();
     GameAction::Ptr         Create(uint32_t id);
+    GameAction::Ptr         Clone(const GameAction * action);
     GameActionResult::Ptr   Query(const GameAction * action);
     GameActionResult::Ptr   Execute(const GameAction * action);
-    GameActionFactory       Register(uint32_t id, GameActionFactory action);
+    GameActionFactory       Register(uint32_t id, GameActionFactory action, GameActionCloner cloner);
 
     template<typename T>
     static GameActionFactory Register()
@@ -242,7 +278,11 @@ namespace GameActions
         {
             return new T();
         };
-        Register(T::TYPE, factory);
+        GameActionCloner cloner = [](const GameAction * action) -> GameAction *
+        {
+            return new T(static_cast<const T &>(*action));
+        };
+        Register(T::TYPE, factory, cloner);
         return factory;
     }
 } // namespace GameActions
@@ -0,0 +1,172 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include "../core/Console.hpp"
+#include "../core/Util.hpp"
+#include "../ride/TrackData.h"
+#include "../ride/Vehicle.h"
+#include "CommandLine.hpp"
+
+static exitcode_t HandleBenchTrack(CommandLineArgEnumerator *argEnumerator);
+
+const CommandLineCommand CommandLine::BenchTrackCommands[]
+{
+    // Main commands
+    DefineCommand("", "[iterations count]", nullptr, HandleBenchTrack),
+    CommandTableEnd
+};
+
+/**
+ * The number of move info lists of a vehicle type, as the lookup hard-coded them before the lists
+ * were flattened into gTrackVehicleInfoSets.
+ */
+static int32_t GetPointerTableSize(int32_t cd)
+{
+    switch (cd)
+    {
+    case 0:
+        return 1024;
+    case 1:
+        return 692;
+    case 2:
+    case 3:
+    case 4:
+        return 404;
+    case 5:
+    case 6:
+    case 7:
+    case 8:
+        return 208;
+    case 9:
+    case 10:
+    case 11:
+    case 12:
+    case 13:
+    case 14:
+        return 824;
+    default:
+        return 868;
+    }
+}
+
+static const rct_vehicle_info * GetPointerTableMoveInfo(int32_t cd, int32_t typeAndDirection, int32_t offset)
+{
+    static constexpr const rct_vehicle_info zero = {};
+    if (cd >= (int32_t)Util::CountOf(gTrackVehicleInfo) || typeAndDirection >= GetPointerTableSize(cd) ||
+        offset >= gTrackVehicleInfo[cd][typeAndDirection]->size)
+    {
+        return &zero;
+    }
+    return &gTrackVehicleInfo[cd][typeAndDirection]->info[offset];
+}
+
+static bool AreMoveInfosEqual(const rct_vehicle_info * a, const rct_vehicle_info * b)
+{
+    return a->x == b->x && a->y == b->y && a->z == b->z && a->direction == b->direction &&
+        a->vehicle_sprite_type == b->vehicle_sprite_type && a->bank_rotation == b->bank_rotation;
+}
+
+/**
+ * Checks that both lookups give the same number of subpositions and the same move info for each of them.
+ */
+static bool CompareMoveInfoTables()
+{
+    for (int32_t cd = 0; cd < (int32_t)Util::CountOf(gTrackVehicleInfoSets); cd++)
+    {
+        int32_t pointerTableSize = GetPointerTableSize(cd);
+        int32_t count = std::max<int32_t>(pointerTableSize, gTrackVehicleInfoSets[cd].count);
+        for (int32_t typeAndDirection = 0; typeAndDirection < count; typeAndDirection++)
+        {
+            int32_t pointerTableInfoSize = typeAndDirection < pointerTableSize ? gTrackVehicleInfo[cd][typeAndDirection]->size : 0;
+            int32_t size = vehicle_get_move_info_size(cd, typeAndDirection);
+            if (size != pointerTableInfoSize)
+            {
+                Console::Error::WriteLine("Vehicle type %d, track type and direction %d: %d subpositions instead of %d.",
+                    cd, typeAndDirection, size, pointerTableInfoSize);
+                return false;
+            }
+            for (int32_t offset = 0; offset < size; offset++)
+            {
+                if (!AreMoveInfosEqual(GetPointerTableMoveInfo(cd, typeAndDirection, offset),
+                        vehicle_get_move_info(cd, typeAndDirection, offset)))
+                {
+                    Console::Error::WriteLine("Vehicle type %d, track type and direction %d: subposition %d differs.",
+                        cd, typeAndDirection, offset);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Steps every vehicle type through every subposition of every track piece, the way vehicles
+ * moving along the track look up their next position.
+ */
+template<typename TLookup>
+static int64_t StepThroughTrack(TLookup lookup)
+{
+    int64_t checksum = 0;
+    for (int32_t cd = 0; cd < (int32_t)Util::CountOf(gTrackVehicleInfoSets); cd++)
+    {
+        for (int32_t typeAndDirection = 0; typeAndDirection < gTrackVehicleInfoSets[cd].count; typeAndDirection++)
+        {
+            int32_t size = vehicle_get_move_info_size(cd, typeAndDirection);
+            for (int32_t offset = 0; offset < size; offset++)
+            {
+                const rct_vehicle_info * info = lookup(cd, typeAndDirection, offset);
+                checksum += info->x + info->y + info->z + info->direction;
+            }
+        }
+    }
+    return checksum;
+}
+
+template<typename TLookup>
+static double MeasureLookups(TLookup lookup, int32_t iterations, int64_t * checksum)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+    *checksum = 0;
+    for (int32_t i = 0; i < iterations; i++)
+    {
+        *checksum += StepThroughTrack(lookup);
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - startTime;
+    return duration.count();
+}
+
+static exitcode_t HandleBenchTrack(CommandLineArgEnumerator *argEnumerator)
+{
+    int32_t iterations = 100;
+    if (argEnumerator->TryPopInteger(&iterations) && iterations <= 0)
+    {
+        Console::Error::WriteLine("The iteration count must be positive.");
+        return EXITCODE_FAIL;
+    }
+
+    if (!CompareMoveInfoTables())
+    {
+        Console::Error::WriteLine("The vehicle move info tables do not match.");
+        return EXITCODE_FAIL;
+    }
+
+    // The sums are printed so that the lookups cannot be optimised away
+    int64_t pointerTableChecksum;
+    int64_t flatTableChecksum;
+    double pointerTableTime = MeasureLookups(GetPointerTableMoveInfo, iterations, &pointerTableChecksum);
+    double flatTableTime = MeasureLookups(vehicle_get_move_info, iterations, &flatTableChecksum);
+
+    Console::WriteLine("Stepped through all track pieces %d times.", iterations);
+    Console::WriteLine("Pointer tables: %.2f ms (sum %lld)", pointerTableTime, (long long)pointerTableChecksum);
+    Console::WriteLine("Flat tables:    %.2f ms (sum %lld)", flatTableTime, (long long)flatTableChecksum);
+    return EXITCODE_OK;
+}
@@ -93,6 +93,7 @@ namespace CommandLine
     extern const CommandLineCommand ScreenshotCommands[];
     extern const CommandLineCommand SpriteCommands[];
     extern const CommandLineCommand BenchGfxCommands[];
+    extern const CommandLineCommand BenchTrackCommands[];
 
     extern const CommandLineExample RootExamples[];
 
@@ -101,4 +102,5 @@ namespace CommandLine
 
     exitcode_t HandleCommandConvert(CommandLineArgEnumerator * enumerator);
     exitcode_t HandleCommandUri(CommandLineArgEnumerator * enumerator);
+    exitcode_t HandleCommandReplay(CommandLineArgEnumerator * enumerator);
 } // namespace CommandLine
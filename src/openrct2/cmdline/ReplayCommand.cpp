@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <memory>
+#include "../Context.h"
+#include "../core/Console.hpp"
+#include "../core/Path.hpp"
+#include "../Journal.h"
+#include "../OpenRCT2.h"
+#include "../platform/platform.h"
+#include "CommandLine.hpp"
+
+exitcode_t CommandLine::HandleCommandReplay(CommandLineArgEnumerator * enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    const utf8 * rawJournalPath;
+    if (!enumerator->TryPopString(&rawJournalPath))
+    {
+        Console::Error::WriteLine("Expected a journal path.");
+        return EXITCODE_FAIL;
+    }
+
+    utf8 journalPath[MAX_PATH];
+    Path::GetAbsolute(journalPath, sizeof(journalPath), rawJournalPath);
+
+    int32_t checksumInterval = 0;
+    if (enumerator->TryPopInteger(&checksumInterval) && checksumInterval < 0)
+    {
+        Console::Error::WriteLine("The checksum interval must not be negative.");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<OpenRCT2::IContext> context(OpenRCT2::CreateContext());
+    if (!context->Initialise())
+    {
+        return EXITCODE_FAIL;
+    }
+
+    if (journal_replay(journalPath, (uint32_t)checksumInterval) < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
@@ -82,6 +82,7 @@ struct GeneralConfiguration
     bool        steam_overlay_pause;
     bool        show_real_names_of_guests;
     bool        allow_early_completion;
+    bool        memory_map_graphics;
 
     bool        confirmation_prompt;
     int32_t      load_save_sort;
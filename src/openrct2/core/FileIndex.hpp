@@ -20,6 +20,7 @@
 #include "FileScanner.h"
 #include "FileStream.hpp"
 #include "JobPool.hpp"
+#include "MemoryStream.h"
 #include "Path.hpp"
 
 template<typename TItem>
@@ -276,10 +277,12 @@ private:
             try
             {
                 log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
-                auto fs = FileStream(_indexPath, FILE_MODE_OPEN);
+                // Items are deserialised a field at a time, so read the whole index up front
+                auto indexData = File::ReadAllBytes(_indexPath);
+                auto ms = MemoryStream(indexData.data(), indexData.size());
 
                 // Read header, check if we need to re-scan
-                auto header = fs.ReadValue<FileIndexHeader>();
+                auto header = ms.ReadValue<FileIndexHeader>();
                 if (header.HeaderSize == sizeof(FileIndexHeader) &&
                     header.MagicNumber == _magicNumber &&
                     header.VersionA == FILE_INDEX_VERSION &&
@@ -294,7 +297,7 @@ private:
                     // Directory is the same, just read the saved items
                     for (uint32_t i = 0; i < header.NumItems; i++)
                     {
-                        auto item = Deserialise(&fs);
+                        auto item = Deserialise(&ms);
                         items.push_back(item);
                     }
                     loadedItems = true;
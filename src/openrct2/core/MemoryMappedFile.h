@@ -0,0 +1,37 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <string>
+#include "../common.h"
+
+/**
+ * Maps a whole file into memory as copy-on-write pages. Pages are only read from disk when first touched
+ * and are shared with every other process mapping the same file until they are written to.
+ */
+class MemoryMappedFile final
+{
+private:
+    void *  _data = nullptr;
+    size_t  _length = 0;
+#ifdef _WIN32
+    void *  _fileHandle = nullptr;
+    void *  _mappingHandle = nullptr;
+#endif
+
+public:
+    explicit MemoryMappedFile(const std::string& path);
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    ~MemoryMappedFile();
+
+    uint8_t *   GetData() const { return (uint8_t *)_data; }
+    size_t      GetLength() const { return _length; }
+};
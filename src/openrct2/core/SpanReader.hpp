@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "../common.h"
+#include "IStream.hpp"
+#include "MemoryStream.h"
+
+/**
+ * A non-virtual, bounds checked reader over a block of memory. Use this instead of IStream for loops
+ * that decode many small fields, after taking the block from the stream in one go with FromStream.
+ */
+class SpanReader final
+{
+private:
+    std::vector<uint8_t>    _buffer;
+    const uint8_t *         _data = nullptr;
+    size_t                  _length = 0;
+    size_t                  _position = 0;
+
+public:
+    SpanReader(const void * data, size_t length)
+        : _data((const uint8_t *)data),
+          _length(length)
+    {
+    }
+
+    SpanReader(const SpanReader&) = delete;
+    SpanReader& operator=(const SpanReader&) = delete;
+    SpanReader(SpanReader&&) = default;
+    SpanReader& operator=(SpanReader&&) = default;
+
+    /**
+     * Takes the next length bytes of the stream and advances the stream past them. Memory streams
+     * are read in place, any other stream is read once into a buffer owned by the reader.
+     */
+    static SpanReader FromStream(IStream * stream, size_t length)
+    {
+        auto memoryStream = dynamic_cast<MemoryStream *>(stream);
+        if (memoryStream != nullptr)
+        {
+            auto position = memoryStream->GetPosition();
+            if (memoryStream->GetLength() - position < length)
+            {
+                throw IOException("Attempted to read past end of stream.");
+            }
+            memoryStream->Seek(length, STREAM_SEEK_CURRENT);
+            return SpanReader((const uint8_t *)memoryStream->GetData() + position, length);
+        }
+
+        std::vector<uint8_t> buffer(length);
+        stream->Read(buffer.data(), length);
+        auto reader = SpanReader(buffer.data(), length);
+        reader._buffer = std::move(buffer);
+        return reader;
+    }
+
+    size_t GetLength() const { return _length; }
+    size_t GetPosition() const { return _position; }
+    size_t GetRemaining() const { return _length - _position; }
+
+    void SetPosition(size_t position)
+    {
+        if (position > _length)
+        {
+            throw IOException("New position out of bounds.");
+        }
+        _position = position;
+    }
+
+    void Skip(size_t length)
+    {
+        ReadView(length);
+    }
+
+    /**
+     * Returns a pointer to the next length bytes without copying them.
+     */
+    const uint8_t * ReadView(size_t length)
+    {
+        if (length > _length - _position)
+        {
+            throw IOException("Attempted to read past end of stream.");
+        }
+        auto view = _data + _position;
+        _position += length;
+        return view;
+    }
+
+    void Read(void * buffer, size_t length)
+    {
+        std::memcpy(buffer, ReadView(length), length);
+    }
+
+    size_t TryRead(void * buffer, size_t length)
+    {
+        size_t readLength = std::min(length, GetRemaining());
+        Read(buffer, readLength);
+        return readLength;
+    }
+
+    template<typename T>
+    T ReadValue()
+    {
+        T value;
+        std::memcpy(&value, ReadView(sizeof(T)), sizeof(T));
+        return value;
+    }
+};
@@ -10,6 +10,7 @@
 #include "../common.h"
 #include "../core/Guard.hpp"
 #include "Drawing.h"
+#include "LightFX.h"
 
 #ifdef __AVX2__
 
@@ -40,6 +41,50 @@ void mask_avx2(int32_t width, int32_t height, const uint8_t * RESTRICT maskSrc,
     }
 }
 
+#ifdef __ENABLE_LIGHTFX__
+
+void lightfx_mix_row_avx2(uint32_t * RESTRICT dst, const uint8_t * RESTRICT src, const uint8_t * RESTRICT lightBits,
+                          uint32_t width, const uint32_t * palette, const uint32_t * lightPalette)
+{
+    // Spreads the intensity of each pixel over its four 16-bit channels, per 128-bit lane
+    const __m256i spreadLo = _mm256_setr_epi8(
+        0, -1, 0, -1, 0, -1, 0, -1, 1, -1, 1, -1, 1, -1, 1, -1,
+        4, -1, 4, -1, 4, -1, 4, -1, 5, -1, 5, -1, 5, -1, 5, -1);
+    const __m256i spreadHi = _mm256_setr_epi8(
+        2, -1, 2, -1, 2, -1, 2, -1, 3, -1, 3, -1, 3, -1, 3, -1,
+        6, -1, 6, -1, 6, -1, 6, -1, 7, -1, 7, -1, 7, -1, 7, -1);
+    const __m256i six = _mm256_set1_epi16(6);
+
+    uint32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m128i intensities = _mm_loadl_epi64((const __m128i *)&lightBits[x]);
+        const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&src[x]));
+        const __m256i dark = _mm256_i32gather_epi32((const int *)palette, indices, 4);
+        if (_mm_testz_si128(intensities, intensities)) {
+            _mm256_storeu_si256((__m256i *)&dst[x], dark);
+            continue;
+        }
+
+        const __m256i light = _mm256_i32gather_epi32((const int *)lightPalette, indices, 4);
+
+        // Widening works per 128-bit lane, so pixels 0, 1, 4, 5 end up in the low half and 2, 3, 6, 7 in the high half
+        const __m256i darkLo = _mm256_unpacklo_epi8(dark, _mm256_setzero_si256());
+        const __m256i darkHi = _mm256_unpackhi_epi8(dark, _mm256_setzero_si256());
+        const __m256i lightLo = _mm256_unpacklo_epi8(_mm256_setzero_si256(), light);
+        const __m256i lightHi = _mm256_unpackhi_epi8(_mm256_setzero_si256(), light);
+        const __m256i intensity = _mm256_broadcastsi128_si256(intensities);
+        const __m256i intensityLo = _mm256_mullo_epi16(_mm256_shuffle_epi8(intensity, spreadLo), six);
+        const __m256i intensityHi = _mm256_mullo_epi16(_mm256_shuffle_epi8(intensity, spreadHi), six);
+
+        const __m256i mixedLo = _mm256_add_epi16(darkLo, _mm256_mulhi_epu16(lightLo, intensityLo));
+        const __m256i mixedHi = _mm256_add_epi16(darkHi, _mm256_mulhi_epu16(lightHi, intensityHi));
+        _mm256_storeu_si256((__m256i *)&dst[x], _mm256_packus_epi16(mixedLo, mixedHi));
+    }
+    lightfx_mix_row_scalar(dst + x, src + x, lightBits + x, width - x, palette, lightPalette);
+}
+
+#endif // __ENABLE_LIGHTFX__
+
 #else
 
 #ifdef OPENRCT2_X86
@@ -52,4 +97,14 @@ void mask_avx2(int32_t width, int32_t height, const uint8_t * RESTRICT maskSrc,
     openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+#ifdef __ENABLE_LIGHTFX__
+
+void lightfx_mix_row_avx2(uint32_t * RESTRICT dst, const uint8_t * RESTRICT src, const uint8_t * RESTRICT lightBits,
+                          uint32_t width, const uint32_t * palette, const uint32_t * lightPalette)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+#endif // __ENABLE_LIGHTFX__
+
 #endif // __AVX2__
@@ -11,19 +11,17 @@
 #include <stdexcept>
 #include <vector>
 #include "../config/Config.h"
-#include "../Context.h"
 #include "../core/FileStream.hpp"
+#include "../core/MemoryMappedFile.h"
 #include "../core/Path.hpp"
 #include "../OpenRCT2.h"
 #include "../platform/platform.h"
 #include "../PlatformEnvironment.h"
 #include "../sprites.h"
-#include "../ui/UiContext.h"
 #include "../util/Util.h"
 #include "Drawing.h"
 
 using namespace OpenRCT2;
-using namespace OpenRCT2::Ui;
 
 #pragma pack(push, 1)
 struct rct_g1_header
@@ -39,6 +37,7 @@ struct rct_gx
     rct_g1_header header;
     std::vector<rct_g1_element> elements;
     void * data;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
 };
 
 // clang-format off
@@ -186,6 +185,46 @@ void mask_scalar(int32_t width, int32_t height, const uint8_t * RESTRICT maskSrc
     }
 }
 
+/**
+ * Reads the element data that follows in the stream, or maps it straight from the file when the
+ * memory_map_graphics option is enabled so that it is only paged in once drawn.
+ */
+static void gfx_read_gx_data(rct_gx& gx, IStream& stream, const std::string& path)
+{
+    if (gConfigGeneral.memory_map_graphics)
+    {
+        try
+        {
+            auto mappedFile = std::make_unique<MemoryMappedFile>(path);
+            auto dataOffset = (size_t)stream.GetPosition();
+            if (mappedFile->GetLength() >= dataOffset + gx.header.total_size)
+            {
+                gx.data = mappedFile->GetData() + dataOffset;
+                gx.mappedFile = std::move(mappedFile);
+                return;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            log_warning("Unable to map %s, reading it instead: %s", path.c_str(), e.what());
+        }
+    }
+    gx.data = stream.ReadArray<uint8_t>(gx.header.total_size);
+}
+
+static void gfx_free_gx_data(rct_gx& gx)
+{
+    if (gx.mappedFile != nullptr)
+    {
+        gx.mappedFile = nullptr;
+        gx.data = nullptr;
+    }
+    else
+    {
+        SafeFree(gx.data);
+    }
+}
+
 static std::string gfx_get_csg_header_path()
 {
     auto path = Path::ResolveCasing(Path::Combine(gConfigGeneral.rct1_path, "Data", "csg1i.dat"));
@@ -245,7 +284,7 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
         gTinyFontAntiAliased = is_rctc;
 
         // Read element data
-        _g1.data = fs.ReadArray<uint8_t>(_g1.header.total_size);
+        gfx_read_gx_data(_g1, fs, path);
 
         // Fix entry data offsets
         for (uint32_t i = 0; i < _g1.header.num_entries; i++)
@@ -260,32 +299,27 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
         _g1.elements.shrink_to_fit();
 
         log_fatal("Unable to load g1 graphics");
-        if (!gOpenRCT2Headless)
-        {
-            auto uiContext = GetContext()->GetUiContext();
-            uiContext->ShowMessageBox("Unable to load g1.dat. Your RollerCoaster Tycoon 2 path may be incorrectly set.");
-        }
         return false;
     }
 }
 
 void gfx_unload_g1()
 {
-    SafeFree(_g1.data);
+    gfx_free_gx_data(_g1);
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
 }
 
 void gfx_unload_g2()
 {
-    SafeFree(_g2.data);
+    gfx_free_gx_data(_g2);
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
 }
 
 void gfx_unload_csg()
 {
-    SafeFree(_csg.data);
+    gfx_free_gx_data(_csg);
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
 }
@@ -308,7 +342,7 @@ bool gfx_load_g2()
         read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements.data());
 
         // Read element data
-        _g2.data = fs.ReadArray<uint8_t>(_g2.header.total_size);
+        gfx_read_gx_data(_g2, fs, path);
 
         // Fix entry data offsets
         for (uint32_t i = 0; i < _g2.header.num_entries; i++)
@@ -323,11 +357,6 @@ bool gfx_load_g2()
         _g2.elements.shrink_to_fit();
 
         log_fatal("Unable to load g2 graphics");
-        if (!gOpenRCT2Headless)
-        {
-            auto uiContext = GetContext()->GetUiContext();
-            uiContext->ShowMessageBox("Unable to load g2.dat");
-        }
     }
     return false;
 }
@@ -365,7 +394,7 @@ bool gfx_load_csg()
         read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements.data());
 
         // Read element data
-        _csg.data = fileData.ReadArray<uint8_t>(_csg.header.total_size);
+        gfx_read_gx_data(_csg, fileData, pathDataPath);
 
         // Fix entry data offsets
         for (uint32_t i = 0; i < _csg.header.num_entries; i++)
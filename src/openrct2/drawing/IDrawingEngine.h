@@ -31,6 +31,20 @@ enum DRAWING_ENGINE_FLAGS
     DEF_DIRTY_OPTIMISATIONS = 1 << 0,
 };
 
+/**
+ * How much of the screen an engine with dirty optimisations redrew, for the last frame and in total.
+ */
+struct drawing_engine_stats
+{
+    uint32_t frames;
+    uint32_t last_rects;
+    uint64_t last_pixels;
+    double   last_milliseconds;
+    uint64_t total_rects;
+    uint64_t total_pixels;
+    double   total_milliseconds;
+};
+
 struct rct_drawpixelinfo;
 struct rct_palette_entry;
 
@@ -68,6 +82,9 @@ namespace OpenRCT2::Drawing
         virtual DRAWING_ENGINE_FLAGS GetFlags() abstract;
 
         virtual void InvalidateImage(uint32_t image) abstract;
+
+        virtual const drawing_engine_stats * GetStats() abstract;
+        virtual void ResetStats() abstract;
     };
 
     interface IDrawingEngineFactory
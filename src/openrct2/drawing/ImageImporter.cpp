@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 #include <string>
@@ -227,17 +228,17 @@ std::tuple<void *, size_t> ImageImporter::EncodeRLE(const int32_t * pixels, uint
 int32_t ImageImporter::CalculatePaletteIndex(IMPORT_MODE mode, int16_t * rgbaSrc, int32_t x, int32_t y, int32_t width, int32_t height)
 {
     auto palette = StandardPalette;
-    auto paletteIndex = GetPaletteIndex(palette, rgbaSrc);
+    auto paletteIndex = GetPaletteIndex(rgbaSrc);
     if (mode == IMPORT_MODE::CLOSEST || mode == IMPORT_MODE::DITHERING)
     {
         if (paletteIndex == PALETTE_TRANSPARENT && !IsTransparentPixel(rgbaSrc))
         {
-            paletteIndex = GetClosestPaletteIndex(palette, rgbaSrc);
+            paletteIndex = GetClosestPaletteIndex(rgbaSrc);
         }
     }
     if (mode == IMPORT_MODE::DITHERING)
     {
-        if (!IsTransparentPixel(rgbaSrc) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc)))
+        if (!IsTransparentPixel(rgbaSrc) && IsChangablePixel(GetPaletteIndex(rgbaSrc)))
         {
             auto dr = rgbaSrc[0] - (int16_t)(palette[paletteIndex].Red);
             auto dg = rgbaSrc[1] - (int16_t)(palette[paletteIndex].Green);
@@ -245,7 +246,7 @@ int32_t ImageImporter::CalculatePaletteIndex(IMPORT_MODE mode, int16_t * rgbaSrc
 
             if (x + 1 < width)
             {
-                if (!IsTransparentPixel(rgbaSrc + 4) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4)))
+                if (!IsTransparentPixel(rgbaSrc + 4) && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4)))
                 {
                     // Right
                     rgbaSrc[4] += dr * 7 / 16;
@@ -258,7 +259,7 @@ int32_t ImageImporter::CalculatePaletteIndex(IMPORT_MODE mode, int16_t * rgbaSrc
             {
                 if (x > 0)
                 {
-                    if (!IsTransparentPixel(rgbaSrc + 4 * (width - 1)) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * (width - 1))))
+                    if (!IsTransparentPixel(rgbaSrc + 4 * (width - 1)) && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * (width - 1))))
                     {
                         // Bottom left
                         rgbaSrc[4 * (width - 1)] += dr * 3 / 16;
@@ -268,7 +269,7 @@ int32_t ImageImporter::CalculatePaletteIndex(IMPORT_MODE mode, int16_t * rgbaSrc
                 }
 
                 // Bottom
-                if (!IsTransparentPixel(rgbaSrc + 4 * width) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * width)))
+                if (!IsTransparentPixel(rgbaSrc + 4 * width) && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * width)))
                 {
                     rgbaSrc[4 * width] += dr * 5 / 16;
                     rgbaSrc[4 * width + 1] += dg * 5 / 16;
@@ -277,7 +278,7 @@ int32_t ImageImporter::CalculatePaletteIndex(IMPORT_MODE mode, int16_t * rgbaSrc
 
                 if (x + 1 < width)
                 {
-                    if (!IsTransparentPixel(rgbaSrc + 4 * (width + 1)) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * (width + 1))))
+                    if (!IsTransparentPixel(rgbaSrc + 4 * (width + 1)) && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * (width + 1))))
                     {
                         // Bottom right
                         rgbaSrc[4 * (width + 1)] += dr * 1 / 16;
@@ -291,19 +292,11 @@ int32_t ImageImporter::CalculatePaletteIndex(IMPORT_MODE mode, int16_t * rgbaSrc
     return paletteIndex;
 }
 
-int32_t ImageImporter::GetPaletteIndex(const PaletteBGRA * palette, int16_t * colour)
+int32_t ImageImporter::GetPaletteIndex(const int16_t * colour)
 {
     if (!IsTransparentPixel(colour))
     {
-        for (int32_t i = 0; i < 256; i++)
-        {
-            if ((int16_t)(palette[i].Red) == colour[0] &&
-                (int16_t)(palette[i].Green) == colour[1] &&
-                (int16_t)(palette[i].Blue) == colour[2])
-            {
-                return i;
-            }
-        }
+        return GetStandardPaletteLookup().GetIndex(colour);
     }
     return PALETTE_TRANSPARENT;
 }
@@ -333,26 +326,135 @@ bool ImageImporter::IsChangablePixel(int32_t paletteIndex)
     return true;
 }
 
-int32_t ImageImporter::GetClosestPaletteIndex(const PaletteBGRA * palette, const int16_t * colour)
+int32_t ImageImporter::GetClosestPaletteIndex(const int16_t * colour)
 {
-    auto smallestError = (uint32_t)-1;
-    auto bestMatch = PALETTE_TRANSPARENT;
-    for (int32_t x = 0; x < 256; x++)
+    return GetStandardPaletteLookup().GetClosestIndex(colour);
+}
+
+static uint32_t GetColourKey(int32_t red, int32_t green, int32_t blue)
+{
+    return (red << 16) | (green << 8) | blue;
+}
+
+static bool IsColourInRange(const int16_t * colour)
+{
+    return colour[0] >= 0 && colour[0] <= 255 &&
+           colour[1] >= 0 && colour[1] <= 255 &&
+           colour[2] >= 0 && colour[2] <= 255;
+}
+
+ImageImporter::PaletteLookup::PaletteLookup(const PaletteBGRA * palette)
+    : _palette(palette)
+{
+    for (int32_t i = 0; i < 256; i++)
+    {
+        // Keep the first index of colours that appear more than once
+        _exactIndices.emplace(GetColourKey(palette[i].Red, palette[i].Green, palette[i].Blue), (uint8_t)i);
+    }
+
+    for (int32_t i = 0; i < 256; i++)
+    {
+        if (IsChangablePixel(i))
+        {
+            _changableIndices.push_back((uint8_t)i);
+        }
+    }
+
+    // Squared distance from a channel value to the nearest and furthest point of [lo, hi]
+    auto minDistance = [](int32_t value, int32_t lo, int32_t hi) {
+        int32_t d = value < lo ? lo - value : (value > hi ? value - hi : 0);
+        return d * d;
+    };
+    auto maxDistance = [](int32_t value, int32_t lo, int32_t hi) {
+        int32_t d = std::max(std::abs(value - lo), std::abs(value - hi));
+        return d * d;
+    };
+
+    _cellOffsets.reserve(NUM_CELLS + 1);
+    for (int32_t cell = 0; cell < NUM_CELLS; cell++)
     {
-        if (IsChangablePixel(x))
+        int32_t loR = ((cell / (CELLS_PER_AXIS * CELLS_PER_AXIS)) % CELLS_PER_AXIS) << CELL_BITS;
+        int32_t loG = ((cell / CELLS_PER_AXIS) % CELLS_PER_AXIS) << CELL_BITS;
+        int32_t loB = (cell % CELLS_PER_AXIS) << CELL_BITS;
+        int32_t hiR = loR + (1 << CELL_BITS) - 1;
+        int32_t hiG = loG + (1 << CELL_BITS) - 1;
+        int32_t hiB = loB + (1 << CELL_BITS) - 1;
+
+        // No colour in the cell is further than this from its nearest entry, so entries that are
+        // further than this from the whole cell can never be the nearest
+        int32_t bound = INT32_MAX;
+        for (auto i : _changableIndices)
         {
-            uint32_t error =
-                ((int16_t)(palette[x].Red) - colour[0]) * ((int16_t)(palette[x].Red) - colour[0]) +
-                ((int16_t)(palette[x].Green) - colour[1]) * ((int16_t)(palette[x].Green) - colour[1]) +
-                ((int16_t)(palette[x].Blue) - colour[2]) * ((int16_t)(palette[x].Blue) - colour[2]);
+            bound = std::min(bound,
+                maxDistance(palette[i].Red, loR, hiR) +
+                maxDistance(palette[i].Green, loG, hiG) +
+                maxDistance(palette[i].Blue, loB, hiB));
+        }
 
-            if (smallestError == (uint32_t)-1 || smallestError > error)
+        _cellOffsets.push_back((uint32_t)_candidates.size());
+        for (auto i : _changableIndices)
+        {
+            int32_t distance =
+                minDistance(palette[i].Red, loR, hiR) +
+                minDistance(palette[i].Green, loG, hiG) +
+                minDistance(palette[i].Blue, loB, hiB);
+            if (distance <= bound)
             {
-                bestMatch = x;
-                smallestError = error;
+                _candidates.push_back(i);
             }
         }
     }
+    _cellOffsets.push_back((uint32_t)_candidates.size());
+}
+
+int32_t ImageImporter::PaletteLookup::GetIndex(const int16_t * colour) const
+{
+    if (IsColourInRange(colour))
+    {
+        auto it = _exactIndices.find(GetColourKey(colour[0], colour[1], colour[2]));
+        if (it != _exactIndices.end())
+        {
+            return it->second;
+        }
+    }
+    return PALETTE_TRANSPARENT;
+}
+
+int32_t ImageImporter::PaletteLookup::GetClosestIndex(const int16_t * colour) const
+{
+    if (!IsColourInRange(colour))
+    {
+        // Dithering can push colours out of range, the cells do not cover those
+        return GetClosestIndex(colour, _changableIndices.data(), _changableIndices.size());
+    }
+
+    auto cell =
+        ((colour[0] >> CELL_BITS) * CELLS_PER_AXIS * CELLS_PER_AXIS) +
+        ((colour[1] >> CELL_BITS) * CELLS_PER_AXIS) +
+        (colour[2] >> CELL_BITS);
+    auto begin = _cellOffsets[cell];
+    auto end = _cellOffsets[cell + 1];
+    return GetClosestIndex(colour, &_candidates[begin], end - begin);
+}
+
+int32_t ImageImporter::PaletteLookup::GetClosestIndex(const int16_t * colour, const uint8_t * candidates, size_t numCandidates) const
+{
+    auto smallestError = (uint32_t)-1;
+    auto bestMatch = PALETTE_TRANSPARENT;
+    for (size_t i = 0; i < numCandidates; i++)
+    {
+        auto x = candidates[i];
+        uint32_t error =
+            ((int16_t)(_palette[x].Red) - colour[0]) * ((int16_t)(_palette[x].Red) - colour[0]) +
+            ((int16_t)(_palette[x].Green) - colour[1]) * ((int16_t)(_palette[x].Green) - colour[1]) +
+            ((int16_t)(_palette[x].Blue) - colour[2]) * ((int16_t)(_palette[x].Blue) - colour[2]);
+
+        if (smallestError == (uint32_t)-1 || smallestError > error)
+        {
+            bestMatch = x;
+            smallestError = error;
+        }
+    }
     return bestMatch;
 }
 
@@ -641,3 +743,9 @@ const PaletteBGRA ImageImporter::StandardPalette[256] =
     // 255 (unused?)
     { 0, 0, 0, 255 }
 };
+
+const ImageImporter::PaletteLookup& ImageImporter::GetStandardPaletteLookup()
+{
+    static const PaletteLookup lookup(StandardPalette);
+    return lookup;
+}
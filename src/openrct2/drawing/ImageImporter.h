@@ -9,6 +9,8 @@
 
 #include <string_view>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 #include "../core/Imaging.h"
 #include "Drawing.h"
 
@@ -51,16 +53,44 @@ namespace OpenRCT2::Drawing
             IMPORT_MODE mode = IMPORT_MODE::DEFAULT) const;
 
     private:
+        /**
+         * Answers exact and nearest colour queries for a palette. For the nearest colour, RGB space is split
+         * into cells and each cell keeps the few palette entries that can be closest to a colour inside it.
+         */
+        class PaletteLookup
+        {
+        private:
+            static constexpr int32_t CELL_BITS = 4;
+            static constexpr int32_t CELLS_PER_AXIS = 256 >> CELL_BITS;
+            static constexpr int32_t NUM_CELLS = CELLS_PER_AXIS * CELLS_PER_AXIS * CELLS_PER_AXIS;
+
+            const PaletteBGRA * const _palette;
+            std::unordered_map<uint32_t, uint8_t> _exactIndices;
+            std::vector<uint8_t> _changableIndices;
+            std::vector<uint8_t> _candidates;
+            std::vector<uint32_t> _cellOffsets;
+
+        public:
+            explicit PaletteLookup(const PaletteBGRA * palette);
+
+            int32_t GetIndex(const int16_t * colour) const;
+            int32_t GetClosestIndex(const int16_t * colour) const;
+
+        private:
+            int32_t GetClosestIndex(const int16_t * colour, const uint8_t * candidates, size_t numCandidates) const;
+        };
+
         static const PaletteBGRA StandardPalette[256];
+        static const PaletteLookup& GetStandardPaletteLookup();
 
         static std::vector<int32_t> GetPixels(const uint8_t * pixels, uint32_t width, uint32_t height, IMPORT_FLAGS flags, IMPORT_MODE mode);
         static std::tuple<void *, size_t> EncodeRaw(const int32_t * pixels, uint32_t width, uint32_t height);
         static std::tuple<void *, size_t> EncodeRLE(const int32_t * pixels, uint32_t width, uint32_t height);
 
         static int32_t CalculatePaletteIndex(IMPORT_MODE mode, int16_t * rgbaSrc, int32_t x, int32_t y, int32_t width, int32_t height);
-        static int32_t GetPaletteIndex(const PaletteBGRA * palette, int16_t * colour);
+        static int32_t GetPaletteIndex(const int16_t * colour);
         static bool IsTransparentPixel(const int16_t * colour);
         static bool IsChangablePixel(int32_t paletteIndex);
-        static int32_t GetClosestPaletteIndex(const PaletteBGRA * palette, const int16_t * colour);
+        static int32_t GetClosestPaletteIndex(const int16_t * colour);
     };
 }
@@ -12,8 +12,10 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <memory>
 #include "../common.h"
 #include "../config/Config.h"
+#include "../core/JobPool.hpp"
 #include "../Game.h"
 #include "../interface/Viewport.h"
 #include "../interface/Window.h"
@@ -73,6 +75,20 @@ static uint8_t            _current_view_zoom_back_delay   = 0;
 
 static rct_palette gPalette_light;
 
+// Area of the front buffer that lights were drawn to, everything outside it is zero
+static int32_t _lightBoundsLeft;
+static int32_t _lightBoundsTop;
+static int32_t _lightBoundsRight;
+static int32_t _lightBoundsBottom;
+
+static void (*_lightfxMixRowFn)(uint32_t * RESTRICT dst, const uint8_t * RESTRICT src, const uint8_t * RESTRICT lightBits,
+                                uint32_t width, const uint32_t * palette, const uint32_t * lightPalette) = lightfx_mix_row_scalar;
+
+static std::unique_ptr<JobPool> _lightfxJobPool;
+
+// Rows per band when converting the screen on several threads
+constexpr uint32_t LIGHTFX_MIN_ROWS_PER_BAND = 64;
+
 static uint8_t calc_light_intensity_lantern(int32_t x, int32_t y) {
     double distance = (double)(x * x + y * y);
 
@@ -152,6 +168,22 @@ void lightfx_init()
     calc_rescale_light_half(_bakedLightTexture_spot_2, _bakedLightTexture_spot_3, 128, 128);
     calc_rescale_light_half(_bakedLightTexture_spot_1, _bakedLightTexture_spot_2, 64, 64);
     calc_rescale_light_half(_bakedLightTexture_spot_0, _bakedLightTexture_spot_1, 32, 32);
+
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 light mix function");
+        _lightfxMixRowFn = lightfx_mix_row_avx2;
+    }
+    else if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 light mix function");
+        _lightfxMixRowFn = lightfx_mix_row_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar light mix function");
+        _lightfxMixRowFn = lightfx_mix_row_scalar;
+    }
 }
 
 void lightfx_update_buffers(rct_drawpixelinfo *info)
@@ -160,6 +192,12 @@ void lightfx_update_buffers(rct_drawpixelinfo *info)
     _light_rendered_buffer_back     = realloc(_light_rendered_buffer_back,  info->width * info->height);
 
     memcpy(&_pixelInfo, info, sizeof(rct_drawpixelinfo));
+
+    // The new buffers have not been cleared yet
+    _lightBoundsLeft = 0;
+    _lightBoundsTop = 0;
+    _lightBoundsRight = info->width;
+    _lightBoundsBottom = info->height;
 }
 
 extern void viewport_paint_setup();
@@ -463,7 +501,15 @@ void lightfx_render_lights_to_frontbuffer()
         return;
     }
 
-    memset(_light_rendered_buffer_front, 0, _pixelInfo.width * _pixelInfo.height);
+    // Only the area lit last frame needs clearing
+    uint8_t * lightBuffer = (uint8_t *)_light_rendered_buffer_front;
+    for (int32_t y = _lightBoundsTop; y < _lightBoundsBottom; y++) {
+        memset(lightBuffer + y * _pixelInfo.width + _lightBoundsLeft, 0, _lightBoundsRight - _lightBoundsLeft);
+    }
+    _lightBoundsLeft = _pixelInfo.width;
+    _lightBoundsTop = _pixelInfo.height;
+    _lightBoundsRight = 0;
+    _lightBoundsBottom = 0;
 
     _lightPolution_back = 0;
 
@@ -580,6 +626,13 @@ void lightfx_render_lights_to_frontbuffer()
 
         _lightPolution_back += (bufWriteWidth * bufWriteHeight) / 256;
 
+        int32_t writeLeft = std::max(bufWriteX, 0);
+        int32_t writeTop = std::max(bufWriteY, 0);
+        _lightBoundsLeft = std::min(_lightBoundsLeft, writeLeft);
+        _lightBoundsTop = std::min(_lightBoundsTop, writeTop);
+        _lightBoundsRight = std::max(_lightBoundsRight, std::min<int32_t>(writeLeft + bufWriteWidth, _pixelInfo.width));
+        _lightBoundsBottom = std::max(_lightBoundsBottom, std::min<int32_t>(writeTop + bufWriteHeight, _pixelInfo.height));
+
         bufReadSkip     = bufReadWidth - bufWriteWidth;
         bufWriteSkip    = _pixelInfo.width - bufWriteWidth;
 
@@ -969,6 +1022,64 @@ static uint8_t mix_light(uint32_t a, uint32_t b, uint32_t intensity)
     return result;
 }
 
+void lightfx_mix_row_scalar(uint32_t * RESTRICT dst, const uint8_t * RESTRICT src, const uint8_t * RESTRICT lightBits,
+                            uint32_t width, const uint32_t * palette, const uint32_t * lightPalette)
+{
+    for (uint32_t x = 0; x < width; x++) {
+        uint32_t darkColour = palette[src[x]];
+        uint32_t lightColour = lightPalette[src[x]];
+        uint8_t lightIntensity = lightBits[x];
+
+        uint32_t colour = 0;
+        if (lightIntensity == 0) {
+            colour = darkColour;
+        } else {
+            colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
+            colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
+            colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
+            colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
+        }
+        dst[x] = colour;
+    }
+}
+
+static void lightfx_convert_row(uint32_t * dst, const uint8_t * src, uint32_t width, const uint32_t * palette)
+{
+    for (uint32_t x = 0; x < width; x++) {
+        dst[x] = palette[src[x]];
+    }
+}
+
+static void lightfx_render_rows_to_texture(
+    void * dstPixels,
+    uint32_t dstPitch,
+    const uint8_t * bits,
+    const uint8_t * lightBits,
+    uint32_t width,
+    uint32_t top,
+    uint32_t bottom,
+    const uint32_t * palette,
+    const uint32_t * lightPalette)
+{
+    uint32_t litLeft = std::min<uint32_t>(_lightBoundsLeft, width);
+    uint32_t litRight = std::max<uint32_t>(litLeft, std::min<uint32_t>(_lightBoundsRight, width));
+
+    for (uint32_t y = top; y < bottom; y++) {
+        uint32_t * dst = (uint32_t *)((uintptr_t)dstPixels + (uintptr_t)(y * dstPitch));
+        const uint8_t * src = &bits[y * width];
+
+        // Pixels outside the lit area only need their dark colour
+        if ((int32_t)y < _lightBoundsTop || (int32_t)y >= _lightBoundsBottom) {
+            lightfx_convert_row(dst, src, width, palette);
+            continue;
+        }
+
+        lightfx_convert_row(dst, src, litLeft, palette);
+        _lightfxMixRowFn(dst + litLeft, src + litLeft, &lightBits[y * width + litLeft], litRight - litLeft, palette, lightPalette);
+        lightfx_convert_row(dst + litRight, src + litRight, width - litRight, palette);
+    }
+}
+
 void lightfx_render_to_texture(
     void * dstPixels,
     uint32_t dstPitch,
@@ -988,27 +1099,24 @@ void lightfx_render_to_texture(
         return;
     }
 
-    for (uint32_t y = 0; y < height; y++) {
-        uintptr_t dstOffset = (uintptr_t)(y * dstPitch);
-        uint32_t * dst = (uint32_t *)((uintptr_t)dstPixels + dstOffset);
-        for (uint32_t x = 0; x < width; x++) {
-            uint8_t * src = &bits[y * width + x];
-            uint32_t darkColour = palette[*src];
-            uint32_t lightColour = lightPalette[*src];
-            uint8_t lightIntensity = lightBits[y * width + x];
-
-            uint32_t colour = 0;
-            if (lightIntensity == 0) {
-                colour = darkColour;
-            } else {
-                colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
-                colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
-                colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
-                colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
-            }
-            *dst++ = colour;
-        }
+    uint32_t numBands = std::min<uint32_t>(std::thread::hardware_concurrency(), height / LIGHTFX_MIN_ROWS_PER_BAND);
+    if (numBands <= 1) {
+        lightfx_render_rows_to_texture(dstPixels, dstPitch, bits, lightBits, width, 0, height, palette, lightPalette);
+        return;
+    }
+
+    if (_lightfxJobPool == nullptr) {
+        _lightfxJobPool = std::make_unique<JobPool>();
+    }
+
+    uint32_t rowsPerBand = (height + numBands - 1) / numBands;
+    for (uint32_t top = 0; top < height; top += rowsPerBand) {
+        uint32_t bottom = std::min(height, top + rowsPerBand);
+        _lightfxJobPool->AddTask([=]() {
+            lightfx_render_rows_to_texture(dstPixels, dstPitch, bits, lightBits, width, top, bottom, palette, lightPalette);
+        });
     }
+    _lightfxJobPool->Join();
 }
 
 #endif // __ENABLE_LIGHTFX__
@@ -73,6 +73,13 @@ void lightfx_render_to_texture(
     const uint32_t * palette,
     const uint32_t * lightPalette);
 
+void lightfx_mix_row_scalar(uint32_t * RESTRICT dst, const uint8_t * RESTRICT src, const uint8_t * RESTRICT lightBits,
+                            uint32_t width, const uint32_t * palette, const uint32_t * lightPalette);
+void lightfx_mix_row_sse4_1(uint32_t * RESTRICT dst, const uint8_t * RESTRICT src, const uint8_t * RESTRICT lightBits,
+                            uint32_t width, const uint32_t * palette, const uint32_t * lightPalette);
+void lightfx_mix_row_avx2(uint32_t * RESTRICT dst, const uint8_t * RESTRICT src, const uint8_t * RESTRICT lightBits,
+                          uint32_t width, const uint32_t * palette, const uint32_t * lightPalette);
+
 #endif // __ENABLE_LIGHTFX__
 
 #endif
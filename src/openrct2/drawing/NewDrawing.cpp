@@ -156,6 +156,26 @@ void drawing_engine_set_vsync(bool vsync)
     }
 }
 
+const drawing_engine_stats * drawing_engine_get_stats()
+{
+    const drawing_engine_stats * result = nullptr;
+    auto drawingEngine = GetDrawingEngine();
+    if (drawingEngine != nullptr)
+    {
+        result = drawingEngine->GetStats();
+    }
+    return result;
+}
+
+void drawing_engine_reset_stats()
+{
+    auto drawingEngine = GetDrawingEngine();
+    if (drawingEngine != nullptr)
+    {
+        drawingEngine->ResetStats();
+    }
+}
+
 void gfx_set_dirty_blocks(int16_t left, int16_t top, int16_t right, int16_t bottom)
 {
     auto drawingEngine = GetDrawingEngine();
@@ -11,6 +11,7 @@
 
 #include "../common.h"
 
+struct drawing_engine_stats;
 struct rct_drawpixelinfo;
 struct rct_palette_entry;
 
@@ -28,3 +29,5 @@ rct_drawpixelinfo * drawing_engine_get_dpi();
 bool drawing_engine_has_dirty_optimisations();
 void drawing_engine_invalidate_image(uint32_t image);
 void drawing_engine_set_vsync(bool vsync);
+const drawing_engine_stats * drawing_engine_get_stats();
+void drawing_engine_reset_stats();
@@ -7,9 +7,11 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <cstring>
 #include "../common.h"
 #include "../core/Guard.hpp"
 #include "Drawing.h"
+#include "LightFX.h"
 
 #ifdef __SSE4_1__
 
@@ -55,6 +57,46 @@ void mask_sse4_1(int32_t width, int32_t height, const uint8_t * RESTRICT maskSrc
     }
 }
 
+#ifdef __ENABLE_LIGHTFX__
+
+void lightfx_mix_row_sse4_1(uint32_t * RESTRICT dst, const uint8_t * RESTRICT src, const uint8_t * RESTRICT lightBits,
+                            uint32_t width, const uint32_t * palette, const uint32_t * lightPalette)
+{
+    // Spreads the intensity of each pixel over its four 16-bit channels
+    const __m128i spreadLo = _mm_setr_epi8(0, -1, 0, -1, 0, -1, 0, -1, 1, -1, 1, -1, 1, -1, 1, -1);
+    const __m128i spreadHi = _mm_setr_epi8(2, -1, 2, -1, 2, -1, 2, -1, 3, -1, 3, -1, 3, -1, 3, -1);
+    const __m128i six = _mm_set1_epi16(6);
+
+    uint32_t x = 0;
+    for (; x + 4 <= width; x += 4) {
+        uint32_t intensities;
+        std::memcpy(&intensities, &lightBits[x], sizeof(intensities));
+        const __m128i dark = _mm_setr_epi32(palette[src[x]], palette[src[x + 1]], palette[src[x + 2]], palette[src[x + 3]]);
+        if (intensities == 0) {
+            _mm_storeu_si128((__m128i *)&dst[x], dark);
+            continue;
+        }
+
+        const __m128i light = _mm_setr_epi32(lightPalette[src[x]], lightPalette[src[x + 1]], lightPalette[src[x + 2]], lightPalette[src[x + 3]]);
+        const __m128i intensity = _mm_cvtsi32_si128((int32_t)intensities);
+
+        const __m128i darkLo = _mm_cvtepu8_epi16(dark);
+        const __m128i darkHi = _mm_cvtepu8_epi16(_mm_srli_si128(dark, 8));
+        const __m128i lightLo = _mm_slli_epi16(_mm_cvtepu8_epi16(light), 8);
+        const __m128i lightHi = _mm_slli_epi16(_mm_cvtepu8_epi16(_mm_srli_si128(light, 8)), 8);
+        const __m128i intensityLo = _mm_mullo_epi16(_mm_shuffle_epi8(intensity, spreadLo), six);
+        const __m128i intensityHi = _mm_mullo_epi16(_mm_shuffle_epi8(intensity, spreadHi), six);
+
+        // (light << 8) * (intensity * 6) >> 16 is the same as light * intensity * 6 >> 8
+        const __m128i mixedLo = _mm_add_epi16(darkLo, _mm_mulhi_epu16(lightLo, intensityLo));
+        const __m128i mixedHi = _mm_add_epi16(darkHi, _mm_mulhi_epu16(lightHi, intensityHi));
+        _mm_storeu_si128((__m128i *)&dst[x], _mm_packus_epi16(mixedLo, mixedHi));
+    }
+    lightfx_mix_row_scalar(dst + x, src + x, lightBits + x, width - x, palette, lightPalette);
+}
+
+#endif // __ENABLE_LIGHTFX__
+
 #else
 
 #ifdef OPENRCT2_X86
@@ -67,4 +109,14 @@ void mask_sse4_1(int32_t width, int32_t height, const uint8_t * RESTRICT maskSrc
     openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+#ifdef __ENABLE_LIGHTFX__
+
+void lightfx_mix_row_sse4_1(uint32_t * RESTRICT dst, const uint8_t * RESTRICT src, const uint8_t * RESTRICT lightBits,
+                            uint32_t width, const uint32_t * palette, const uint32_t * lightPalette)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+#endif // __ENABLE_LIGHTFX__
+
 #endif // __SSE4_1__
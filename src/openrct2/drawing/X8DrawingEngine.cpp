@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include "../config/Config.h"
 #include "../Context.h"
@@ -23,6 +24,7 @@
 #include "../interface/Viewport.h"
 #include "../interface/Window.h"
 #include "../Intro.h"
+#include "../Profiling.h"
 #include "Drawing.h"
 #include "LightFX.h"
 
@@ -215,14 +217,26 @@ void X8DrawingEngine::EndDraw()
 
 void X8DrawingEngine::PaintWindows()
 {
+    PROFILE_SCOPE("X8DrawingEngine::PaintWindows");
     window_reset_visibilities();
 
+    auto startTime = std::chrono::high_resolution_clock::now();
+    _stats.last_rects = 0;
+    _stats.last_pixels = 0;
+
     // Redraw dirty regions before updating the viewports, otherwise
     // when viewports get panned, they copy dirty pixels
     DrawAllDirtyBlocks();
     window_update_all_viewports();
     DrawAllDirtyBlocks();
 
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - startTime;
+    _stats.frames++;
+    _stats.last_milliseconds = duration.count();
+    _stats.total_rects += _stats.last_rects;
+    _stats.total_pixels += _stats.last_pixels;
+    _stats.total_milliseconds += _stats.last_milliseconds;
+
     // TODO move this out from drawing
     window_update_all();
 }
@@ -297,6 +311,16 @@ void X8DrawingEngine::InvalidateImage([[maybe_unused]] uint32_t image)
     // Not applicable for this engine
 }
 
+const drawing_engine_stats * X8DrawingEngine::GetStats()
+{
+    return &_stats;
+}
+
+void X8DrawingEngine::ResetStats()
+{
+    _stats = {};
+}
+
 rct_drawpixelinfo * X8DrawingEngine::GetDPI()
 {
     return &_bitsDPI;
@@ -381,15 +405,18 @@ void X8DrawingEngine::ConfigureDirtyGrid()
 
 void X8DrawingEngine::DrawAllDirtyBlocks()
 {
+    PROFILE_SCOPE("X8DrawingEngine::DrawAllDirtyBlocks");
     uint32_t  dirtyBlockColumns = _dirtyGrid.BlockColumns;
     uint32_t  dirtyBlockRows = _dirtyGrid.BlockRows;
     uint8_t * dirtyBlocks = _dirtyGrid.Blocks;
 
-    for (uint32_t x = 0; x < dirtyBlockColumns; x++)
+    // Scan row by row so that a run of dirty blocks, which are usually wider than they are tall,
+    // is drawn as one rectangle along with any rows below it that are dirty across the same span
+    for (uint32_t y = 0; y < dirtyBlockRows; y++)
     {
-        for (uint32_t y = 0; y < dirtyBlockRows; y++)
+        uint32_t yOffset = y * dirtyBlockColumns;
+        for (uint32_t x = 0; x < dirtyBlockColumns; x++)
         {
-            uint32_t yOffset = y * dirtyBlockColumns;
             if (dirtyBlocks[yOffset + x] == 0)
             {
                 continue;
@@ -408,21 +435,18 @@ void X8DrawingEngine::DrawAllDirtyBlocks()
 
             // Check rows
             uint32_t yy;
-            for (yy = y; yy < dirtyBlockRows; yy++)
+            for (yy = y + 1; yy < dirtyBlockRows; yy++)
             {
-                uint32_t yyOffset = yy * dirtyBlockColumns;
-                for (xx = x; xx < x + columns; xx++)
+                const uint8_t * row = &dirtyBlocks[yy * dirtyBlockColumns + x];
+                if (std::find(row, row + columns, 0) != row + columns)
                 {
-                    if (dirtyBlocks[yyOffset + xx] == 0)
-                    {
-                        goto endRowCheck;
-                    }
+                    break;
                 }
             }
-
-        endRowCheck:
             uint32_t rows = yy - y;
+
             DrawDirtyBlocks(x, y, columns, rows);
+            x = xx;
         }
     }
 }
@@ -452,6 +476,9 @@ void X8DrawingEngine::DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns,
         return;
     }
 
+    _stats.last_rects++;
+    _stats.last_pixels += (right - left) * (bottom - top);
+
     // Draw region
     OnDrawDirtyBlock(x, y, columns, rows);
     window_draw_all(&_bitsDPI, left, top, right, bottom);
@@ -73,6 +73,7 @@ namespace OpenRCT2
             uint8_t * _bits       = nullptr;
 
             DirtyGrid   _dirtyGrid  = {};
+            drawing_engine_stats _stats = {};
 
             rct_drawpixelinfo _bitsDPI  = {};
 
@@ -102,6 +103,8 @@ namespace OpenRCT2
             rct_drawpixelinfo * GetDrawingPixelInfo() override;
             DRAWING_ENGINE_FLAGS GetFlags() override;
             void InvalidateImage(uint32_t image) override;
+            const drawing_engine_stats * GetStats() override;
+            void ResetStats() override;
 
             rct_drawpixelinfo * GetDPI();
 
@@ -21,8 +21,11 @@
 #include "../core/String.hpp"
 #include "../drawing/Drawing.h"
 #include "../drawing/Font.h"
+#include "../drawing/IDrawingEngine.h"
+#include "../drawing/NewDrawing.h"
 #include "../EditorObjectSelectionSession.h"
 #include "../Game.h"
+#include "../Journal.h"
 #include "../interface/Colour.h"
 #include "../localisation/Localisation.h"
 #include "../localisation/User.h"
@@ -35,6 +38,7 @@
 #include "../object/ObjectRepository.h"
 #include "../OpenRCT2.h"
 #include "../peep/Staff.h"
+#include "../Profiling.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
 #include "../util/Util.h"
@@ -952,7 +956,7 @@ static int32_t cc_show_limits(InteractiveConsole & console, [[maybe_unused]] con
         }
     }
 
-    console.WriteFormatLine("Sprites: %d/%d", spriteCount, MAX_SPRITES);
+    console.WriteFormatLine("Sprites: %d/%d", spriteCount, (int32_t)sprite_get_capacity());
     console.WriteFormatLine("Map Elements: %d/%d", tileElementCount, MAX_TILE_ELEMENTS);
     console.WriteFormatLine("Banners: %d/%d", bannerCount, MAX_BANNERS);
     console.WriteFormatLine("Rides: %d/%d", rideCount, MAX_RIDES);
@@ -1017,6 +1021,117 @@ static int32_t
     return 1;
 }
 
+static int32_t cc_draw_stats(InteractiveConsole &console, const utf8 **argv, int32_t argc)
+{
+    if (argc > 0 && strcmp(argv[0], "reset") == 0)
+    {
+        window_reset_draw_stats();
+        drawing_engine_reset_stats();
+        return 0;
+    }
+
+    const drawing_engine_stats * engineStats = drawing_engine_get_stats();
+    if (engineStats != nullptr && engineStats->frames != 0)
+    {
+        console.WriteFormatLine("Last frame: %u rects, %llu pixels redrawn in %.2f ms",
+            engineStats->last_rects, (unsigned long long)engineStats->last_pixels, engineStats->last_milliseconds);
+        console.WriteFormatLine("Average over %u frames: %.1f rects, %.0f pixels redrawn in %.2f ms",
+            engineStats->frames,
+            (double)engineStats->total_rects / engineStats->frames,
+            (double)engineStats->total_pixels / engineStats->frames,
+            engineStats->total_milliseconds / engineStats->frames);
+    }
+
+    const window_draw_stats * stats = window_get_draw_stats();
+    console.WriteFormatLine("Window paint calls: %llu", (unsigned long long)stats->paint_calls);
+    console.WriteFormatLine("Pixels painted: %llu", (unsigned long long)stats->pixels_painted);
+    console.WriteFormatLine("Pixels shown: %llu", (unsigned long long)stats->pixels_shown);
+    if (stats->pixels_shown != 0)
+    {
+        console.WriteFormatLine("Overdraw: %.2fx", (double)stats->pixels_painted / stats->pixels_shown);
+    }
+    return 0;
+}
+
+static int32_t cc_journal(InteractiveConsole &console, const utf8 **argv, int32_t argc)
+{
+    if (argc == 2 && strcmp(argv[0], "start") == 0)
+    {
+        if (!journal_start(argv[1]))
+        {
+            console.WriteLineError("Unable to start the journal.");
+            return 1;
+        }
+        console.WriteFormatLine("Recording journal to %s", argv[1]);
+    }
+    else if (argc == 1 && strcmp(argv[0], "stop") == 0)
+    {
+        journal_stop();
+    }
+    else if (argc == 0)
+    {
+        console.WriteLine(journal_is_recording() ? "Recording journal." : "Not recording journal.");
+    }
+    else
+    {
+        console.WriteLineError("Usage: journal [start <path> | stop]");
+        return 1;
+    }
+    return 0;
+}
+
+static int32_t cc_profile(InteractiveConsole &console, const utf8 **argv, int32_t argc)
+{
+    if (argc == 1 && strcmp(argv[0], "start") == 0)
+    {
+        profiling_start();
+        console.WriteLine("Profiling started.");
+    }
+    else if (argc == 1 && strcmp(argv[0], "stop") == 0)
+    {
+        profiling_stop();
+        console.WriteFormatLine("Profiling stopped, %llu scopes recorded.", (unsigned long long)profiling_get_event_count());
+    }
+    else if (argc == 1 && strcmp(argv[0], "report") == 0)
+    {
+        auto report = profiling_get_report();
+        if (report.empty())
+        {
+            console.WriteLine("Nothing has been profiled.");
+            return 0;
+        }
+
+        console.WriteFormatLine("%-40s %8s %10s %8s %8s %8s %8s %8s",
+            "Scope", "Calls", "Total ms", "Mean", "p50", "p95", "p99", "Max");
+        for (const auto &entry : report)
+        {
+            auto name = std::string(entry.depth * 2, ' ') + entry.name;
+            console.WriteFormatLine("%-40s %8llu %10.2f %8.3f %8.3f %8.3f %8.3f %8.3f",
+                name.c_str(), (unsigned long long)entry.calls, entry.total_milliseconds, entry.mean_milliseconds,
+                entry.p50_milliseconds, entry.p95_milliseconds, entry.p99_milliseconds, entry.max_milliseconds);
+        }
+    }
+    else if (argc == 2 && strcmp(argv[0], "trace") == 0)
+    {
+        if (!profiling_write_trace(argv[1]))
+        {
+            console.WriteLineError("Unable to write the trace.");
+            return 1;
+        }
+        console.WriteFormatLine("Trace written to %s", argv[1]);
+    }
+    else if (argc == 0)
+    {
+        console.WriteLine(profiling_is_running() ? "Profiling." : "Not profiling.");
+    }
+    else
+    {
+        console.WriteLineError("Usage: profile [start | stop | report | trace <path>]");
+        return 1;
+    }
+    return 0;
+}
+
 using console_command_func = int32_t (*)(InteractiveConsole &console, const utf8 ** argv, int32_t argc);
 struct console_command {
     const utf8 * command;
@@ -1099,7 +1214,10 @@ static constexpr const console_command console_command_table[] = {
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.", "remove_unused_objects" },
     { "remove_park_fences", cc_remove_park_fences, "Removes all park fences from the surface", "remove_park_fences"},
     { "show_limits", cc_show_limits, "Shows the map data counts and limits.", "show_limits" },
-    { "date", cc_for_date, "Sets the date to a given date.", "Format <year>[ <month>[ <day>]]."}
+    { "date", cc_for_date, "Sets the date to a given date.", "Format <year>[ <month>[ <day>]]."},
+    { "draw_stats", cc_draw_stats, "Shows how much of the screen was redrawn and how many pixels windows painted to do it.", "draw_stats [reset]" },
+    { "journal", cc_journal, "Records every game command to a file that can be replayed with 'openrct2 replay'.", "journal [start <path> | stop]" },
+    { "profile", cc_profile, "Times the game loop. 'report' lists each timed scope and 'trace' writes a Chrome trace file.", "profile [start | stop | report | trace <path>]" }
 };
 // clang-format on
 
@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <memory>
@@ -19,6 +20,8 @@
 #include "Screenshot.h"
 
 #include "../drawing/Drawing.h"
+#include "../drawing/IDrawingEngine.h"
+#include "../drawing/NewDrawing.h"
 #include "../Game.h"
 #include "../Intro.h"
 #include "../localisation/Localisation.h"
@@ -28,9 +31,12 @@
 #include "../world/Map.h"
 #include "../world/Park.h"
 #include "../world/Surface.h"
+#include "../world/Sprite.h"
 #include "Viewport.h"
+#include "Window_internal.h"
 
 using namespace OpenRCT2;
+using namespace OpenRCT2::Drawing;
 
 uint8_t gScreenshotCountdown = 0;
 
@@ -302,6 +308,72 @@ void screenshot_giant()
     context_show_error(STR_SCREENSHOT_SAVED_AS, STR_NONE);
 }
 
+static void benchgfx_window_paint(rct_window * w, rct_drawpixelinfo * dpi)
+{
+    window_draw_viewport(dpi, w);
+}
+
+/**
+ * Draws frames through the drawing engine with a main view of the park, redrawing every sprite each frame as
+ * if all of them moved, and reports how much of the screen the engine redrew.
+ */
+static void benchgfx_redraw_sprites(IDrawingEngine * drawingEngine, int32_t width, int32_t height, int32_t centreX, int32_t centreY, int32_t centreZ, uint32_t iterationCount)
+{
+    static rct_window_event_list events = {};
+    events.paint = benchgfx_window_paint;
+
+    auto mainWindow = std::make_unique<rct_window>();
+    rct_window * w = mainWindow.get();
+    w->width = width;
+    w->height = height;
+    w->flags = WF_STICK_TO_BACK;
+    w->classification = WC_MAIN_WINDOW;
+    w->event_handlers = &events;
+    w->viewport_smart_follow_sprite = SPRITE_INDEX_NULL;
+    viewport_create(w, 0, 0, width, height, 0, centreX, centreY, centreZ, VIEWPORT_FOCUS_TYPE_COORDINATE, SPRITE_INDEX_NULL);
+    rct_viewport * viewport = w->viewport;
+    if (viewport == nullptr)
+    {
+        return;
+    }
+    g_window_list.push_back(std::move(mainWindow));
+
+    drawingEngine->Resize(width, height);
+    drawingEngine->Invalidate(0, 0, width, height);
+    drawingEngine->BeginDraw();
+    drawingEngine->PaintWindows();
+    drawingEngine->EndDraw();
+    drawingEngine->ResetStats();
+
+    for (uint32_t i = 0; i < iterationCount; i++)
+    {
+        for (size_t spriteIndex = 0; spriteIndex < sprite_get_capacity(); spriteIndex++)
+        {
+            const rct_sprite * sprite = get_sprite(spriteIndex);
+            if (sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL && sprite->unknown.sprite_left != LOCATION_NULL)
+            {
+                viewport_invalidate(viewport, sprite->unknown.sprite_left, sprite->unknown.sprite_top, sprite->unknown.sprite_right, sprite->unknown.sprite_bottom);
+            }
+        }
+        drawingEngine->BeginDraw();
+        drawingEngine->PaintWindows();
+        drawingEngine->EndDraw();
+    }
+
+    const drawing_engine_stats * stats = drawingEngine->GetStats();
+    if (stats->frames != 0)
+    {
+        Console::WriteLine("Redrawing the sprites of %u frames at %dx%d: %.1f rects, %.0f pixels redrawn in %.2f ms per frame.",
+            stats->frames, width, height,
+            (double)stats->total_rects / stats->frames,
+            (double)stats->total_pixels / stats->frames,
+            stats->total_milliseconds / stats->frames);
+    }
+
+    viewport->width = 0;
+    g_window_list.pop_back();
+}
+
 static void benchgfx_render_screenshots(const char *inputPath, std::unique_ptr<IContext>& context, uint32_t iterationCount)
 {
     if (!context->LoadParkFromFile(inputPath))
@@ -370,6 +442,13 @@ static void benchgfx_render_screenshots(const char *inputPath, std::unique_ptr<I
         duration.count());
 
     free(dpi.bits);
+
+    // The frame damage statistics only come from engines that draw dirty blocks
+    IDrawingEngine * drawingEngine = context->GetDrawingEngine();
+    if (drawingEngine != nullptr && drawingEngine->GetStats() != nullptr)
+    {
+        benchgfx_redraw_sprites(drawingEngine, std::min(resolutionWidth, 1920), std::min(resolutionHeight, 1080), customX, customY, z, iterationCount);
+    }
 }
 
 int32_t cmdline_for_gfxbench(const char **argv, int32_t argc)
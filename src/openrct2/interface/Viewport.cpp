@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <vector>
 
 #include "../config/Config.h"
 #include "../Context.h"
@@ -19,6 +20,7 @@
 #include "../OpenRCT2.h"
 #include "../paint/Paint.h"
 #include "../peep/Staff.h"
+#include "../Profiling.h"
 #include "../ride/Ride.h"
 #include "../ride/TrackDesign.h"
 #include "../world/Climate.h"
@@ -61,6 +63,18 @@ static int16_t _interactionMapX;
 static int16_t _interactionMapY;
 static uint16_t _unk9AC154;
 
+struct viewport_invalidation
+{
+    int32_t left;
+    int32_t top;
+    int32_t right;
+    int32_t bottom;
+    int32_t max_zoom;
+};
+
+constexpr size_t MAX_PENDING_INVALIDATIONS = 16384;
+static std::vector<viewport_invalidation> _pendingInvalidations;
+
 static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32_t viewFlags);
 static void viewport_paint_weather_gloom(rct_drawpixelinfo * dpi);
 
@@ -82,6 +96,7 @@ void viewport_init_all()
     for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++) {
         g_viewport_list[i].width = 0;
     }
+    _pendingInvalidations.clear();
 
     // ?
     input_reset_flags();
@@ -808,6 +823,7 @@ void viewport_render(rct_drawpixelinfo *dpi, rct_viewport *viewport, int32_t lef
  */
 void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t right, int16_t bottom)
 {
+    PROFILE_SCOPE("viewport_paint");
     uint32_t viewFlags = viewport->flags;
     uint16_t width = right - left;
     uint16_t height = bottom - top;
@@ -1538,9 +1554,9 @@ void get_map_coordinates_from_pos_window(rct_window * window, int32_t screenX, i
 }
 
 /**
- * Left, top, right and bottom represent 2D map coordinates at zoom 0.
+ * Returns whether the given viewport is covered by other windows and therefore needs no invalidation.
  */
-void viewport_invalidate(rct_viewport *viewport, int32_t left, int32_t top, int32_t right, int32_t bottom)
+static bool viewport_is_covered(rct_viewport *viewport)
 {
     // if unknown viewport visibility, use the containing window to discover the status
     if (viewport->visibility == VC_UNKNOWN)
@@ -1552,13 +1568,15 @@ void viewport_invalidate(rct_viewport *viewport, int32_t left, int32_t top, int3
             // note, window_is_visible will update viewport->visibility, so this should have a low hit count
             if (!window_is_visible(owner))
             {
-                return;
+                return true;
             }
         }
     }
+    return viewport->visibility == VC_COVERED;
+}
 
-    if (viewport->visibility == VC_COVERED) return;
-
+static void viewport_set_dirty_blocks(rct_viewport *viewport, int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
     int32_t viewportLeft = viewport->view_x;
     int32_t viewportTop = viewport->view_y;
     int32_t viewportRight = viewport->view_x + viewport->view_width;
@@ -1586,6 +1604,91 @@ void viewport_invalidate(rct_viewport *viewport, int32_t left, int32_t top, int3
     }
 }
 
+/**
+ * Left, top, right and bottom represent 2D map coordinates at zoom 0.
+ */
+void viewport_invalidate(rct_viewport *viewport, int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
+    if (viewport_is_covered(viewport)) return;
+
+    viewport_set_dirty_blocks(viewport, left, top, right, bottom);
+}
+
+/**
+ * Queues an area, in 2D map coordinates at zoom 0, to be invalidated on every viewport whose zoom is
+ * not greater than maxZoom. The queue is projected onto the viewports by viewports_flush_invalidations.
+ */
+void viewports_invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom, int32_t maxZoom)
+{
+    if (gOpenRCT2Headless) return;
+
+    if (maxZoom == -1)
+    {
+        maxZoom = MAX_ZOOM_LEVEL;
+    }
+
+    // Moving sprites invalidate their old and new bounds one after the other, so merge an area into the
+    // previous one whenever the union does not cover more than both of them separately.
+    if (!_pendingInvalidations.empty())
+    {
+        viewport_invalidation &last = _pendingInvalidations.back();
+        if (last.max_zoom == maxZoom)
+        {
+            int32_t unionLeft = std::min(last.left, left);
+            int32_t unionTop = std::min(last.top, top);
+            int32_t unionRight = std::max(last.right, right);
+            int32_t unionBottom = std::max(last.bottom, bottom);
+            int64_t unionArea = (int64_t)(unionRight - unionLeft) * (unionBottom - unionTop);
+            int64_t lastArea = (int64_t)(last.right - last.left) * (last.bottom - last.top);
+            int64_t area = (int64_t)(right - left) * (bottom - top);
+            if (unionArea <= lastArea + area)
+            {
+                last = { unionLeft, unionTop, unionRight, unionBottom, maxZoom };
+                return;
+            }
+        }
+    }
+
+    // Nothing gets drawn while the game window is minimised, so do not let the queue grow without bound
+    if (_pendingInvalidations.size() >= MAX_PENDING_INVALIDATIONS)
+    {
+        viewports_flush_invalidations();
+    }
+    _pendingInvalidations.push_back({ left, top, right, bottom, maxZoom });
+}
+
+/**
+ * Sets the dirty blocks for all queued invalidations. Must be called before the dirty blocks are drawn.
+ */
+void viewports_flush_invalidations()
+{
+    if (_pendingInvalidations.empty()) return;
+
+    rct_viewport *viewports[MAX_VIEWPORT_COUNT];
+    size_t numViewports = 0;
+    for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++)
+    {
+        rct_viewport *viewport = &g_viewport_list[i];
+        if (viewport->width != 0 && !viewport_is_covered(viewport))
+        {
+            viewports[numViewports++] = viewport;
+        }
+    }
+
+    for (const auto &invalidation : _pendingInvalidations)
+    {
+        for (size_t i = 0; i < numViewports; i++)
+        {
+            rct_viewport *viewport = viewports[i];
+            if (viewport->zoom <= invalidation.max_zoom)
+            {
+                viewport_set_dirty_blocks(viewport, invalidation.left, invalidation.top, invalidation.right, invalidation.bottom);
+            }
+        }
+    }
+    _pendingInvalidations.clear();
+}
+
 static rct_viewport *viewport_find_from_point(int32_t screenX, int32_t screenY)
 {
     rct_window *w = window_find_from_point(screenX, screenY);
@@ -154,6 +154,8 @@ void sub_68B2B7(paint_session * session, int32_t x, int32_t y);
 void sub_68862C(rct_drawpixelinfo * dpi, paint_struct * ps);
 
 void viewport_invalidate(rct_viewport *viewport, int32_t left, int32_t top, int32_t right, int32_t bottom);
+void viewports_invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom, int32_t maxZoom = -1);
+void viewports_flush_invalidations();
 
 void screen_get_map_xy(int32_t screenX, int32_t screenY, int16_t *x, int16_t *y, rct_viewport **viewport);
 void screen_get_map_xy_with_z(int16_t screenX, int16_t screenY, int16_t z, int16_t *mapX, int16_t *mapY);
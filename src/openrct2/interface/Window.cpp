@@ -73,7 +73,18 @@ static constexpr const float window_scroll_locations[][2] = {
     {0.125f,    0.125f},
 };
 
-static int32_t window_draw_split(rct_drawpixelinfo *dpi, rct_window *w, int32_t left, int32_t top, int32_t right, int32_t bottom);
+struct window_rect
+{
+    int32_t left, top, right, bottom;
+};
+
+// Scratch space for window_draw, reused to avoid allocating on every draw
+static std::vector<window_rect> _visibleRects;
+static std::vector<window_rect> _splitRects;
+
+static window_draw_stats _drawStats;
+
+static bool window_get_visible_rects(rct_window *w, const window_rect& region);
 static void window_draw_single(rct_drawpixelinfo *dpi, rct_window *w, int32_t left, int32_t top, int32_t right, int32_t bottom);
 
 size_t window_get_index(const rct_window* w)
@@ -1097,10 +1108,6 @@ void window_draw(rct_drawpixelinfo *dpi, rct_window *w, int32_t left, int32_t to
 {
     if (!window_is_visible(w)) return;
 
-    // Split window into only the regions that require drawing
-    if (window_draw_split(dpi, w, left, top, right, bottom))
-        return;
-
     // Clamp region
     left = std::max<int32_t>(left, w->x);
     top = std::max<int32_t>(top, w->y);
@@ -1109,65 +1116,127 @@ void window_draw(rct_drawpixelinfo *dpi, rct_window *w, int32_t left, int32_t to
     if (left >= right) return;
     if (top >= bottom) return;
 
-    // Draw the window in this region
-    for (size_t i = window_get_index(w); i < g_window_list.size(); i++)
+    // Only draw the regions that are not hidden by opaque windows above
+    if (!window_get_visible_rects(w, { left, top, right, bottom }))
+        return;
+
+    for (const auto& rect : _visibleRects)
+    {
+        // Draw the window in this region
+        for (size_t i = window_get_index(w); i < g_window_list.size(); i++)
+        {
+            // Don't draw overlapping opaque windows, they won't have changed
+            auto v = g_window_list[i].get();
+            if ((w == v || (v->flags & WF_TRANSPARENT)) && window_is_visible(v))
+            {
+                window_draw_single(dpi, v, rect.left, rect.top, rect.right, rect.bottom);
+            }
+        }
+    }
+}
+
+/**
+ * Removes the area of hole from each rectangle in rects, splitting rectangles that are only
+ * partly covered into up to four pieces.
+ */
+static void window_subtract_rect(std::vector<window_rect>& rects, const window_rect& hole)
+{
+    _splitRects.clear();
+    for (const auto& r : rects)
     {
-        // Don't draw overlapping opaque windows, they won't have changed
-        auto v = g_window_list[i].get();
-        if ((w == v || (v->flags & WF_TRANSPARENT)) && window_is_visible(v))
+        if (hole.left >= r.right || hole.top >= r.bottom || hole.right <= r.left || hole.bottom <= r.top)
         {
-            window_draw_single(dpi, v, left, top, right, bottom);
+            _splitRects.push_back(r);
+            continue;
         }
+
+        if (hole.top > r.top)
+            _splitRects.push_back({ r.left, r.top, r.right, hole.top });
+        if (hole.bottom < r.bottom)
+            _splitRects.push_back({ r.left, hole.bottom, r.right, r.bottom });
+
+        int32_t top = std::max(r.top, hole.top);
+        int32_t bottom = std::min(r.bottom, hole.bottom);
+        if (hole.left > r.left)
+            _splitRects.push_back({ r.left, top, hole.left, bottom });
+        if (hole.right < r.right)
+            _splitRects.push_back({ hole.right, top, r.right, bottom });
     }
+    rects.swap(_splitRects);
 }
 
 /**
- * Splits a drawing of a window into regions that can be seen and are not hidden
- * by other opaque overlapping windows.
+ * Joins rectangles that share a full edge so that each window is painted as few times as possible.
  */
-static int32_t window_draw_split(rct_drawpixelinfo *dpi, rct_window *w, int32_t left, int32_t top, int32_t right, int32_t bottom)
+static void window_merge_rects(std::vector<window_rect>& rects)
 {
-    // Divide the draws up for only the visible regions of the window recursively
+    bool merged;
+    do
+    {
+        merged = false;
+        for (size_t i = 0; i < rects.size() && !merged; i++)
+        {
+            for (size_t j = i + 1; j < rects.size(); j++)
+            {
+                auto& a = rects[i];
+                const auto& b = rects[j];
+                if (a.left == b.left && a.right == b.right && (a.bottom == b.top || b.bottom == a.top))
+                {
+                    a.top = std::min(a.top, b.top);
+                    a.bottom = std::max(a.bottom, b.bottom);
+                }
+                else if (a.top == b.top && a.bottom == b.bottom && (a.right == b.left || b.right == a.left))
+                {
+                    a.left = std::min(a.left, b.left);
+                    a.right = std::max(a.right, b.right);
+                }
+                else
+                {
+                    continue;
+                }
+                rects.erase(rects.begin() + j);
+                merged = true;
+                break;
+            }
+        }
+    }
+    while (merged);
+}
+
+/**
+ * Fills _visibleRects with the parts of region that are not covered by an opaque window above w.
+ * @returns false if none of the region can be seen.
+ */
+static bool window_get_visible_rects(rct_window *w, const window_rect& region)
+{
+    _visibleRects.clear();
+    _visibleRects.push_back(region);
+
     for (auto i = window_get_index(w) + 1; i < g_window_list.size(); i++)
     {
-        // Check if this window overlaps w
         auto topwindow = g_window_list[i].get();
-        if (topwindow->x >= right || topwindow->y >= bottom)
-            continue;
-        if (topwindow->x + topwindow->width <= left || topwindow->y + topwindow->height <= top)
-            continue;
         if (topwindow->flags & WF_TRANSPARENT)
             continue;
 
-        // A window overlaps w, split up the draw into two regions where the window starts to overlap
-        if (topwindow->x > left) {
-            // Split draw at topwindow.left
-            window_draw(dpi, w, left, top, topwindow->x, bottom);
-            window_draw(dpi, w, topwindow->x, top, right, bottom);
-        } else if (topwindow->x + topwindow->width < right) {
-            // Split draw at topwindow.right
-            window_draw(dpi, w, left, top, topwindow->x + topwindow->width, bottom);
-            window_draw(dpi, w, topwindow->x + topwindow->width, top, right, bottom);
-        } else if (topwindow->y > top) {
-            // Split draw at topwindow.top
-            window_draw(dpi, w, left, top, right, topwindow->y);
-            window_draw(dpi, w, left, topwindow->y, right, bottom);
-        } else if (topwindow->y + topwindow->height < bottom) {
-            // Split draw at topwindow.bottom
-            window_draw(dpi, w, left, top, right, topwindow->y + topwindow->height);
-            window_draw(dpi, w, left, topwindow->y + topwindow->height, right, bottom);
-        }
-
-        // Drawing for this region should be done now, exit
-        return 1;
+        window_subtract_rect(_visibleRects, { topwindow->x, topwindow->y, topwindow->x + topwindow->width, topwindow->y + topwindow->height });
+        if (_visibleRects.empty())
+            return false;
     }
 
-    // No windows overlap
-    return 0;
+    window_merge_rects(_visibleRects);
+    return true;
 }
 
 static void window_draw_single(rct_drawpixelinfo *dpi, rct_window *w, int32_t left, int32_t top, int32_t right, int32_t bottom)
 {
+    // Transparent windows above are drawn over the whole region, crop it to the window itself
+    left = std::max<int32_t>(left, w->x);
+    top = std::max<int32_t>(top, w->y);
+    right = std::min<int32_t>(right, w->x + w->width);
+    bottom = std::min<int32_t>(bottom, w->y + w->height);
+    if (left >= right || top >= bottom)
+        return;
+
     // Copy dpi so we can crop it
     rct_drawpixelinfo copy = *dpi;
     dpi = &copy;
@@ -1210,6 +1279,9 @@ static void window_draw_single(rct_drawpixelinfo *dpi, rct_window *w, int32_t le
             return;
     }
 
+    _drawStats.paint_calls++;
+    _drawStats.pixels_painted += dpi->width * dpi->height;
+
     // Invalidate modifies the window colours so first get the correct
     // colour before setting the global variables for the string painting
     window_event_invalidate_call(w);
@@ -2040,6 +2112,8 @@ void window_draw_all(rct_drawpixelinfo *dpi, int16_t left, int16_t top, int16_t
     windowDPI.pitch = dpi->width + dpi->pitch + left - right;
     windowDPI.zoom_level = 0;
 
+    _drawStats.pixels_shown += (right - left) * (bottom - top);
+
     for (auto& w : g_window_list)
     {
         if (w->flags & WF_TRANSPARENT) continue;
@@ -2050,6 +2124,16 @@ void window_draw_all(rct_drawpixelinfo *dpi, int16_t left, int16_t top, int16_t
     }
 }
 
+const window_draw_stats * window_get_draw_stats()
+{
+    return &_drawStats;
+}
+
+void window_reset_draw_stats()
+{
+    _drawStats = {};
+}
+
 rct_viewport * window_get_previous_viewport(rct_viewport * current)
 {
     bool foundPrevious = (current == nullptr);
@@ -2091,7 +2175,7 @@ void window_init_all()
 
 void window_follow_sprite(rct_window * w, size_t spriteIndex)
 {
-    if (spriteIndex < MAX_SPRITES || spriteIndex == SPRITE_INDEX_NULL)
+    if (spriteIndex < sprite_get_capacity() || spriteIndex == SPRITE_INDEX_NULL)
     {
         w->viewport_smart_follow_sprite = (uint16_t)spriteIndex;
     }
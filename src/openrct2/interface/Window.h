@@ -226,6 +226,15 @@ struct error_variables {
     uint16_t var_480;
 };
 
+/**
+ * Counts how much window painting is done compared to the area of the screen that was redrawn.
+ */
+struct window_draw_stats {
+    uint64_t paint_calls;
+    uint64_t pixels_painted;
+    uint64_t pixels_shown;
+};
+
 struct rct_window;
 
 #define RCT_WINDOW_RIGHT(w) ((w)->x + (w)->width)
@@ -593,6 +602,8 @@ void main_window_zoom(bool zoomIn, bool atCursor);
 void window_show_textinput(rct_window *w, rct_widgetindex widgetIndex, uint16_t title, uint16_t text, int32_t value);
 
 void window_draw_all(rct_drawpixelinfo *dpi, int16_t left, int16_t top, int16_t right, int16_t bottom);
+const window_draw_stats * window_get_draw_stats();
+void window_reset_draw_stats();
 void window_draw(rct_drawpixelinfo *dpi, rct_window *w, int32_t left, int32_t top, int32_t right, int32_t bottom);
 void window_draw_widgets(rct_window *w, rct_drawpixelinfo *dpi);
 void window_draw_viewport(rct_drawpixelinfo *dpi, rct_window *w);
@@ -8,7 +8,11 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "../common.h"
@@ -17,6 +21,7 @@
 #include "../core/FileStream.hpp"
 #include "../core/Math.hpp"
 #include "../core/Memory.hpp"
+#include "../core/MemoryMappedFile.h"
 #include "../core/String.hpp"
 #include "../core/StringBuilder.hpp"
 #include "../core/StringReader.hpp"
@@ -33,6 +38,45 @@ constexpr int32_t           ObjectOverrideMaxStringCount   = 3;
 constexpr rct_string_id ScenarioOverrideBase           = 0x7000;
 constexpr int32_t           ScenarioOverrideMaxStringCount = 3;
 
+// Compiled language packs contain format codes as bytes, so the version needs to be increased when they change
+constexpr uint32_t COMPILED_LANGUAGE_MAGIC_NUMBER = 0x4B50474C; // LGPK
+constexpr uint16_t COMPILED_LANGUAGE_VERSION = 1;
+constexpr uint32_t COMPILED_LANGUAGE_NO_STRING = 0xFFFFFFFF;
+
+#pragma pack(push, 1)
+/**
+ * Header of a compiled language pack. It is followed by the offset of every string, the object overrides, the
+ * scenario overrides and finally the null terminated strings that the offsets refer to. A missing or empty string
+ * has the offset COMPILED_LANGUAGE_NO_STRING.
+ */
+struct CompiledLanguageHeader
+{
+    uint32_t MagicNumber;
+    uint16_t Version;
+    uint16_t HeaderSize;
+    uint64_t SourceHash;
+    uint32_t NumStrings;
+    uint32_t NumObjectOverrides;
+    uint32_t NumScenarioOverrides;
+    uint32_t StringDataSize;
+};
+assert_struct_size(CompiledLanguageHeader, 32);
+
+struct CompiledObjectOverride
+{
+    char     Name[8];
+    uint32_t Strings[ObjectOverrideMaxStringCount];
+};
+assert_struct_size(CompiledObjectOverride, 20);
+
+struct CompiledScenarioOverride
+{
+    uint32_t Filename;
+    uint32_t Strings[ScenarioOverrideMaxStringCount];
+};
+assert_struct_size(CompiledScenarioOverride, 16);
+#pragma pack(pop)
+
 struct ObjectOverride
 {
     char        name[8] = { 0 };
@@ -45,10 +89,26 @@ struct ScenarioOverride
     std::string strings[ScenarioOverrideMaxStringCount];
 };
 
-class LanguagePack final : public ILanguagePack
+/**
+ * 64-bit FNV-1a hash of the language file, used to tell whether a compiled language pack is out of date.
+ */
+static uint64_t GetLanguageSourceHash(const utf8 * text, size_t length)
+{
+    uint64_t hash = 0xCBF29CE484222325;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (uint8_t)text[i];
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
+
+/**
+ * Parses the text of a language file and compiles it into the binary form that LanguagePack uses.
+ */
+class LanguagePackCompiler
 {
 private:
-    uint16_t const _id;
     std::vector<std::string>      _strings;
     std::vector<ObjectOverride>   _objectOverrides;
     std::vector<ScenarioOverride> _scenarioOverrides;
@@ -61,47 +121,7 @@ private:
     ScenarioOverride * _currentScenarioOverride = nullptr;
 
 public:
-    static LanguagePack * FromFile(uint16_t id, const utf8 * path)
-    {
-        Guard::ArgumentNotNull(path);
-
-        // Load file directly into memory
-        utf8 * fileData = nullptr;
-        try
-        {
-            FileStream fs = FileStream(path, FILE_MODE_OPEN);
-
-            size_t fileLength = (size_t)fs.GetLength();
-            if (fileLength > MAX_LANGUAGE_SIZE)
-            {
-                throw IOException("Language file too large.");
-            }
-
-            fileData = Memory::Allocate<utf8>(fileLength + 1);
-            fs.Read(fileData, fileLength);
-            fileData[fileLength] = '\0';
-        }
-        catch (const std::exception &ex)
-        {
-            Memory::Free(fileData);
-            log_error("Unable to open %s: %s", path, ex.what());
-            return nullptr;
-        }
-
-        // Parse the memory as text
-        LanguagePack * result = FromText(id, fileData);
-
-        Memory::Free(fileData);
-        return result;
-    }
-
-    static LanguagePack * FromText(uint16_t id, const utf8 * text)
-    {
-        return new LanguagePack(id, text);
-    }
-
-    LanguagePack(uint16_t id, const utf8 * text)
-        : _id(id)
+    explicit LanguagePackCompiler(const utf8 * text)
     {
         Guard::ArgumentNotNull(text);
 
@@ -110,126 +130,77 @@ public:
         {
             ParseLine(&reader);
         }
-
-        // Clean up the parsing work data
-        _currentGroup = std::string();
-        _currentObjectOverride = nullptr;
-        _currentScenarioOverride = nullptr;
-    }
-
-    uint16_t GetId() const override
-    {
-        return _id;
     }
 
-    uint32_t GetCount() const override
-    {
-        return (uint32_t)_strings.size();
-    }
-
-    void RemoveString(rct_string_id stringId) override
+    std::vector<uint8_t> Compile(uint64_t sourceHash) const
     {
-        if (_strings.size() >= (size_t)stringId)
+        std::string stringData;
+        auto addString = [&stringData](const std::string &str) -> uint32_t
         {
-            _strings[stringId] = std::string();
-        }
-    }
-
-    void SetString(rct_string_id stringId, const std::string &str) override
-    {
-        if (_strings.size() >= (size_t)stringId)
-        {
-            _strings[stringId] = str;
-        }
-    }
-
-    const utf8 * GetString(rct_string_id stringId) const override
-    {
-        if (stringId >= ScenarioOverrideBase)
-        {
-            int32_t offset = stringId - ScenarioOverrideBase;
-            int32_t ooIndex = offset / ScenarioOverrideMaxStringCount;
-            int32_t ooStringIndex = offset % ScenarioOverrideMaxStringCount;
-
-            if (_scenarioOverrides.size() > (size_t)ooIndex && !_scenarioOverrides[ooIndex].strings[ooStringIndex].empty())
+            if (str.empty())
             {
-                return _scenarioOverrides[ooIndex].strings[ooStringIndex].c_str();
-            }
-            else
-            {
-                return nullptr;
+                return COMPILED_LANGUAGE_NO_STRING;
             }
-        }
-        else if (stringId >= ObjectOverrideBase)
-        {
-            int32_t offset = stringId - ObjectOverrideBase;
-            int32_t ooIndex = offset / ObjectOverrideMaxStringCount;
-            int32_t ooStringIndex = offset % ObjectOverrideMaxStringCount;
+            auto offset = (uint32_t)stringData.size();
+            stringData.append(str.c_str(), str.size() + 1);
+            return offset;
+        };
 
-            if (_objectOverrides.size() > (size_t)ooIndex && !_objectOverrides[ooIndex].strings[ooStringIndex].empty())
-            {
-                return _objectOverrides[ooIndex].strings[ooStringIndex].c_str();
-            }
-            else
-            {
-                return nullptr;
-            }
-        }
-        else
+        std::vector<uint32_t> stringOffsets;
+        stringOffsets.reserve(_strings.size());
+        for (const auto &str : _strings)
         {
-            if ((_strings.size() > (size_t)stringId) && !_strings[stringId].empty())
-            {
-                return _strings[stringId].c_str();
-            }
-            else
-            {
-                return nullptr;
-            }
+            stringOffsets.push_back(addString(str));
         }
-    }
 
-    rct_string_id GetObjectOverrideStringId(const char * objectIdentifier, uint8_t index) override
-    {
-        Guard::ArgumentNotNull(objectIdentifier);
-        Guard::Assert(index < ObjectOverrideMaxStringCount);
-
-        int32_t ooIndex = 0;
-        for (const ObjectOverride &objectOverride : _objectOverrides)
+        std::vector<CompiledObjectOverride> objectOverrides;
+        for (const auto &oo : _objectOverrides)
         {
-            if (strncmp(objectOverride.name, objectIdentifier, 8) == 0)
+            CompiledObjectOverride compiled;
+            std::copy_n(oo.name, sizeof(compiled.Name), compiled.Name);
+            for (int32_t i = 0; i < ObjectOverrideMaxStringCount; i++)
             {
-                if (objectOverride.strings[index].empty())
-                {
-                    return STR_NONE;
-                }
-                return ObjectOverrideBase + (ooIndex * ObjectOverrideMaxStringCount) + index;
+                compiled.Strings[i] = addString(oo.strings[i]);
             }
-            ooIndex++;
+            objectOverrides.push_back(compiled);
         }
 
-        return STR_NONE;
-    }
-
-    rct_string_id GetScenarioOverrideStringId(const utf8 * scenarioFilename, uint8_t index) override
-    {
-        Guard::ArgumentNotNull(scenarioFilename);
-        Guard::Assert(index < ScenarioOverrideMaxStringCount);
-
-        int32_t ooIndex = 0;
-        for (const ScenarioOverride &scenarioOverride : _scenarioOverrides)
+        std::vector<CompiledScenarioOverride> scenarioOverrides;
+        for (const auto &so : _scenarioOverrides)
         {
-            if (String::Equals(scenarioOverride.filename.c_str(), scenarioFilename, true))
+            CompiledScenarioOverride compiled;
+            // The file name is always needed to look the override up, even if it is empty
+            compiled.Filename = (uint32_t)stringData.size();
+            stringData.append(so.filename.c_str(), so.filename.size() + 1);
+            for (int32_t i = 0; i < ScenarioOverrideMaxStringCount; i++)
             {
-                if (scenarioOverride.strings[index].empty())
-                {
-                    return STR_NONE;
-                }
-                return ScenarioOverrideBase + (ooIndex * ScenarioOverrideMaxStringCount) + index;
+                compiled.Strings[i] = addString(so.strings[i]);
             }
-            ooIndex++;
+            scenarioOverrides.push_back(compiled);
         }
 
-        return STR_NONE;
+        CompiledLanguageHeader header;
+        header.MagicNumber = COMPILED_LANGUAGE_MAGIC_NUMBER;
+        header.Version = COMPILED_LANGUAGE_VERSION;
+        header.HeaderSize = sizeof(CompiledLanguageHeader);
+        header.SourceHash = sourceHash;
+        header.NumStrings = (uint32_t)stringOffsets.size();
+        header.NumObjectOverrides = (uint32_t)objectOverrides.size();
+        header.NumScenarioOverrides = (uint32_t)scenarioOverrides.size();
+        header.StringDataSize = (uint32_t)stringData.size();
+
+        std::vector<uint8_t> data;
+        auto append = [&data](const void * src, size_t length)
+        {
+            auto src8 = (const uint8_t *)src;
+            data.insert(data.end(), src8, src8 + length);
+        };
+        append(&header, sizeof(header));
+        append(stringOffsets.data(), stringOffsets.size() * sizeof(uint32_t));
+        append(objectOverrides.data(), objectOverrides.size() * sizeof(CompiledObjectOverride));
+        append(scenarioOverrides.data(), scenarioOverrides.size() * sizeof(CompiledScenarioOverride));
+        append(stringData.data(), stringData.size());
+        return data;
     }
 
 private:
@@ -604,11 +575,363 @@ private:
     }
 };
 
+/**
+ * A language pack that reads its strings straight out of a compiled string table, either loaded from the cache or
+ * produced by LanguagePackCompiler.
+ */
+class LanguagePack final : public ILanguagePack
+{
+private:
+    struct ObjectOverrideStrings
+    {
+        const char * name;
+        const utf8 * strings[ObjectOverrideMaxStringCount];
+    };
+
+    struct ScenarioOverrideStrings
+    {
+        const utf8 * filename;
+        const utf8 * strings[ScenarioOverrideMaxStringCount];
+    };
+
+    uint16_t const _id;
+    // The compiled string table, either owned or mapped straight from the cache
+    std::vector<uint8_t> const _data;
+    std::unique_ptr<MemoryMappedFile> const _mappedFile;
+    std::vector<const utf8 *>            _strings;
+    std::vector<ObjectOverrideStrings>   _objectOverrides;
+    std::vector<ScenarioOverrideStrings> _scenarioOverrides;
+    // Strings that have been replaced by SetString
+    std::unordered_map<rct_string_id, std::string> _replacedStrings;
+
+public:
+    static LanguagePack * FromFile(uint16_t id, const utf8 * path, const utf8 * cachePath)
+    {
+        Guard::ArgumentNotNull(path);
+
+        // Load file directly into memory
+        utf8 * fileData = nullptr;
+        size_t fileLength = 0;
+        try
+        {
+            FileStream fs = FileStream(path, FILE_MODE_OPEN);
+
+            fileLength = (size_t)fs.GetLength();
+            if (fileLength > MAX_LANGUAGE_SIZE)
+            {
+                throw IOException("Language file too large.");
+            }
+
+            fileData = Memory::Allocate<utf8>(fileLength + 1);
+            fs.Read(fileData, fileLength);
+            fileData[fileLength] = '\0';
+        }
+        catch (const std::exception &ex)
+        {
+            Memory::Free(fileData);
+            log_error("Unable to open %s: %s", path, ex.what());
+            return nullptr;
+        }
+
+        uint64_t sourceHash = GetLanguageSourceHash(fileData, fileLength);
+        LanguagePack * result = nullptr;
+        if (cachePath != nullptr)
+        {
+            result = FromCache(id, cachePath, sourceHash);
+        }
+        if (result == nullptr)
+        {
+            // Parse the memory as text
+            auto data = LanguagePackCompiler(fileData).Compile(sourceHash);
+            if (cachePath != nullptr)
+            {
+                WriteCache(cachePath, data);
+            }
+            result = new LanguagePack(id, std::move(data));
+        }
+
+        Memory::Free(fileData);
+        return result;
+    }
+
+    static LanguagePack * FromText(uint16_t id, const utf8 * text)
+    {
+        auto data = LanguagePackCompiler(text).Compile(GetLanguageSourceHash(text, strlen(text)));
+        return new LanguagePack(id, std::move(data));
+    }
+
+    /**
+     * Takes ownership of compiled language data that has been checked with IsValid.
+     */
+    LanguagePack(uint16_t id, std::vector<uint8_t>&& data)
+        : _id(id),
+          _data(std::move(data))
+    {
+        SetStringTable(_data.data());
+    }
+
+    /**
+     * Takes ownership of a mapped compiled language pack that has been checked with IsValid.
+     */
+    LanguagePack(uint16_t id, std::unique_ptr<MemoryMappedFile>&& mappedFile)
+        : _id(id),
+          _mappedFile(std::move(mappedFile))
+    {
+        SetStringTable(_mappedFile->GetData());
+    }
+
+private:
+    void SetStringTable(const uint8_t * data)
+    {
+        auto header = (const CompiledLanguageHeader *)data;
+        auto stringOffsets = (const uint32_t *)(header + 1);
+        auto objectOverrides = (const CompiledObjectOverride *)(stringOffsets + header->NumStrings);
+        auto scenarioOverrides = (const CompiledScenarioOverride *)(objectOverrides + header->NumObjectOverrides);
+        auto stringData = (const utf8 *)(scenarioOverrides + header->NumScenarioOverrides);
+
+        auto getString = [stringData](uint32_t offset) -> const utf8 *
+        {
+            return offset == COMPILED_LANGUAGE_NO_STRING ? nullptr : stringData + offset;
+        };
+
+        _strings.resize(header->NumStrings);
+        for (uint32_t i = 0; i < header->NumStrings; i++)
+        {
+            _strings[i] = getString(stringOffsets[i]);
+        }
+
+        _objectOverrides.resize(header->NumObjectOverrides);
+        for (uint32_t i = 0; i < header->NumObjectOverrides; i++)
+        {
+            _objectOverrides[i].name = objectOverrides[i].Name;
+            for (int32_t j = 0; j < ObjectOverrideMaxStringCount; j++)
+            {
+                _objectOverrides[i].strings[j] = getString(objectOverrides[i].Strings[j]);
+            }
+        }
+
+        _scenarioOverrides.resize(header->NumScenarioOverrides);
+        for (uint32_t i = 0; i < header->NumScenarioOverrides; i++)
+        {
+            _scenarioOverrides[i].filename = getString(scenarioOverrides[i].Filename);
+            for (int32_t j = 0; j < ScenarioOverrideMaxStringCount; j++)
+            {
+                _scenarioOverrides[i].strings[j] = getString(scenarioOverrides[i].Strings[j]);
+            }
+        }
+    }
+
+public:
+    uint16_t GetId() const override
+    {
+        return _id;
+    }
+
+    uint32_t GetCount() const override
+    {
+        return (uint32_t)_strings.size();
+    }
+
+    void RemoveString(rct_string_id stringId) override
+    {
+        if (_strings.size() > (size_t)stringId)
+        {
+            _strings[stringId] = nullptr;
+            _replacedStrings.erase(stringId);
+        }
+    }
+
+    void SetString(rct_string_id stringId, const std::string &str) override
+    {
+        if (_strings.size() > (size_t)stringId)
+        {
+            // Elements of an unordered_map are never moved, so the pointer stays valid until the string is replaced
+            auto &replacedString = _replacedStrings[stringId];
+            replacedString = str;
+            _strings[stringId] = replacedString.empty() ? nullptr : replacedString.c_str();
+        }
+    }
+
+    const utf8 * GetString(rct_string_id stringId) const override
+    {
+        if (stringId >= ScenarioOverrideBase)
+        {
+            int32_t offset = stringId - ScenarioOverrideBase;
+            int32_t ooIndex = offset / ScenarioOverrideMaxStringCount;
+            int32_t ooStringIndex = offset % ScenarioOverrideMaxStringCount;
+
+            if (_scenarioOverrides.size() > (size_t)ooIndex)
+            {
+                return _scenarioOverrides[ooIndex].strings[ooStringIndex];
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+        else if (stringId >= ObjectOverrideBase)
+        {
+            int32_t offset = stringId - ObjectOverrideBase;
+            int32_t ooIndex = offset / ObjectOverrideMaxStringCount;
+            int32_t ooStringIndex = offset % ObjectOverrideMaxStringCount;
+
+            if (_objectOverrides.size() > (size_t)ooIndex)
+            {
+                return _objectOverrides[ooIndex].strings[ooStringIndex];
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+        else
+        {
+            if (_strings.size() > (size_t)stringId)
+            {
+                return _strings[stringId];
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+    }
+
+    rct_string_id GetObjectOverrideStringId(const char * objectIdentifier, uint8_t index) override
+    {
+        Guard::ArgumentNotNull(objectIdentifier);
+        Guard::Assert(index < ObjectOverrideMaxStringCount);
+
+        int32_t ooIndex = 0;
+        for (const auto &objectOverride : _objectOverrides)
+        {
+            if (strncmp(objectOverride.name, objectIdentifier, 8) == 0)
+            {
+                if (objectOverride.strings[index] == nullptr)
+                {
+                    return STR_NONE;
+                }
+                return ObjectOverrideBase + (ooIndex * ObjectOverrideMaxStringCount) + index;
+            }
+            ooIndex++;
+        }
+
+        return STR_NONE;
+    }
+
+    rct_string_id GetScenarioOverrideStringId(const utf8 * scenarioFilename, uint8_t index) override
+    {
+        Guard::ArgumentNotNull(scenarioFilename);
+        Guard::Assert(index < ScenarioOverrideMaxStringCount);
+
+        int32_t ooIndex = 0;
+        for (const auto &scenarioOverride : _scenarioOverrides)
+        {
+            if (String::Equals(scenarioOverride.filename, scenarioFilename, true))
+            {
+                if (scenarioOverride.strings[index] == nullptr)
+                {
+                    return STR_NONE;
+                }
+                return ScenarioOverrideBase + (ooIndex * ScenarioOverrideMaxStringCount) + index;
+            }
+            ooIndex++;
+        }
+
+        return STR_NONE;
+    }
+
+    /**
+     * Checks that the data is a compiled language pack of the source with the given hash and that every offset in it
+     * refers to a null terminated string within the data.
+     */
+    static bool IsValid(const uint8_t * data, size_t length, uint64_t sourceHash)
+    {
+        if (length < sizeof(CompiledLanguageHeader))
+        {
+            return false;
+        }
+
+        auto header = (const CompiledLanguageHeader *)data;
+        if (header->MagicNumber != COMPILED_LANGUAGE_MAGIC_NUMBER ||
+            header->Version != COMPILED_LANGUAGE_VERSION ||
+            header->HeaderSize != sizeof(CompiledLanguageHeader) ||
+            header->SourceHash != sourceHash)
+        {
+            return false;
+        }
+
+        uint64_t tablesSize =
+            (uint64_t)header->NumStrings * sizeof(uint32_t) +
+            (uint64_t)header->NumObjectOverrides * sizeof(CompiledObjectOverride) +
+            (uint64_t)header->NumScenarioOverrides * sizeof(CompiledScenarioOverride);
+        if (sizeof(CompiledLanguageHeader) + tablesSize + header->StringDataSize != length)
+        {
+            return false;
+        }
+        if (header->StringDataSize != 0 && data[length - 1] != '\0')
+        {
+            return false;
+        }
+
+        // The tables are all made of offsets apart from the object names, so they can be checked as one
+        auto offsets = (const uint32_t *)(header + 1);
+        size_t numOffsets = (size_t)(tablesSize / sizeof(uint32_t));
+        size_t objectOverridesStart = header->NumStrings;
+        size_t objectOverridesEnd = objectOverridesStart + header->NumObjectOverrides * (sizeof(CompiledObjectOverride) / sizeof(uint32_t));
+        for (size_t i = 0; i < numOffsets; i++)
+        {
+            bool isObjectName = i >= objectOverridesStart && i < objectOverridesEnd &&
+                ((i - objectOverridesStart) % (sizeof(CompiledObjectOverride) / sizeof(uint32_t))) < 2;
+            if (!isObjectName && offsets[i] != COMPILED_LANGUAGE_NO_STRING && offsets[i] >= header->StringDataSize)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static LanguagePack * FromCache(uint16_t id, const utf8 * cachePath, uint64_t sourceHash)
+    {
+        try
+        {
+            // The strings are read straight out of the mapping, so only the pages that are used get loaded
+            auto mappedFile = std::make_unique<MemoryMappedFile>(cachePath);
+            if (IsValid(mappedFile->GetData(), mappedFile->GetLength(), sourceHash))
+            {
+                return new LanguagePack(id, std::move(mappedFile));
+            }
+            log_verbose("Compiled language pack %s is out of date", cachePath);
+        }
+        catch (const std::exception &)
+        {
+            log_verbose("Unable to read compiled language pack %s", cachePath);
+        }
+        return nullptr;
+    }
+
+    static void WriteCache(const utf8 * cachePath, const std::vector<uint8_t> &data)
+    {
+        try
+        {
+            // An older pack may still have the cache mapped, so it is unlinked rather than truncated beneath it
+            std::remove(cachePath);
+            auto fs = FileStream(cachePath, FILE_MODE_WRITE);
+            fs.Write(data.data(), data.size());
+        }
+        catch (const std::exception &ex)
+        {
+            log_warning("Unable to write compiled language pack %s: %s", cachePath, ex.what());
+        }
+    }
+};
+
 namespace LanguagePackFactory
 {
-    ILanguagePack * FromFile(uint16_t id, const utf8 * path)
+    ILanguagePack * FromFile(uint16_t id, const utf8 * path, const utf8 * cachePath)
     {
-        auto languagePack = LanguagePack::FromFile(id, path);
+        auto languagePack = LanguagePack::FromFile(id, path, cachePath);
         return languagePack;
     }
 
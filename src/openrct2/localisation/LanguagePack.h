@@ -28,6 +28,10 @@ interface ILanguagePack
 
 namespace LanguagePackFactory
 {
-    ILanguagePack * FromFile(uint16_t id, const utf8 * path);
+    /**
+     * Loads the language file at the given path. If a cache path is given, the compiled string table stored there is
+     * used when it was built from the same file, otherwise it is written there for next time.
+     */
+    ILanguagePack * FromFile(uint16_t id, const utf8 * path, const utf8 * cachePath = nullptr);
     ILanguagePack * FromText(uint16_t id, const utf8 * text);
 }
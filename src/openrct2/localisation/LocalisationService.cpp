@@ -71,6 +71,22 @@ std::string LocalisationService::GetLanguagePath(uint32_t languageId) const
     return languagePath;
 }
 
+std::string LocalisationService::GetLanguageCachePath(uint32_t languageId) const
+{
+    auto locale = std::string(LanguagesDescriptors[languageId].locale);
+    auto cacheDirectory = _env->GetDirectoryPath(DIRBASE::CACHE);
+    auto cachePath = Path::Combine(cacheDirectory, "language_" + locale + ".dat");
+    return cachePath;
+}
+
+ILanguagePack * LocalisationService::LoadLanguagePack(uint32_t languageId) const
+{
+    auto path = GetLanguagePath(languageId);
+    auto cachePath = GetLanguageCachePath(languageId);
+    Path::CreateDirectory(Path::GetDirectory(cachePath));
+    return LanguagePackFactory::FromFile(languageId, path.c_str(), cachePath.c_str());
+}
+
 void LocalisationService::OpenLanguage(int32_t id, IObjectManager& objectManager)
 {
     CloseLanguages();
@@ -79,15 +95,12 @@ void LocalisationService::OpenLanguage(int32_t id, IObjectManager& objectManager
         throw std::invalid_argument("id was undefined");
     }
 
-    std::string filename;
     if (id != LANGUAGE_ENGLISH_UK)
     {
-        filename = GetLanguagePath(LANGUAGE_ENGLISH_UK);
-        _languageFallback = std::unique_ptr<ILanguagePack>(LanguagePackFactory::FromFile(LANGUAGE_ENGLISH_UK, filename.c_str()));
+        _languageFallback = std::unique_ptr<ILanguagePack>(LoadLanguagePack(LANGUAGE_ENGLISH_UK));
     }
 
-    filename = GetLanguagePath(id);
-    _languageCurrent = std::unique_ptr<ILanguagePack>(LanguagePackFactory::FromFile(id, filename.c_str()));
+    _languageCurrent = std::unique_ptr<ILanguagePack>(LoadLanguagePack(id));
     if (_languageCurrent != nullptr)
     {
         _currentLanguage = id;
@@ -35,6 +35,8 @@ namespace OpenRCT2::Localisation
         std::unique_ptr<ILanguagePack> _languageCurrent;
         std::stack<rct_string_id> _availableObjectStringIds;
 
+        ILanguagePack * LoadLanguagePack(uint32_t languageId) const;
+
     public:
         int32_t GetCurrentLanguage() const { return _currentLanguage; }
         bool UseTrueTypeFont() const { return _useTrueTypeFont; }
@@ -47,6 +49,7 @@ namespace OpenRCT2::Localisation
         std::tuple<rct_string_id, rct_string_id, rct_string_id> GetLocalisedScenarioStrings(const std::string& scenarioFilename) const;
         rct_string_id GetObjectOverrideStringId(const char * identifier, uint8_t index) const;
         std::string GetLanguagePath(uint32_t languageId) const;
+        std::string GetLanguageCachePath(uint32_t languageId) const;
 
         void OpenLanguage(int32_t id, IObjectManager& objectManager);
         void CloseLanguages();
@@ -27,7 +27,7 @@
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "3"
+#define NETWORK_STREAM_VERSION "5"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static rct_peep* _pickup_peep = nullptr;
@@ -53,6 +53,7 @@ static int32_t _pickup_peep_old_x = LOCATION_NULL;
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
 #include "../ParkImporter.h"
+#include "../Profiling.h"
 #include "../rct2/S6Exporter.h"
 
 #include "../config/Config.h"
@@ -403,6 +404,7 @@ uint8_t Network::GetPlayerID()
 
 void Network::Update()
 {
+    PROFILE_SCOPE("Network::Update");
     _closeLock = true;
 
     switch (GetMode()) {
@@ -1439,32 +1441,36 @@ void Network::ProcessPacket(NetworkConnection& connection, NetworkPacket& packet
 
 void Network::ProcessGameCommandQueue()
 {
-    while (game_command_queue.begin() != game_command_queue.end()) {
+    while (!game_command_queue.empty()) {
 
         // run all the game commands at the current tick
-        const GameCommand& gc = (*game_command_queue.begin());
+        const GameCommand& next = game_command_queue.front();
 
         if (mode == NETWORK_MODE_CLIENT) {
 
-            if (game_command_queue.begin()->tick < gCurrentTicks) {
+            if (next.tick < gCurrentTicks) {
                 // Having old command from a tick where we have not been active yet or malicious server,
                 // the command is useless so lets not keep it.
-                game_command_queue.erase(game_command_queue.begin());
-
                 log_warning("Discarding game command from tick behind current tick, CMD: %08X, CMD Tick: %08X, Current Tick: %08X\n",
-                            gc.esi,
-                            gc.tick,
+                            next.esi,
+                            next.tick,
                             gCurrentTicks);
 
+                game_command_queue.pop_front();
+
                 // At this point we should not return, would add the possibility to skip commands this tick.
                 continue;
             }
 
             // exit the game command processing loop to still have a chance at finding desync.
-            if (game_command_queue.begin()->tick != gCurrentTicks)
+            if (next.tick != gCurrentTicks)
                 break;
         }
 
+        // Running the command can queue new ones, so take it off the queue first
+        GameCommand gc = std::move(game_command_queue.front());
+        game_command_queue.pop_front();
+
         if (gc.action != nullptr) {
 
             GameAction *action = gc.action.get();
@@ -1517,24 +1523,59 @@ void Network::ProcessGameCommandQueue()
                 }
             }
         }
-        game_command_queue.erase(game_command_queue.begin());
     }
 }
 
 void Network::EnqueueGameAction(const GameAction *action)
 {
-    MemoryStream stream;
-    DataSerialiser dsOut(true, stream);
-    action->Serialise(dsOut);
+    GameAction::Ptr ga = GameActions::Clone(action);
+    game_command_queue.emplace(GameCommand(gCurrentTicks, std::move(ga), _commandId++));
+}
 
-    std::unique_ptr<GameAction> ga = GameActions::Create(action->GetType());
-    ga->SetCallback(action->GetCallback());
+void Network::GameCommandQueue::emplace(GameCommand&& command)
+{
+    if (_count == _items.size())
+    {
+        grow();
+    }
 
-    stream.SetPosition(0);
-    DataSerialiser dsIn(false, stream);
-    ga->Serialise(dsIn);
+    // Shift later commands along until the new one is in order
+    size_t index = _count;
+    while (index > 0 && command < at(index - 1))
+    {
+        at(index) = std::move(at(index - 1));
+        index--;
+    }
+    at(index) = std::move(command);
+    _count++;
+}
 
-    game_command_queue.emplace(gCurrentTicks, std::move(ga), _commandId++);
+void Network::GameCommandQueue::pop_front()
+{
+    // Release the action now rather than when the slot is reused
+    _items[_head] = GameCommand();
+    _head = (_head + 1) % _items.size();
+    _count--;
+}
+
+void Network::GameCommandQueue::clear()
+{
+    while (!empty())
+    {
+        pop_front();
+    }
+    _head = 0;
+}
+
+void Network::GameCommandQueue::grow()
+{
+    std::vector<GameCommand> items(std::max<size_t>(64, _items.size() * 2));
+    for (size_t i = 0; i < _count; i++)
+    {
+        items[i] = std::move(at(i));
+    }
+    _items = std::move(items);
+    _head = 0;
 }
 
 void Network::AddClient(ITcpSocket * socket)
@@ -2173,7 +2214,7 @@ void Network::Client_Handle_GAMECMD([[maybe_unused]] NetworkConnection& connecti
     uint8_t callback;
     packet >> tick >> args[0] >> args[1] >> args[2] >> args[3] >> args[4] >> args[5] >> args[6] >> playerid >> callback;
 
-    game_command_queue.emplace(tick, args, playerid, callback, _commandId++);
+    game_command_queue.emplace(GameCommand(tick, args, playerid, callback, _commandId++));
 }
 
 void Network::Client_Handle_GAME_ACTION([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
@@ -2209,7 +2250,7 @@ void Network::Client_Handle_GAME_ACTION([[maybe_unused]] NetworkConnection& conn
         }
     }
 
-    game_command_queue.emplace(tick, std::move(action), _commandId++);
+    game_command_queue.emplace(GameCommand(tick, std::move(action), _commandId++));
 }
 
 void Network::Server_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet)
@@ -2282,7 +2323,7 @@ void Network::Server_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPa
     // Set player to sender, should be 0 if sent from client.
     ga->SetPlayer(connection.Player->Id);
 
-    game_command_queue.emplace(tick, std::move(ga), _commandId++);
+    game_command_queue.emplace(GameCommand(tick, std::move(ga), _commandId++));
 }
 
 void Network::Server_Handle_GAMECMD(NetworkConnection& connection, NetworkPacket& packet)
@@ -2345,7 +2386,7 @@ void Network::Server_Handle_GAMECMD(NetworkConnection& connection, NetworkPacket
         return;
     }
 
-    game_command_queue.emplace(tick, args, playerid, callback, _commandId++);
+    game_command_queue.emplace(GameCommand(tick, args, playerid, callback, _commandId++));
 }
 
 void Network::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
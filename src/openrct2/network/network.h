@@ -184,6 +184,7 @@ private:
 
     struct GameCommand
     {
+        GameCommand() = default;
         GameCommand(uint32_t t, uint32_t* args, uint8_t p, uint8_t cb, uint32_t id) {
             tick = t; eax = args[0]; ebx = args[1]; ecx = args[2]; edx = args[3];
             esi = args[4]; edi = args[5]; ebp = args[6]; playerid = p; callback = cb;
@@ -198,10 +199,6 @@ private:
             commandIndex = id;
         }
 
-        ~GameCommand()
-        {
-        }
-
         uint32_t tick = 0;
         uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0, esi = 0, edi = 0, ebp = 0;
         GameAction::Ptr action;
@@ -220,6 +217,29 @@ private:
         }
     };
 
+    /**
+     * Pending game commands ordered by tick and then by arrival. Stored in a ring buffer that is
+     * only ever grown, commands nearly always arrive in order so inserting is usually an append.
+     */
+    class GameCommandQueue
+    {
+    private:
+        std::vector<GameCommand> _items;
+        size_t _head = 0;
+        size_t _count = 0;
+
+    public:
+        bool empty() const { return _count == 0; }
+        GameCommand& front() { return _items[_head]; }
+        void emplace(GameCommand&& command);
+        void pop_front();
+        void clear();
+
+    private:
+        GameCommand& at(size_t index) { return _items[(_head + index) % _items.size()]; }
+        void grow();
+    };
+
     int32_t mode = NETWORK_MODE_NONE;
     int32_t status = NETWORK_STATUS_NONE;
     bool _closeLock = false;
@@ -237,7 +257,7 @@ private:
     std::string server_sprite_hash;
     uint8_t player_id = 0;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
-    std::multiset<GameCommand> game_command_queue;
+    GameCommandQueue game_command_queue;
     std::vector<uint8_t> chunk_buffer;
     std::string _password;
     bool _desynchronised = false;
@@ -11,6 +11,7 @@
 #include <memory>
 #include <stdexcept>
 #include "../core/IStream.hpp"
+#include "../core/SpanReader.hpp"
 #include "../OpenRCT2.h"
 #include "ImageTable.h"
 #include "Object.h"
@@ -56,20 +57,22 @@ void ImageTable::Read(IReadObjectContext * context, IStream * stream)
 
         // Read g1 element headers
         uintptr_t imageDataBase = (uintptr_t)data.get();
+        auto headerTable = SpanReader::FromStream(stream, (size_t)headerTableSize);
         std::vector<rct_g1_element> newEntries;
+        newEntries.reserve(numImages);
         for (uint32_t i = 0; i < numImages; i++)
         {
             rct_g1_element g1Element;
 
-            uintptr_t imageDataOffset = (uintptr_t)stream->ReadValue<uint32_t>();
+            uintptr_t imageDataOffset = (uintptr_t)headerTable.ReadValue<uint32_t>();
             g1Element.offset = (uint8_t*)(imageDataBase + imageDataOffset);
 
-            g1Element.width = stream->ReadValue<int16_t>();
-            g1Element.height = stream->ReadValue<int16_t>();
-            g1Element.x_offset = stream->ReadValue<int16_t>();
-            g1Element.y_offset = stream->ReadValue<int16_t>();
-            g1Element.flags = stream->ReadValue<uint16_t>();
-            g1Element.zoomed_offset = stream->ReadValue<uint16_t>();
+            g1Element.width = headerTable.ReadValue<int16_t>();
+            g1Element.height = headerTable.ReadValue<int16_t>();
+            g1Element.x_offset = headerTable.ReadValue<int16_t>();
+            g1Element.y_offset = headerTable.ReadValue<int16_t>();
+            g1Element.flags = headerTable.ReadValue<uint16_t>();
+            g1Element.zoomed_offset = headerTable.ReadValue<uint16_t>();
 
             newEntries.push_back(g1Element);
         }
@@ -18,9 +18,11 @@
 #include "../Game.h"
 #include "../interface/Chat.h"
 #include "../interface/InteractiveConsole.h"
+#include "../interface/Viewport.h"
 #include "../Intro.h"
 #include "../localisation/Language.h"
 #include "../localisation/FormatCodes.h"
+#include "../Profiling.h"
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
@@ -34,7 +36,9 @@ Painter::Painter(const std::shared_ptr<IUiContext>& uiContext)
 
 void Painter::Paint(IDrawingEngine& de)
 {
+    PROFILE_SCOPE("Painter::Paint");
     auto dpi = de.GetDrawingPixelInfo();
+    viewports_flush_invalidations();
     if (gIntroState != INTRO_STATE_NONE)
     {
         intro_draw(dpi);
@@ -22,6 +22,7 @@
 #include "../OpenRCT2.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../ride/RidePresence.h"
 #include "../ride/ShopItem.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
@@ -1612,26 +1613,8 @@ void rct_peep::PickRideToGoOn()
     else
     {
         // Take nearby rides into consideration
-        int32_t cx = floor2(x, 32);
-        int32_t cy = floor2(y, 32);
-        for (int32_t tileX = cx - 320; tileX <= cx + 320; tileX += 32)
-        {
-            for (int32_t tileY = cy - 320; tileY <= cy + 320; tileY += 32)
-            {
-                if (tileX >= 0 && tileY >= 0 && tileX < (256 * 32) && tileY < (256 * 32))
-                {
-                    rct_tile_element * tileElement = map_get_first_element_at(tileX >> 5, tileY >> 5);
-                    do
-                    {
-                        if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK)
-                            continue;
-
-                        int32_t rideIndex = track_element_get_ride_index(tileElement);
-                        rideConsideration[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
-                    } while (!(tileElement++)->IsLastForTile());
-                }
-            }
-        }
+        const uint32_t allRides[8] = { UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX };
+        ride_presence_get_nearby_rides(x >> 5, y >> 5, 10, allRides, rideConsideration);
 
         // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
         int32_t i;
@@ -2949,30 +2932,16 @@ static void peep_head_for_nearest_ride_type(rct_peep * peep, int32_t rideType)
     else
     {
         // Take nearby rides into consideration
-        int32_t cx = floor2(peep->x, 32);
-        int32_t cy = floor2(peep->y, 32);
-        for (int32_t x = cx - 320; x <= cx + 320; x += 32)
+        uint32_t candidateRides[8]{};
+        int32_t i;
+        FOR_ALL_RIDES(i, ride)
         {
-            for (int32_t y = cy - 320; y <= cy + 320; y += 32)
+            if (ride->type == rideType)
             {
-                if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32))
-                {
-                    rct_tile_element * tileElement = map_get_first_element_at(x >> 5, y >> 5);
-                    do
-                    {
-                        if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK)
-                            continue;
-
-                        int32_t rideIndex = track_element_get_ride_index(tileElement);
-                        ride             = get_ride(rideIndex);
-                        if (ride->type == rideType)
-                        {
-                            rideConsideration[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
-                        }
-                    } while (!(tileElement++)->IsLastForTile());
-                }
+                candidateRides[i >> 5] |= (1u << (i & 0x1F));
             }
         }
+        ride_presence_get_nearby_rides(peep->x >> 5, peep->y >> 5, 10, candidateRides, rideConsideration);
     }
 
     // Filter the considered rides
@@ -3078,30 +3047,16 @@ static void peep_head_for_nearest_ride_with_flags(rct_peep * peep, int32_t rideT
     else
     {
         // Take nearby rides into consideration
-        int32_t cx = floor2(peep->x, 32);
-        int32_t cy = floor2(peep->y, 32);
-        for (int32_t x = cx - 320; x <= cx + 320; x += 32)
+        uint32_t candidateRides[8]{};
+        int32_t i;
+        FOR_ALL_RIDES(i, ride)
         {
-            for (int32_t y = cy - 320; y <= cy + 320; y += 32)
+            if (ride_type_has_flag(ride->type, rideTypeFlags))
             {
-                if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32))
-                {
-                    rct_tile_element * tileElement = map_get_first_element_at(x >> 5, y >> 5);
-                    do
-                    {
-                        if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK)
-                            continue;
-
-                        int32_t rideIndex = track_element_get_ride_index(tileElement);
-                        ride             = get_ride(rideIndex);
-                        if (ride_type_has_flag(ride->type, rideTypeFlags))
-                        {
-                            rideConsideration[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
-                        }
-                    } while (!(tileElement++)->IsLastForTile());
-                }
+                candidateRides[i >> 5] |= (1u << (i & 0x1F));
             }
         }
+        ride_presence_get_nearby_rides(peep->x >> 5, peep->y >> 5, 10, candidateRides, rideConsideration);
     }
 
     // Filter the considered rides
@@ -26,6 +26,7 @@
 #include "../management/Marketing.h"
 #include "../management/NewsItem.h"
 #include "../network/network.h"
+#include "../Profiling.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../ride/Ride.h"
@@ -421,6 +422,7 @@ int32_t peep_get_staff_count()
  */
 void peep_update_all()
 {
+    PROFILE_SCOPE("peep_update_all");
     int32_t     i;
     uint16_t     spriteIndex;
     rct_peep * peep;
@@ -838,7 +840,7 @@ bool rct_peep::Place(TileCoordsXYZ location, bool apply)
 
 bool peep_pickup_command(uint32_t peepnum, int32_t x, int32_t y, int32_t z, int32_t action, bool apply)
 {
-    if (peepnum >= MAX_SPRITES)
+    if (peepnum >= sprite_get_capacity())
     {
         log_error("Failed to pick up peep for sprite %d", peepnum);
         return false;
@@ -1721,7 +1723,7 @@ static constexpr const uint8_t tshirt_colours[] = {
  */
 rct_peep * peep_generate(int32_t x, int32_t y, int32_t z)
 {
-    if (gSpriteListCount[SPRITE_LIST_NULL] < 400)
+    if (sprite_get_num_available() < 400)
         return nullptr;
 
     rct_peep * peep = (rct_peep *)create_sprite(1);
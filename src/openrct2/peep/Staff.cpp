@@ -175,7 +175,7 @@ static money32 staff_hire_new_staff_member(uint8_t staff_type, uint8_t flags, in
     gCommandPosition.y      = command_y;
     gCommandPosition.z      = command_z;
 
-    if (gSpriteListCount[SPRITE_LIST_NULL] < 400)
+    if (sprite_get_num_available() < 400)
     {
         gGameCommandErrorText = STR_TOO_MANY_PEOPLE_IN_GAME;
         return MONEY32_UNDEFINED;
@@ -407,7 +407,7 @@ void game_command_set_staff_order(
     gCommandExpenditureType = RCT_EXPENDITURE_TYPE_WAGES;
     uint8_t  order_id         = *ebx >> 8;
     uint16_t sprite_id        = *edx;
-    if (sprite_id >= MAX_SPRITES)
+    if (sprite_id >= sprite_get_capacity())
     {
         log_warning("Invalid game command, sprite_id = %u", sprite_id);
         *ebx = MONEY32_UNDEFINED;
@@ -466,7 +466,7 @@ void game_command_set_staff_patrol(
         int32_t x         = *eax;
         int32_t y         = *ecx;
         uint16_t sprite_id = *edx;
-        if (sprite_id >= MAX_SPRITES)
+        if (sprite_id >= sprite_get_capacity())
         {
             *ebx = MONEY32_UNDEFINED;
             log_warning("Invalid sprite id %u", sprite_id);
@@ -526,7 +526,7 @@ void game_command_fire_staff_member(
     {
         window_close_by_class(WC_FIRE_PROMPT);
         uint16_t sprite_id = *edx;
-        if (sprite_id >= MAX_SPRITES)
+        if (sprite_id >= sprite_get_capacity())
         {
             log_warning("Invalid game command, sprite_id = %u", sprite_id);
             *ebx = MONEY32_UNDEFINED;
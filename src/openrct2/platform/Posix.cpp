@@ -361,6 +361,12 @@ bool platform_file_move(const utf8 *srcPath, const utf8 *dstPath)
     return rename(srcPath, dstPath) == 0;
 }
 
+bool platform_file_replace(const utf8 *srcPath, const utf8 *dstPath)
+{
+    // rename replaces an existing destination atomically
+    return rename(srcPath, dstPath) == 0;
+}
+
 bool platform_file_delete(const utf8 *path)
 {
     int32_t ret = unlink(path);
@@ -185,6 +185,16 @@ bool platform_file_move(const utf8 *srcPath, const utf8 *dstPath)
     return success == TRUE;
 }
 
+bool platform_file_replace(const utf8 *srcPath, const utf8 *dstPath)
+{
+    wchar_t *wSrcPath = utf8_to_widechar(srcPath);
+    wchar_t *wDstPath = utf8_to_widechar(dstPath);
+    BOOL success = MoveFileExW(wSrcPath, wDstPath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+    free(wSrcPath);
+    free(wDstPath);
+    return success == TRUE;
+}
+
 bool platform_file_delete(const utf8 *path)
 {
     wchar_t *wPath = utf8_to_widechar(path);
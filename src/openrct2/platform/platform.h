@@ -95,6 +95,7 @@ int32_t platform_get_drives();
 
 bool platform_file_copy(const utf8 *srcPath, const utf8 *dstPath, bool overwrite);
 bool platform_file_move(const utf8 *srcPath, const utf8 *dstPath);
+bool platform_file_replace(const utf8 *srcPath, const utf8 *dstPath);
 bool platform_file_delete(const utf8 *path);
 uint32_t platform_get_ticks();
 void platform_sleep(uint32_t ms);
@@ -47,6 +47,7 @@
 #include "../peep/Staff.h"
 #include "RCT1.h"
 #include "../ride/RideData.h"
+#include "../ride/RidePresence.h"
 #include "../ride/Track.h"
 #include "../util/SawyerCoding.h"
 #include "../util/Util.h"
@@ -1320,7 +1321,7 @@ private:
                 ImportPeep(peep, srcPeep);
             }
         }
-        for (size_t i = 0; i < MAX_SPRITES; i++)
+        for (size_t i = 0; i < sprite_get_capacity(); i++)
         {
             rct_sprite * sprite = get_sprite(i);
             if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
@@ -2379,7 +2380,7 @@ private:
     void ClearExtraTileEntries()
     {
         // Reset the map tile pointers
-        std::fill(std::begin(gTileElementTilePointers), std::end(gTileElementTilePointers), nullptr);
+        std::fill_n(gTileElementTilePointers, MAX_TILE_TILE_ELEMENT_POINTERS, nullptr);
 
         // Get the first free map element
         rct_tile_element * nextFreeTileElement = gTileElements;
@@ -2431,6 +2432,9 @@ private:
         }
 
         gNextFreeTileElement = nextFreeTileElement;
+        map_rebuild_tile_element_index();
+        ride_presence_invalidate_all();
+        footpath_invalidate_all_wide_flags();
     }
 
     void FixSceneryColours()
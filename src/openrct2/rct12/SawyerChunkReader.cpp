@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include "../core/IStream.hpp"
+#include "../core/SpanReader.hpp"
 #include "SawyerChunkReader.h"
 
  // malloc is very slow for large allocations in MSVC debug builds as it allocates
@@ -66,14 +67,16 @@ std::shared_ptr<SawyerChunk> SawyerChunkReader::ReadChunk()
         case CHUNK_ENCODING_RLECOMPRESSED:
         case CHUNK_ENCODING_ROTATE:
         {
-            std::unique_ptr<uint8_t[]> compressedData(new uint8_t[header.length]);
-            if (_stream->TryRead(compressedData.get(), header.length) != header.length)
+            if (_stream->GetLength() - _stream->GetPosition() < header.length)
             {
                 throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
             }
 
+            // Decodes straight from the source when the stream is already in memory
+            auto compressedData = SpanReader::FromStream(_stream, header.length);
+
             auto buffer = (uint8_t *)AllocateLargeTempBuffer();
-            size_t uncompressedLength = DecodeChunk(buffer, MAX_UNCOMPRESSED_CHUNK_SIZE, compressedData.get(), header);
+            size_t uncompressedLength = DecodeChunk(buffer, MAX_UNCOMPRESSED_CHUNK_SIZE, compressedData.ReadView(header.length), header);
             Guard::Assert(uncompressedLength != 0, "Encountered zero-sized chunk!");
             buffer = (uint8_t *)FinaliseLargeTempBuffer(buffer, uncompressedLength);
             return std::make_shared<SawyerChunk>((SAWYER_ENCODING)header.encoding, buffer, uncompressedLength);
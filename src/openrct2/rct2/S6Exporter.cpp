@@ -9,13 +9,18 @@
 
 #include "S6Exporter.h"
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <functional>
+#include <future>
+#include <memory>
+#include <string>
 #include "../common.h"
 #include "../config/Config.h"
 #include "../Context.h"
 #include "../core/FileStream.hpp"
 #include "../core/IStream.hpp"
+#include "../core/MemoryStream.h"
 #include "../core/String.hpp"
 #include "../core/Util.hpp"
 #include "../Game.h"
@@ -34,6 +39,8 @@
 #include "../object/ObjectRepository.h"
 #include "../OpenRCT2.h"
 #include "../peep/Staff.h"
+#include "../platform/platform.h"
+#include "../Profiling.h"
 #include "../rct12/SawyerChunkWriter.h"
 #include "../ride/Ride.h"
 #include "../ride/RideRatings.h"
@@ -99,8 +106,7 @@ void S6Exporter::Save(IStream * stream, bool isScenario)
     // 2: Write packed objects
     if (_s6.header.num_packed_objects > 0)
     {
-        auto objRepo = OpenRCT2::GetContext()->GetObjectRepository();
-        objRepo->WritePackedObjects(stream, ExportObjectsList);
+        stream->Write(_packedObjects.data(), _packedObjects.size());
     }
 
     // 3: Write available objects chunk
@@ -130,6 +136,23 @@ void S6Exporter::Save(IStream * stream, bool isScenario)
         chunkWriter.WriteChunk(&_s6.next_free_tile_element_pointer_index, 0x2E8570, SAWYER_ENCODING::RLECOMPRESSED);
     }
 
+    // 7: Sprites beyond the RCT2 sprite limit, only written when the sprite list has grown.
+    //    RCT2 stops reading before this chunk, so the file stays loadable.
+    if (!_extendedSprites.empty())
+    {
+        _extendedSpritesHeader.num_sprites     = (uint32_t)_extendedSprites.size();
+        _extendedSpritesHeader.num_cut_sprites = (uint32_t)_cutSprites.size();
+        _extendedSpritesHeader.num_cut_rides   = (uint32_t)_cutRides.size();
+
+        MemoryStream extendedSprites;
+        extendedSprites.WriteValue(_extendedSpritesHeader);
+        extendedSprites.WriteArray(_extendedSprites.data(), _extendedSprites.size());
+        extendedSprites.WriteArray(_cutSprites.data(), _cutSprites.size());
+        extendedSprites.WriteArray(_cutRides.data(), _cutRides.size());
+        chunkWriter.WriteChunk(
+            extendedSprites.GetData(), (size_t)extendedSprites.GetLength(), SAWYER_ENCODING::RLECOMPRESSED);
+    }
+
     // Determine number of bytes written
     size_t fileSize = stream->GetLength();
 
@@ -200,11 +223,18 @@ void S6Exporter::Export()
     {
         memcpy(&_s6.sprites[i], get_sprite(i), sizeof(rct_sprite));
     }
+    _extendedSprites.clear();
+    for (size_t i = RCT2_MAX_SPRITES; i < sprite_get_capacity(); i++)
+    {
+        _extendedSprites.push_back(*get_sprite(i));
+    }
 
     for (int32_t i = 0; i < NUM_SPRITE_LISTS; i++)
     {
         _s6.sprite_lists_head[i]  = gSpriteListHead[i];
         _s6.sprite_lists_count[i] = gSpriteListCount[i];
+        _extendedSpritesHeader.sprite_lists_head[i]  = gSpriteListHead[i];
+        _extendedSpritesHeader.sprite_lists_count[i] = gSpriteListCount[i];
     }
     _s6.park_name = gParkName;
     // pad_013573D6
@@ -352,6 +382,7 @@ void S6Exporter::Export()
     _s6.game_ticks_1 = gCurrentTicks;
 
     this->ExportRides();
+    CutExtendedSpriteReferences();
 
     _s6.saved_age           = gSavedAge;
     _s6.saved_view_x        = gSavedViewX;
@@ -417,6 +448,24 @@ void S6Exporter::Export()
 
     scenario_fix_ghosts(&_s6);
     game_convert_strings_to_rct2(&_s6);
+    ExportPackedObjects();
+}
+
+/**
+ * Packs the objects while on the game thread, the object repository is not safe to use from a save running
+ * on another thread.
+ */
+void S6Exporter::ExportPackedObjects()
+{
+    _packedObjects.clear();
+    if (!ExportObjectsList.empty())
+    {
+        auto objRepo = OpenRCT2::GetContext()->GetObjectRepository();
+        MemoryStream packedObjects;
+        objRepo->WritePackedObjects(&packedObjects, ExportObjectsList);
+        auto data = (const uint8_t *)packedObjects.GetData();
+        _packedObjects.assign(data, data + packedObjects.GetLength());
+    }
 }
 
 void S6Exporter::ExportPeepSpawns()
@@ -441,6 +490,167 @@ uint32_t S6Exporter::GetLoanHash(money32 initialCash, money32 bankLoan, uint32_t
     return value;
 }
 
+/**
+ * Readers that stop before the extended sprite chunk would follow any reference to a sprite beyond
+ * RCT2_MAX_SPRITES out of bounds. The sprite lists are relinked through the sprites within the limit
+ * and other references are cleared, keeping the originals so that importing the whole file restores them.
+ */
+void S6Exporter::CutExtendedSpriteReferences()
+{
+    _cutSprites.clear();
+    _cutRides.clear();
+    if (_extendedSprites.empty())
+    {
+        return;
+    }
+
+    auto isExtended = [](uint16_t spriteIndex)
+    {
+        return spriteIndex != SPRITE_INDEX_NULL && spriteIndex >= RCT2_MAX_SPRITES;
+    };
+    std::vector<bool> isCut(RCT2_MAX_SPRITES);
+
+    // Keep the sprites within the limit in the same order as in the full list
+    for (int32_t list = 0; list < NUM_SPRITE_LISTS; list++)
+    {
+        rct_unk_sprite * previous = nullptr;
+        _s6.sprite_lists_head[list]  = SPRITE_INDEX_NULL;
+        _s6.sprite_lists_count[list] = 0;
+        for (uint16_t spriteIndex = gSpriteListHead[list]; spriteIndex != SPRITE_INDEX_NULL;
+             spriteIndex = get_sprite(spriteIndex)->unknown.next)
+        {
+            if (isExtended(spriteIndex))
+            {
+                continue;
+            }
+
+            rct_unk_sprite * sprite = &_s6.sprites[spriteIndex].unknown;
+            uint16_t previousIndex = previous == nullptr ? SPRITE_INDEX_NULL : previous->sprite_index;
+            if (sprite->previous != previousIndex)
+            {
+                sprite->previous = previousIndex;
+                isCut[spriteIndex] = true;
+            }
+            if (previous == nullptr)
+            {
+                _s6.sprite_lists_head[list] = spriteIndex;
+            }
+            else if (previous->next != spriteIndex)
+            {
+                previous->next = spriteIndex;
+                isCut[previous->sprite_index] = true;
+            }
+            previous = sprite;
+            _s6.sprite_lists_count[list]++;
+        }
+        if (previous != nullptr && previous->next != SPRITE_INDEX_NULL)
+        {
+            previous->next = SPRITE_INDEX_NULL;
+            isCut[previous->sprite_index] = true;
+        }
+    }
+
+    for (uint16_t i = 0; i < RCT2_MAX_SPRITES; i++)
+    {
+        rct_sprite * sprite = &_s6.sprites[i];
+        if (isExtended(sprite->unknown.next_in_quadrant))
+        {
+            uint16_t next = sprite->unknown.next_in_quadrant;
+            while (isExtended(next))
+            {
+                next = get_sprite(next)->unknown.next_in_quadrant;
+            }
+            sprite->unknown.next_in_quadrant = next;
+            isCut[i] = true;
+        }
+
+        if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
+        {
+            rct_vehicle * vehicle = &sprite->vehicle;
+            if (isExtended(vehicle->next_vehicle_on_train))
+            {
+                vehicle->next_vehicle_on_train = SPRITE_INDEX_NULL;
+                isCut[i] = true;
+            }
+
+            // The trains of a ride form a loop, skip over the ones that are cut
+            uint16_t next = vehicle->next_vehicle_on_ride;
+            uint16_t previous = vehicle->prev_vehicle_on_ride;
+            for (size_t j = 0; j < sprite_get_capacity() && isExtended(next); j++)
+            {
+                next = get_sprite(next)->vehicle.next_vehicle_on_ride;
+            }
+            for (size_t j = 0; j < sprite_get_capacity() && isExtended(previous); j++)
+            {
+                previous = get_sprite(previous)->vehicle.prev_vehicle_on_ride;
+            }
+            if (next != vehicle->next_vehicle_on_ride || previous != vehicle->prev_vehicle_on_ride)
+            {
+                vehicle->next_vehicle_on_ride = isExtended(next) ? i : next;
+                vehicle->prev_vehicle_on_ride = isExtended(previous) ? i : previous;
+                isCut[i] = true;
+            }
+
+            for (size_t j = 0; j < Util::CountOf(vehicle->peep); j++)
+            {
+                if (isExtended(vehicle->peep[j]))
+                {
+                    vehicle->peep[j] = SPRITE_INDEX_NULL;
+                    isCut[i] = true;
+                }
+            }
+        }
+        else if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP)
+        {
+            // A peep only keeps its place in the queue while the peep ahead of it is within the limit
+            if (isExtended(sprite->peep.next_in_queue))
+            {
+                sprite->peep.next_in_queue = SPRITE_INDEX_NULL;
+                isCut[i] = true;
+            }
+        }
+
+        if (isCut[i])
+        {
+            _cutSprites.push_back({ i, *get_sprite(i) });
+        }
+    }
+
+    for (uint8_t i = 0; i < RCT12_MAX_RIDES_IN_PARK; i++)
+    {
+        rct2_ride * ride = &_s6.rides[i];
+        rct_s6_cut_ride cutRide = { i, {}, ride->race_winner, ride->mechanic, ride->cable_lift, {} };
+        bool isRideCut = false;
+        auto cutIndex = [&isRideCut, &isExtended](uint16_t spriteIndex) -> uint16_t
+        {
+            if (isExtended(spriteIndex))
+            {
+                isRideCut = true;
+                return SPRITE_INDEX_NULL;
+            }
+            return spriteIndex;
+        };
+
+        for (size_t j = 0; j < Util::CountOf(ride->vehicles); j++)
+        {
+            cutRide.vehicles[j] = ride->vehicles[j];
+            ride->vehicles[j] = cutIndex(ride->vehicles[j]);
+        }
+        for (size_t j = 0; j < Util::CountOf(ride->last_peep_in_queue); j++)
+        {
+            cutRide.last_peep_in_queue[j] = ride->last_peep_in_queue[j];
+            ride->last_peep_in_queue[j] = cutIndex(ride->last_peep_in_queue[j]);
+        }
+        ride->race_winner = cutIndex(ride->race_winner);
+        ride->mechanic    = cutIndex(ride->mechanic);
+        ride->cable_lift  = cutIndex(ride->cable_lift);
+        if (isRideCut)
+        {
+            _cutRides.push_back(cutRide);
+        }
+    }
+}
+
 void S6Exporter::ExportRides()
 {
     for (int32_t index = 0; index < RCT12_MAX_RIDES_IN_PARK; index++)
@@ -746,11 +956,10 @@ enum : uint32_t
 };
 
 /**
- *
- *  rct2: 0x006754F5
- * @param flags bit 0: pack objects, 1: save as scenario
+ * Gets the park ready to be saved and exports it on the calling thread. Anything that reads the game state,
+ * including the objects to pack, is done here so that the exporter can then be saved from any thread.
  */
-int32_t scenario_save(const utf8 * path, int32_t flags)
+static std::shared_ptr<S6Exporter> scenario_export(int32_t flags)
 {
     if (flags & S6_SAVE_FLAG_SCENARIO)
     {
@@ -769,8 +978,7 @@ int32_t scenario_save(const utf8 * path, int32_t flags)
     map_reorganise_elements();
     viewport_set_saved_view();
 
-    bool result     = false;
-    auto s6exporter = new S6Exporter();
+    auto s6exporter = std::make_shared<S6Exporter>();
     try
     {
         if (flags & S6_SAVE_FLAG_EXPORT)
@@ -780,22 +988,45 @@ int32_t scenario_save(const utf8 * path, int32_t flags)
         }
         s6exporter->RemoveTracklessRides = true;
         s6exporter->Export();
-        if (flags & S6_SAVE_FLAG_SCENARIO)
-        {
-            s6exporter->SaveScenario(path);
-        }
-        else
-        {
-            s6exporter->SaveGame(path);
-        }
-        result = true;
     }
-    catch (const std::exception &)
+    catch (const std::exception &e)
     {
+        log_error("Unable to export park: %s", e.what());
+        s6exporter = nullptr;
     }
-    delete s6exporter;
 
     gfx_invalidate_screen();
+    return s6exporter;
+}
+
+/**
+ *
+ *  rct2: 0x006754F5
+ * @param flags bit 0: pack objects, 1: save as scenario
+ */
+int32_t scenario_save(const utf8 * path, int32_t flags)
+{
+    PROFILE_SCOPE("scenario_save");
+    bool result     = false;
+    auto s6exporter = scenario_export(flags);
+    if (s6exporter != nullptr)
+    {
+        try
+        {
+            if (flags & S6_SAVE_FLAG_SCENARIO)
+            {
+                s6exporter->SaveScenario(path);
+            }
+            else
+            {
+                s6exporter->SaveGame(path);
+            }
+            result = true;
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
 
     if (result && !(flags & S6_SAVE_FLAG_AUTOMATIC))
     {
@@ -803,3 +1034,94 @@ int32_t scenario_save(const utf8 * path, int32_t flags)
     }
     return result;
 }
+
+static std::future<bool> _asyncSaveResult;
+static std::string _asyncSavePath;
+static int32_t _asyncSaveFlags;
+
+/**
+ * Exports the park on the calling thread and leaves the encoding, checksumming
+ * and writing of the file to a worker thread. The file is written next to the
+ * destination and renamed over it once complete, so an interrupted save never
+ * replaces a good file. The optional beforeWrite function is run on the worker
+ * before the file is written. Completion is picked up by
+ * scenario_save_async_update on the game thread.
+ */
+bool scenario_save_async(const utf8 * path, int32_t flags, std::function<void()> beforeWrite)
+{
+    if (scenario_save_async_in_progress())
+    {
+        log_warning("Not saving %s, a previous save is still being written", path);
+        return false;
+    }
+
+    auto s6exporter = scenario_export(flags);
+    if (s6exporter == nullptr)
+    {
+        return false;
+    }
+
+    bool isScenario = (flags & S6_SAVE_FLAG_SCENARIO) != 0;
+    _asyncSavePath = path;
+    _asyncSaveFlags = flags;
+    _asyncSaveResult = std::async(std::launch::async, [s6exporter, isScenario, beforeWrite](std::string dstPath) -> bool
+    {
+        std::string tempPath = dstPath + ".tmp";
+        try
+        {
+            if (beforeWrite != nullptr)
+            {
+                beforeWrite();
+            }
+
+            {
+                auto fs = FileStream(tempPath, FILE_MODE_WRITE);
+                if (isScenario)
+                {
+                    s6exporter->SaveScenario(&fs);
+                }
+                else
+                {
+                    s6exporter->SaveGame(&fs);
+                }
+            }
+
+            if (!platform_file_replace(tempPath.c_str(), dstPath.c_str()))
+            {
+                throw std::runtime_error("Unable to replace the file.");
+            }
+            return true;
+        }
+        catch (const std::exception &e)
+        {
+            log_error("Unable to write %s: %s", dstPath.c_str(), e.what());
+            platform_file_delete(tempPath.c_str());
+            return false;
+        }
+    }, _asyncSavePath);
+    return true;
+}
+
+bool scenario_save_async_in_progress()
+{
+    return _asyncSaveResult.valid();
+}
+
+void scenario_save_async_update()
+{
+    if (_asyncSaveResult.valid() && _asyncSaveResult.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        if (_asyncSaveResult.get())
+        {
+            log_verbose("Saved to %s", _asyncSavePath.c_str());
+            if (!(_asyncSaveFlags & S6_SAVE_FLAG_AUTOMATIC))
+            {
+                gScreenAge = 0;
+            }
+        }
+        else
+        {
+            log_error("Failed to save %s", _asyncSavePath.c_str());
+        }
+    }
+}
@@ -38,6 +38,11 @@ public:
 
 private:
     rct_s6_data _s6{};
+    rct_s6_extended_sprites _extendedSpritesHeader{};
+    std::vector<rct_sprite> _extendedSprites;
+    std::vector<rct_s6_cut_sprite> _cutSprites;
+    std::vector<rct_s6_cut_ride> _cutRides;
+    std::vector<uint8_t> _packedObjects;
 
     void Save(IStream * stream, bool isScenario);
     static uint32_t GetLoanHash(money32 initialCash, money32 bankLoan, uint32_t maxBankLoan);
@@ -46,4 +51,6 @@ private:
     void ExportResearchedSceneryItems();
     void ExportResearchList();
     void ExportPeepSpawns();
+    void CutExtendedSpriteReferences();
+    void ExportPackedObjects();
 };
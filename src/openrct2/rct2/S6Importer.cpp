@@ -11,8 +11,9 @@
 #include "../config/Config.h"
 #include "../Context.h"
 #include "../core/Console.hpp"
-#include "../core/FileStream.hpp"
+#include "../core/File.h"
 #include "../core/IStream.hpp"
+#include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../Game.h"
@@ -60,6 +61,10 @@ private:
 
     const utf8 *    _s6Path = nullptr;
     rct_s6_data     _s6 { };
+    rct_s6_extended_sprites _extendedSpritesHeader{};
+    std::vector<rct_sprite> _extendedSprites;
+    std::vector<rct_s6_cut_sprite> _cutSprites;
+    std::vector<rct_s6_cut_ride> _cutRides;
     uint8_t           _gameVersion = 0;
 
 public:
@@ -88,16 +93,19 @@ public:
 
     ParkLoadResult LoadSavedGame(const utf8 * path, bool skipObjectCheck = false) override
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
-        auto result = LoadFromStream(&fs, false, skipObjectCheck);
+        // Chunks are decoded in place when the park is already in memory
+        auto data = File::ReadAllBytes(path);
+        auto ms = MemoryStream(data.data(), data.size());
+        auto result = LoadFromStream(&ms, false, skipObjectCheck);
         _s6Path = path;
         return result;
     }
 
     ParkLoadResult LoadScenario(const utf8 * path, bool skipObjectCheck = false) override
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
-        auto result = LoadFromStream(&fs, true, skipObjectCheck);
+        auto data = File::ReadAllBytes(path);
+        auto ms = MemoryStream(data.data(), data.size());
+        auto result = LoadFromStream(&ms, true, skipObjectCheck);
         _s6Path = path;
         return result;
     }
@@ -167,6 +175,8 @@ public:
             chunkReader.ReadChunk(&_s6.next_free_tile_element_pointer_index, 3048816);
         }
 
+        ReadExtendedSprites(stream, &chunkReader);
+
         _s6Path = path;
 
         return ParkLoadResult(std::vector<rct_object_entry>(std::begin(_s6.objects), std::end(_s6.objects)));
@@ -203,10 +213,15 @@ public:
         memcpy(gTileElements, _s6.tile_elements, sizeof(_s6.tile_elements));
 
         gNextFreeTileElementPointerIndex = _s6.next_free_tile_element_pointer_index;
+        sprite_set_capacity(RCT2_MAX_SPRITES + _extendedSprites.size());
         for (int32_t i = 0; i < RCT2_MAX_SPRITES; i++)
         {
             memcpy(get_sprite(i), &_s6.sprites[i], sizeof(rct_sprite));
         }
+        for (size_t i = 0; i < _extendedSprites.size(); i++)
+        {
+            memcpy(get_sprite(RCT2_MAX_SPRITES + i), &_extendedSprites[i], sizeof(rct_sprite));
+        }
 
         for (int32_t i = 0; i < NUM_SPRITE_LISTS; i++)
         {
@@ -373,6 +388,7 @@ public:
         gCurrentTicks = _s6.game_ticks_1;
 
         ImportRides();
+        ImportCutSpriteReferences();
 
         gSavedAge          = _s6.saved_age;
         gSavedViewX        = _s6.saved_view_x;
@@ -764,6 +780,95 @@ public:
         memcpy(gResearchItems, _s6.research_items, sizeof(_s6.research_items));
     }
 
+    /**
+     * Reads the optional chunk of sprites beyond the RCT2 sprite limit which
+     * follows the last regular chunk when the park's sprite list had grown.
+     */
+    void ReadExtendedSprites(IStream * stream, SawyerChunkReader * chunkReader)
+    {
+        _extendedSprites.clear();
+        _cutSprites.clear();
+        _cutRides.clear();
+
+        // The stream always ends with a 4 byte checksum
+        uint64_t position = stream->GetPosition();
+        if (position + 4 >= stream->GetLength())
+        {
+            return;
+        }
+
+        try
+        {
+            auto chunk = chunkReader->ReadChunk();
+            auto chunkStream = MemoryStream(chunk->GetData(), chunk->GetLength());
+            auto header = chunkStream.ReadValue<rct_s6_extended_sprites>();
+            if (header.num_sprites == 0 || header.num_sprites > MAX_SPRITES_EXTENDED - RCT2_MAX_SPRITES ||
+                header.num_cut_sprites > RCT2_MAX_SPRITES || header.num_cut_rides > RCT12_MAX_RIDES_IN_PARK)
+            {
+                throw std::runtime_error("Invalid extended sprite chunk.");
+            }
+
+            std::vector<rct_s6_cut_sprite> cutSprites(header.num_cut_sprites);
+            std::vector<rct_s6_cut_ride> cutRides(header.num_cut_rides);
+            _extendedSprites.resize(header.num_sprites);
+            chunkStream.Read(_extendedSprites.data(), _extendedSprites.size() * sizeof(rct_sprite));
+            chunkStream.Read(cutSprites.data(), cutSprites.size() * sizeof(rct_s6_cut_sprite));
+            chunkStream.Read(cutRides.data(), cutRides.size() * sizeof(rct_s6_cut_ride));
+            _extendedSpritesHeader = header;
+            _cutSprites = std::move(cutSprites);
+            _cutRides = std::move(cutRides);
+        }
+        catch (const std::exception &e)
+        {
+            log_warning("Ignoring data after the last chunk: %s", e.what());
+            _extendedSprites.clear();
+            stream->SetPosition(position);
+        }
+    }
+
+    /**
+     * Puts back the sprite links and ride references that were cut when the park was saved so that
+     * the sprites within the RCT2 limit did not refer to the ones beyond it.
+     */
+    void ImportCutSpriteReferences()
+    {
+        if (_extendedSprites.empty())
+        {
+            return;
+        }
+
+        for (const auto &cutSprite : _cutSprites)
+        {
+            if (cutSprite.index < RCT2_MAX_SPRITES)
+            {
+                memcpy(get_sprite(cutSprite.index), &cutSprite.sprite, sizeof(rct_sprite));
+            }
+        }
+        for (int32_t i = 0; i < NUM_SPRITE_LISTS; i++)
+        {
+            gSpriteListHead[i]  = _extendedSpritesHeader.sprite_lists_head[i];
+            gSpriteListCount[i] = _extendedSpritesHeader.sprite_lists_count[i];
+        }
+        for (const auto &cutRide : _cutRides)
+        {
+            Ride * ride = cutRide.index < RCT12_MAX_RIDES_IN_PARK ? get_ride(cutRide.index) : nullptr;
+            if (ride != nullptr && ride->type != RIDE_TYPE_NULL)
+            {
+                for (size_t i = 0; i < RCT2_MAX_VEHICLES_PER_RIDE; i++)
+                {
+                    ride->vehicles[i] = cutRide.vehicles[i];
+                }
+                for (size_t i = 0; i < RCT12_MAX_STATIONS_PER_RIDE; i++)
+                {
+                    ride->last_peep_in_queue[i] = cutRide.last_peep_in_queue[i];
+                }
+                ride->race_winner = cutRide.race_winner;
+                ride->mechanic    = cutRide.mechanic;
+                ride->cable_lift  = cutRide.cable_lift;
+            }
+        }
+    }
+
     void Initialise()
     {
         OpenRCT2::GetContext()->GetGameState()->InitAll(_s6.map_size);
@@ -815,7 +920,7 @@ public:
     {
         // The number of riders might have overflown or underflown. Re-calculate the value.
         uint16_t numRiders = 0;
-        for (const rct_sprite sprite : _s6.sprites)
+        auto countRider = [&numRiders, rideIndex](const rct_sprite &sprite)
         {
             if (sprite.unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP)
             {
@@ -825,7 +930,9 @@ public:
                     numRiders++;
                 }
             }
-        }
+        };
+        std::for_each(std::begin(_s6.sprites), std::end(_s6.sprites), countRider);
+        std::for_each(_extendedSprites.begin(), _extendedSprites.end(), countRider);
         dst->num_riders = numRiders;
     }
 };
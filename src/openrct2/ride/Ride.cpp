@@ -33,6 +33,7 @@
 #include "../paint/VirtualFloor.h"
 #include "../peep/Peep.h"
 #include "../peep/Staff.h"
+#include "../Profiling.h"
 #include "../rct1/RCT1.h"
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
@@ -1998,6 +1999,7 @@ int32_t ride_initialise_construction_window(int32_t rideIndex)
  */
 void ride_update_all()
 {
+    PROFILE_SCOPE("ride_update_all");
     Ride *ride;
     int32_t i;
 
@@ -4496,7 +4498,7 @@ static void ride_set_start_finish_points(int32_t rideIndex, CoordsXYE *startElem
 static int32_t count_free_misc_sprite_slots()
 {
     int32_t miscSpriteCount = gSpriteListCount[SPRITE_LIST_MISC];
-    int32_t remainingSpriteCount = gSpriteListCount[SPRITE_LIST_NULL];
+    int32_t remainingSpriteCount = (int32_t)sprite_get_num_available();
     return std::max(0, miscSpriteCount + remainingSpriteCount - 300);
 }
 
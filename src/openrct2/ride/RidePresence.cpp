@@ -0,0 +1,181 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include "../world/Map.h"
+#include "RidePresence.h"
+#include "Track.h"
+
+// The guest searches only look at the first 256x256 tiles
+constexpr int32_t RIDE_PRESENCE_MAP_SIZE = 256;
+constexpr int32_t RIDE_PRESENCE_CELL_SHIFT = 3;
+constexpr int32_t RIDE_PRESENCE_CELL_SIZE = 1 << RIDE_PRESENCE_CELL_SHIFT;
+constexpr int32_t RIDE_PRESENCE_GRID_SIZE = RIDE_PRESENCE_MAP_SIZE / RIDE_PRESENCE_CELL_SIZE;
+constexpr int32_t RIDE_PRESENCE_NUM_CELLS = RIDE_PRESENCE_GRID_SIZE * RIDE_PRESENCE_GRID_SIZE;
+
+using ride_set = std::array<uint32_t, 8>;
+
+static std::array<ride_set, RIDE_PRESENCE_NUM_CELLS> _cellRides;
+static std::bitset<RIDE_PRESENCE_NUM_CELLS> _dirtyCells;
+static bool _allCellsDirty = true;
+
+static void ride_presence_add_tile_rides(int32_t x, int32_t y, ride_set& rides)
+{
+    rct_tile_element * tileElement = map_get_first_element_at(x, y);
+    do
+    {
+        if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK)
+            continue;
+
+        int32_t rideIndex = track_element_get_ride_index(tileElement);
+        rides[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
+    }
+    while (!(tileElement++)->IsLastForTile());
+}
+
+static void ride_presence_rebuild_cell(int32_t cellIndex)
+{
+    auto& rides = _cellRides[cellIndex];
+    rides.fill(0);
+
+    int32_t left = (cellIndex % RIDE_PRESENCE_GRID_SIZE) << RIDE_PRESENCE_CELL_SHIFT;
+    int32_t top = (cellIndex / RIDE_PRESENCE_GRID_SIZE) << RIDE_PRESENCE_CELL_SHIFT;
+    for (int32_t y = top; y < top + RIDE_PRESENCE_CELL_SIZE; y++)
+    {
+        for (int32_t x = left; x < left + RIDE_PRESENCE_CELL_SIZE; x++)
+        {
+            ride_presence_add_tile_rides(x, y, rides);
+        }
+    }
+}
+
+static void ride_presence_update()
+{
+    if (_allCellsDirty)
+    {
+        for (int32_t i = 0; i < RIDE_PRESENCE_NUM_CELLS; i++)
+        {
+            ride_presence_rebuild_cell(i);
+        }
+        _allCellsDirty = false;
+        _dirtyCells.reset();
+    }
+    else if (_dirtyCells.any())
+    {
+        for (int32_t i = 0; i < RIDE_PRESENCE_NUM_CELLS; i++)
+        {
+            if (_dirtyCells[i])
+            {
+                ride_presence_rebuild_cell(i);
+            }
+        }
+        _dirtyCells.reset();
+    }
+}
+
+void ride_presence_invalidate_tile(int32_t x, int32_t y)
+{
+    if (x < 0 || y < 0 || x >= RIDE_PRESENCE_MAP_SIZE || y >= RIDE_PRESENCE_MAP_SIZE)
+        return;
+
+    _dirtyCells[(y >> RIDE_PRESENCE_CELL_SHIFT) * RIDE_PRESENCE_GRID_SIZE + (x >> RIDE_PRESENCE_CELL_SHIFT)] = true;
+}
+
+void ride_presence_invalidate_all()
+{
+    _allCellsDirty = true;
+}
+
+static bool ride_presence_take_rides(const ride_set& cellRides, uint32_t pending[8], uint32_t result[8])
+{
+    bool anyPending = false;
+    for (int32_t i = 0; i < 8; i++)
+    {
+        uint32_t found = cellRides[i] & pending[i];
+        result[i] |= found;
+        pending[i] &= ~found;
+        anyPending |= pending[i] != 0;
+    }
+    return anyPending;
+}
+
+static bool ride_presence_intersects(const ride_set& cellRides, const uint32_t pending[8])
+{
+    for (int32_t i = 0; i < 8; i++)
+    {
+        if (cellRides[i] & pending[i])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ride_presence_get_nearby_rides(int32_t x, int32_t y, int32_t range, const uint32_t candidates[8], uint32_t result[8])
+{
+    ride_presence_update();
+
+    uint32_t pending[8];
+    std::copy_n(candidates, 8, pending);
+    std::fill_n(result, 8, 0);
+
+    int32_t left = std::max(x - range, 0);
+    int32_t top = std::max(y - range, 0);
+    int32_t right = std::min(x + range, RIDE_PRESENCE_MAP_SIZE - 1);
+    int32_t bottom = std::min(y + range, RIDE_PRESENCE_MAP_SIZE - 1);
+    if (left > right || top > bottom)
+        return;
+
+    // Cells that lie completely inside the square can be taken as they are
+    int32_t cellLeft = left >> RIDE_PRESENCE_CELL_SHIFT;
+    int32_t cellTop = top >> RIDE_PRESENCE_CELL_SHIFT;
+    int32_t cellRight = right >> RIDE_PRESENCE_CELL_SHIFT;
+    int32_t cellBottom = bottom >> RIDE_PRESENCE_CELL_SHIFT;
+    bool anyPending = true;
+    for (int32_t cy = cellTop; cy <= cellBottom && anyPending; cy++)
+    {
+        for (int32_t cx = cellLeft; cx <= cellRight && anyPending; cx++)
+        {
+            int32_t cellX = cx << RIDE_PRESENCE_CELL_SHIFT;
+            int32_t cellY = cy << RIDE_PRESENCE_CELL_SHIFT;
+            if (cellX >= left && cellY >= top &&
+                cellX + RIDE_PRESENCE_CELL_SIZE - 1 <= right && cellY + RIDE_PRESENCE_CELL_SIZE - 1 <= bottom)
+            {
+                anyPending = ride_presence_take_rides(_cellRides[cy * RIDE_PRESENCE_GRID_SIZE + cx], pending, result);
+            }
+        }
+    }
+
+    // Cells on the edge of the square only need their tiles checked if they hold a ride not found yet
+    for (int32_t cy = cellTop; cy <= cellBottom && anyPending; cy++)
+    {
+        for (int32_t cx = cellLeft; cx <= cellRight && anyPending; cx++)
+        {
+            if (!ride_presence_intersects(_cellRides[cy * RIDE_PRESENCE_GRID_SIZE + cx], pending))
+                continue;
+
+            int32_t tileLeft = std::max(cx << RIDE_PRESENCE_CELL_SHIFT, left);
+            int32_t tileTop = std::max(cy << RIDE_PRESENCE_CELL_SHIFT, top);
+            int32_t tileRight = std::min((cx << RIDE_PRESENCE_CELL_SHIFT) + RIDE_PRESENCE_CELL_SIZE - 1, right);
+            int32_t tileBottom = std::min((cy << RIDE_PRESENCE_CELL_SHIFT) + RIDE_PRESENCE_CELL_SIZE - 1, bottom);
+
+            ride_set tileRides{};
+            for (int32_t ty = tileTop; ty <= tileBottom; ty++)
+            {
+                for (int32_t tx = tileLeft; tx <= tileRight; tx++)
+                {
+                    ride_presence_add_tile_rides(tx, ty, tileRides);
+                }
+            }
+            anyPending = ride_presence_take_rides(tileRides, pending, result);
+        }
+    }
+}
@@ -0,0 +1,28 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+/**
+ * A coarse grid over the map recording which rides have track in each cell, so that guests can find
+ * nearby rides without walking every tile around them. Cells are rebuilt from the map lazily, after
+ * they have been invalidated by changes to the tile elements.
+ */
+void ride_presence_invalidate_tile(int32_t x, int32_t y);
+void ride_presence_invalidate_all();
+
+/**
+ * Finds which of the candidate rides have a track element within range tiles of the given tile,
+ * exactly as a scan of every tile in that square would.
+ * @param candidates a bit set of 256 ride indices to look for.
+ * @param result receives the bit set of candidate rides that were found.
+ */
+void ride_presence_get_nearby_rides(int32_t x, int32_t y, int32_t range, const uint32_t candidates[8], uint32_t result[8]);
@@ -8,12 +8,16 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <memory>
+#include <vector>
 #include "../Cheats.h"
+#include "../core/JobPool.hpp"
 #include "../core/Math.hpp"
 #include "../core/Util.hpp"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
 #include "../OpenRCT2.h"
+#include "../Profiling.h"
 #include "../world/Footpath.h"
 #include "../world/Map.h"
 #include "../world/Surface.h"
@@ -62,77 +66,200 @@ enum {
     PROXIMITY_COUNT
 };
 
-using ride_ratings_calculation = void (*)(Ride *ride);
+// Batches smaller than this are rated on the calling thread
+constexpr size_t RIDE_RATINGS_MIN_PARALLEL_RIDES = 8;
+
+using ride_ratings_calculation = void (*)(Ride *ride, rct_ride_rating_calc_data * calcData);
 
 rct_ride_rating_calc_data gRideRatingsCalcData;
 
+static std::vector<uint8_t> _ridesToRate;
+
+// Kept for the whole session so that rating a batch of rides does not start new threads every time
+static std::unique_ptr<JobPool> _rideRatingsJobPool;
+
 static ride_ratings_calculation ride_ratings_get_calculate_func(uint8_t rideType);
 
-static void ride_ratings_update_state();
-static void ride_ratings_update_state_0();
-static void ride_ratings_update_state_1();
-static void ride_ratings_update_state_2();
-static void ride_ratings_update_state_3();
-static void ride_ratings_update_state_4();
-static void ride_ratings_update_state_5();
-static void ride_ratings_begin_proximity_loop();
-static void ride_ratings_calculate(Ride *ride);
+static void ride_ratings_update_state(rct_ride_rating_calc_data * calcData);
+static void ride_ratings_update_state_0(rct_ride_rating_calc_data * calcData);
+static void ride_ratings_update_state_1(rct_ride_rating_calc_data * calcData);
+static void ride_ratings_update_state_2(rct_ride_rating_calc_data * calcData);
+static void ride_ratings_update_state_3(rct_ride_rating_calc_data * calcData);
+static void ride_ratings_update_state_4(rct_ride_rating_calc_data * calcData);
+static void ride_ratings_update_state_5(rct_ride_rating_calc_data * calcData);
+static void ride_ratings_begin_proximity_loop(rct_ride_rating_calc_data * calcData);
+static void ride_ratings_calculate(Ride *ride, rct_ride_rating_calc_data * calcData);
 static void ride_ratings_calculate_value(Ride *ride);
-static void ride_ratings_score_close_proximity(rct_tile_element *inputTileElement);
+static bool ride_ratings_calculate_ride(uint8_t rideIndex, Ride * ride);
+static void ride_ratings_apply(uint8_t rideIndex, const Ride * ratedRide);
+static void ride_ratings_score_close_proximity(rct_ride_rating_calc_data * calcData, rct_tile_element *inputTileElement);
 
 static void ride_ratings_add(rating_tuple * rating, int32_t excitement, int32_t intensity, int32_t nausea);
 
 /**
- * This is a small hack function to keep calling the ride rating processor until
- * the given ride's ratings have been calculated. What ever is currently being
- * processed will be overwritten.
- * Only purpose of this function currently is for testing.
+ * Calculates the given ride's ratings straight away. Unlike the old approach of
+ * spinning the global state machine, this leaves whatever ride_ratings_update_all
+ * is currently processing alone.
  */
 void ride_ratings_update_ride(int rideIndex)
 {
-    Ride *ride = get_ride(rideIndex);
-    if (ride->type != RIDE_TYPE_NULL && ride->status != RIDE_STATUS_CLOSED) {
-        gRideRatingsCalcData.current_ride = rideIndex;
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_INITIALISE;
-        while (gRideRatingsCalcData.state != RIDE_RATINGS_STATE_FIND_NEXT_RIDE)
+    ride_ratings_update_rides({ (uint8_t)rideIndex });
+}
+
+/**
+ * Rates each of the given rides in full. When there are enough of them the
+ * calculations are spread over a job pool, each working on its own copy of the
+ * ride. The results are written back afterwards in the order the rides were
+ * given, so the outcome is identical to rating them one after another.
+ */
+void ride_ratings_update_rides(const std::vector<uint8_t> &rideIndices)
+{
+    std::vector<Ride> ratedRides(rideIndices.size());
+    std::vector<uint8_t> rated(rideIndices.size());
+    auto calculate = [&rideIndices, &ratedRides, &rated](size_t i)
+    {
+        ratedRides[i] = *get_ride(rideIndices[i]);
+        rated[i] = ride_ratings_calculate_ride(rideIndices[i], &ratedRides[i]);
+    };
+
+    if (rideIndices.size() < RIDE_RATINGS_MIN_PARALLEL_RIDES)
+    {
+        for (size_t i = 0; i < rideIndices.size(); i++)
         {
-            ride_ratings_update_state();
+            calculate(i);
+        }
+    }
+    else
+    {
+        if (_rideRatingsJobPool == nullptr)
+        {
+            _rideRatingsJobPool = std::make_unique<JobPool>();
+        }
+        for (size_t i = 0; i < rideIndices.size(); i++)
+        {
+            _rideRatingsJobPool->AddTask([&calculate, i]() { calculate(i); });
+        }
+        _rideRatingsJobPool->Join();
+    }
+
+    for (size_t i = 0; i < rideIndices.size(); i++)
+    {
+        if (rated[i])
+        {
+            ride_ratings_apply(rideIndices[i], &ratedRides[i]);
         }
     }
 }
 
+/**
+ * Recalculates the ratings of every open ride at once, e.g. after importing a park.
+ */
+void ride_ratings_update_all_rides()
+{
+    std::vector<uint8_t> rideIndices;
+    int32_t i;
+    Ride * ride;
+    FOR_ALL_RIDES(i, ride)
+    {
+        if (ride->status != RIDE_STATUS_CLOSED)
+        {
+            rideIndices.push_back(i);
+        }
+    }
+    ride_ratings_update_rides(rideIndices);
+}
+
+/**
+ * Queues the ride to be rated at the end of the current tick instead of waiting
+ * for ride_ratings_update_all to work its way round to it.
+ */
+void ride_ratings_invalidate(int32_t rideIndex)
+{
+    if (std::find(_ridesToRate.begin(), _ridesToRate.end(), rideIndex) == _ridesToRate.end())
+    {
+        _ridesToRate.push_back(rideIndex);
+    }
+}
+
 /**
  *
  *  rct2: 0x006B5A2A
  */
 void ride_ratings_update_all()
 {
+    PROFILE_SCOPE("ride_ratings_update_all");
     if (gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR)
+    {
+        _ridesToRate.clear();
         return;
+    }
+
+    if (!_ridesToRate.empty())
+    {
+        ride_ratings_update_rides(_ridesToRate);
+        _ridesToRate.clear();
+    }
+
+    ride_ratings_update_state(&gRideRatingsCalcData);
+}
+
+/**
+ * Runs every state of the rating process for one ride using its own calculation
+ * data. The track walk only reads the map and the results are written to the
+ * given ride, which can be a copy, so this is safe to call for several rides at
+ * once.
+ */
+static bool ride_ratings_calculate_ride(uint8_t rideIndex, Ride * ride)
+{
+    rct_ride_rating_calc_data calcData = {};
+    calcData.current_ride = rideIndex;
+    calcData.state = RIDE_RATINGS_STATE_INITIALISE;
+    while (calcData.state != RIDE_RATINGS_STATE_FIND_NEXT_RIDE && calcData.state != RIDE_RATINGS_STATE_CALCULATE)
+    {
+        ride_ratings_update_state(&calcData);
+    }
+    if (calcData.state != RIDE_RATINGS_STATE_CALCULATE)
+        return false;
+
+    ride_ratings_calculate(ride, &calcData);
+    ride_ratings_calculate_value(ride);
+    return true;
+}
+
+static void ride_ratings_apply(uint8_t rideIndex, const Ride * ratedRide)
+{
+    Ride * ride = get_ride(rideIndex);
+    ride->ratings = ratedRide->ratings;
+    ride->value = ratedRide->value;
+    ride->upkeep_cost = ratedRide->upkeep_cost;
+    ride->unreliability_factor = ratedRide->unreliability_factor;
+    ride->inversions = ratedRide->inversions;
+    ride->lifecycle_flags = ratedRide->lifecycle_flags;
+    ride->window_invalidate_flags = ratedRide->window_invalidate_flags;
 
-    ride_ratings_update_state();
+    window_invalidate_by_number(WC_RIDE, rideIndex);
 }
 
-static void ride_ratings_update_state()
+static void ride_ratings_update_state(rct_ride_rating_calc_data * calcData)
 {
-    switch (gRideRatingsCalcData.state) {
+    switch (calcData->state) {
     case RIDE_RATINGS_STATE_FIND_NEXT_RIDE:
-        ride_ratings_update_state_0();
+        ride_ratings_update_state_0(calcData);
         break;
     case RIDE_RATINGS_STATE_INITIALISE:
-        ride_ratings_update_state_1();
+        ride_ratings_update_state_1(calcData);
         break;
     case RIDE_RATINGS_STATE_2:
-        ride_ratings_update_state_2();
+        ride_ratings_update_state_2(calcData);
         break;
     case RIDE_RATINGS_STATE_CALCULATE:
-        ride_ratings_update_state_3();
+        ride_ratings_update_state_3(calcData);
         break;
     case RIDE_RATINGS_STATE_4:
-        ride_ratings_update_state_4();
+        ride_ratings_update_state_4(calcData);
         break;
     case RIDE_RATINGS_STATE_5:
-        ride_ratings_update_state_5();
+        ride_ratings_update_state_5(calcData);
         break;
     }
 }
@@ -141,9 +268,9 @@ static void ride_ratings_update_state()
  *
  *  rct2: 0x006B5A5C
  */
-static void ride_ratings_update_state_0()
+static void ride_ratings_update_state_0(rct_ride_rating_calc_data * calcData)
 {
-    int32_t currentRide = gRideRatingsCalcData.current_ride;
+    int32_t currentRide = calcData->current_ride;
 
     currentRide++;
     if (currentRide == 255) {
@@ -152,45 +279,45 @@ static void ride_ratings_update_state_0()
 
     Ride *ride = get_ride(currentRide);
     if (ride->type != RIDE_TYPE_NULL && ride->status != RIDE_STATUS_CLOSED) {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_INITIALISE;
+        calcData->state = RIDE_RATINGS_STATE_INITIALISE;
     }
-    gRideRatingsCalcData.current_ride = currentRide;
+    calcData->current_ride = currentRide;
 }
 
 /**
  *
  *  rct2: 0x006B5A94
  */
-static void ride_ratings_update_state_1()
+static void ride_ratings_update_state_1(rct_ride_rating_calc_data * calcData)
 {
-    gRideRatingsCalcData.proximity_total = 0;
+    calcData->proximity_total = 0;
     for (int32_t i = 0; i < PROXIMITY_COUNT; i++) {
-        gRideRatingsCalcData.proximity_scores[i] = 0;
+        calcData->proximity_scores[i] = 0;
     }
-    gRideRatingsCalcData.num_brakes = 0;
-    gRideRatingsCalcData.num_reversers = 0;
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_2;
-    gRideRatingsCalcData.station_flags = 0;
-    ride_ratings_begin_proximity_loop();
+    calcData->num_brakes = 0;
+    calcData->num_reversers = 0;
+    calcData->state = RIDE_RATINGS_STATE_2;
+    calcData->station_flags = 0;
+    ride_ratings_begin_proximity_loop(calcData);
 }
 
 /**
  *
  *  rct2: 0x006B5C66
  */
-static void ride_ratings_update_state_2()
+static void ride_ratings_update_state_2(rct_ride_rating_calc_data * calcData)
 {
-    const int32_t rideIndex = gRideRatingsCalcData.current_ride;
+    const int32_t rideIndex = calcData->current_ride;
     Ride *ride = get_ride(rideIndex);
     if (ride->type == RIDE_TYPE_NULL || ride->status == RIDE_STATUS_CLOSED) {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        calcData->state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
-    int32_t x = gRideRatingsCalcData.proximity_x / 32;
-    int32_t y = gRideRatingsCalcData.proximity_y / 32;
-    int32_t z = gRideRatingsCalcData.proximity_z / 8;
-    int32_t trackType = gRideRatingsCalcData.proximity_track_type;
+    int32_t x = calcData->proximity_x / 32;
+    int32_t y = calcData->proximity_y / 32;
+    int32_t z = calcData->proximity_z / 8;
+    int32_t trackType = calcData->proximity_track_type;
 
     rct_tile_element *tileElement = map_get_first_element_at(x, y);
     do {
@@ -205,23 +332,23 @@ static void ride_ratings_update_state_2()
         {
             if (trackType == TRACK_ELEM_END_STATION) {
                 int32_t entranceIndex = tile_element_get_station(tileElement);
-                gRideRatingsCalcData.station_flags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+                calcData->station_flags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
                 if (ride_get_entrance_location(rideIndex, entranceIndex).isNull())
                 {
-                    gRideRatingsCalcData.station_flags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+                    calcData->station_flags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
                 }
             }
 
-            ride_ratings_score_close_proximity(tileElement);
+            ride_ratings_score_close_proximity(calcData, tileElement);
 
             CoordsXYE trackElement = {
-                /* .x = */ gRideRatingsCalcData.proximity_x,
-                /* .y = */ gRideRatingsCalcData.proximity_y,
+                /* .x = */ calcData->proximity_x,
+                /* .y = */ calcData->proximity_y,
                 /* .element = */ tileElement
             };
             CoordsXYE nextTrackElement;
             if (!track_block_get_next(&trackElement, &nextTrackElement, NULL, NULL)) {
-                gRideRatingsCalcData.state = RIDE_RATINGS_STATE_4;
+                calcData->state = RIDE_RATINGS_STATE_4;
                 return;
             }
 
@@ -229,66 +356,66 @@ static void ride_ratings_update_state_2()
             y = nextTrackElement.y;
             z = nextTrackElement.element->base_height * 8;
             tileElement = nextTrackElement.element;
-            if (x == gRideRatingsCalcData.proximity_start_x && y == gRideRatingsCalcData.proximity_start_y && z == gRideRatingsCalcData.proximity_start_z) {
-                gRideRatingsCalcData.state = RIDE_RATINGS_STATE_CALCULATE;
+            if (x == calcData->proximity_start_x && y == calcData->proximity_start_y && z == calcData->proximity_start_z) {
+                calcData->state = RIDE_RATINGS_STATE_CALCULATE;
                 return;
             }
-            gRideRatingsCalcData.proximity_x = x;
-            gRideRatingsCalcData.proximity_y = y;
-            gRideRatingsCalcData.proximity_z = z;
-            gRideRatingsCalcData.proximity_track_type = track_element_get_type(tileElement);
+            calcData->proximity_x = x;
+            calcData->proximity_y = y;
+            calcData->proximity_z = z;
+            calcData->proximity_track_type = track_element_get_type(tileElement);
             return;
         }
     } while (!(tileElement++)->IsLastForTile());
 
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    calcData->state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
 /**
  *
  *  rct2: 0x006B5E4D
  */
-static void ride_ratings_update_state_3()
+static void ride_ratings_update_state_3(rct_ride_rating_calc_data * calcData)
 {
-    Ride *ride = get_ride(gRideRatingsCalcData.current_ride);
+    Ride *ride = get_ride(calcData->current_ride);
     if (ride->type == RIDE_TYPE_NULL || ride->status == RIDE_STATUS_CLOSED) {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        calcData->state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
-    ride_ratings_calculate(ride);
+    ride_ratings_calculate(ride, calcData);
     ride_ratings_calculate_value(ride);
 
-    window_invalidate_by_number(WC_RIDE, gRideRatingsCalcData.current_ride);
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    window_invalidate_by_number(WC_RIDE, calcData->current_ride);
+    calcData->state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
 /**
  *
  *  rct2: 0x006B5BAB
  */
-static void ride_ratings_update_state_4()
+static void ride_ratings_update_state_4(rct_ride_rating_calc_data * calcData)
 {
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_5;
-    ride_ratings_begin_proximity_loop();
+    calcData->state = RIDE_RATINGS_STATE_5;
+    ride_ratings_begin_proximity_loop(calcData);
 }
 
 /**
  *
  *  rct2: 0x006B5D72
  */
-static void ride_ratings_update_state_5()
+static void ride_ratings_update_state_5(rct_ride_rating_calc_data * calcData)
 {
-    Ride *ride = get_ride(gRideRatingsCalcData.current_ride);
+    Ride *ride = get_ride(calcData->current_ride);
     if (ride->type == RIDE_TYPE_NULL || ride->status == RIDE_STATUS_CLOSED) {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        calcData->state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
-    int32_t x = gRideRatingsCalcData.proximity_x / 32;
-    int32_t y = gRideRatingsCalcData.proximity_y / 32;
-    int32_t z = gRideRatingsCalcData.proximity_z / 8;
-    int32_t trackType = gRideRatingsCalcData.proximity_track_type;
+    int32_t x = calcData->proximity_x / 32;
+    int32_t y = calcData->proximity_y / 32;
+    int32_t z = calcData->proximity_z / 8;
+    int32_t trackType = calcData->proximity_track_type;
 
     rct_tile_element *tileElement = map_get_first_element_at(x, y);
     do {
@@ -298,91 +425,91 @@ static void ride_ratings_update_state_5()
             continue;
 
         if (trackType == 255 || trackType == track_element_get_type(tileElement)) {
-            ride_ratings_score_close_proximity(tileElement);
+            ride_ratings_score_close_proximity(calcData, tileElement);
 
-            x = gRideRatingsCalcData.proximity_x;
-            y = gRideRatingsCalcData.proximity_y;
+            x = calcData->proximity_x;
+            y = calcData->proximity_y;
             track_begin_end trackBeginEnd;
             if (!track_block_get_previous(x, y, tileElement, &trackBeginEnd)) {
-                gRideRatingsCalcData.state = RIDE_RATINGS_STATE_CALCULATE;
+                calcData->state = RIDE_RATINGS_STATE_CALCULATE;
                 return;
             }
 
             x = trackBeginEnd.begin_x;
             y = trackBeginEnd.begin_y;
             z = trackBeginEnd.begin_z;
-            if (x == gRideRatingsCalcData.proximity_start_x && y == gRideRatingsCalcData.proximity_start_y && z == gRideRatingsCalcData.proximity_start_z) {
-                gRideRatingsCalcData.state = RIDE_RATINGS_STATE_CALCULATE;
+            if (x == calcData->proximity_start_x && y == calcData->proximity_start_y && z == calcData->proximity_start_z) {
+                calcData->state = RIDE_RATINGS_STATE_CALCULATE;
                 return;
             }
-            gRideRatingsCalcData.proximity_x = x;
-            gRideRatingsCalcData.proximity_y = y;
-            gRideRatingsCalcData.proximity_z = z;
-            gRideRatingsCalcData.proximity_track_type = track_element_get_type(trackBeginEnd.begin_element);
+            calcData->proximity_x = x;
+            calcData->proximity_y = y;
+            calcData->proximity_z = z;
+            calcData->proximity_track_type = track_element_get_type(trackBeginEnd.begin_element);
             return;
         }
     } while (!(tileElement++)->IsLastForTile());
 
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    calcData->state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
 /**
  *
  *  rct2: 0x006B5BB2
  */
-static void ride_ratings_begin_proximity_loop()
+static void ride_ratings_begin_proximity_loop(rct_ride_rating_calc_data * calcData)
 {
-    const int32_t rideIndex = gRideRatingsCalcData.current_ride;
+    const int32_t rideIndex = calcData->current_ride;
     Ride *ride = get_ride(rideIndex);
     if (ride->type == RIDE_TYPE_NULL || ride->status == RIDE_STATUS_CLOSED) {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        calcData->state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
     if (ride->type == RIDE_TYPE_MAZE) {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_CALCULATE;
+        calcData->state = RIDE_RATINGS_STATE_CALCULATE;
         return;
     }
 
     for (int32_t i = 0; i < MAX_STATIONS; i++) {
         if (ride->station_starts[i].xy != RCT_XY8_UNDEFINED) {
-            gRideRatingsCalcData.station_flags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+            calcData->station_flags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
             if (ride_get_entrance_location(rideIndex, i).isNull())
             {
-                gRideRatingsCalcData.station_flags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+                calcData->station_flags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
             }
 
             int32_t x = ride->station_starts[i].x * 32;
             int32_t y = ride->station_starts[i].y * 32;
             int32_t z = ride->station_heights[i] * 8;
 
-            gRideRatingsCalcData.proximity_x = x;
-            gRideRatingsCalcData.proximity_y = y;
-            gRideRatingsCalcData.proximity_z = z;
-            gRideRatingsCalcData.proximity_track_type = 255;
-            gRideRatingsCalcData.proximity_start_x = x;
-            gRideRatingsCalcData.proximity_start_y = y;
-            gRideRatingsCalcData.proximity_start_z = z;
+            calcData->proximity_x = x;
+            calcData->proximity_y = y;
+            calcData->proximity_z = z;
+            calcData->proximity_track_type = 255;
+            calcData->proximity_start_x = x;
+            calcData->proximity_start_y = y;
+            calcData->proximity_start_z = z;
             return;
         }
     }
 
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    calcData->state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
-static void proximity_score_increment(int32_t type)
+static void proximity_score_increment(rct_ride_rating_calc_data * calcData, int32_t type)
 {
-    gRideRatingsCalcData.proximity_scores[type]++;
+    calcData->proximity_scores[type]++;
 }
 
 /**
  *
  *  rct2: 0x006B6207
  */
-static void ride_ratings_score_close_proximity_in_direction(rct_tile_element *inputTileElement, int32_t direction)
+static void ride_ratings_score_close_proximity_in_direction(rct_ride_rating_calc_data * calcData, rct_tile_element *inputTileElement, int32_t direction)
 {
-    int32_t x = gRideRatingsCalcData.proximity_x + CoordsDirectionDelta[direction].x;
-    int32_t y = gRideRatingsCalcData.proximity_y + CoordsDirectionDelta[direction].y;
+    int32_t x = calcData->proximity_x + CoordsDirectionDelta[direction].x;
+    int32_t y = calcData->proximity_y + CoordsDirectionDelta[direction].y;
     if (x < 0 || y < 0 || x >= (32 * 256) || y >= (32 * 256))
         return;
 
@@ -390,21 +517,21 @@ static void ride_ratings_score_close_proximity_in_direction(rct_tile_element *in
     do {
         switch (tileElement->GetType()) {
         case TILE_ELEMENT_TYPE_SURFACE:
-            if (gRideRatingsCalcData.proximity_base_height <= inputTileElement->base_height) {
+            if (calcData->proximity_base_height <= inputTileElement->base_height) {
                 if (inputTileElement->clearance_height <= tileElement->base_height) {
-                    proximity_score_increment(PROXIMITY_SURFACE_SIDE_CLOSE);
+                    proximity_score_increment(calcData, PROXIMITY_SURFACE_SIDE_CLOSE);
                 }
             }
             break;
         case TILE_ELEMENT_TYPE_PATH:
             if (abs((int32_t)inputTileElement->base_height - (int32_t)tileElement->base_height) <= 2) {
-                proximity_score_increment(PROXIMITY_PATH_SIDE_CLOSE);
+                proximity_score_increment(calcData, PROXIMITY_PATH_SIDE_CLOSE);
             }
             break;
         case TILE_ELEMENT_TYPE_TRACK:
             if (track_element_get_ride_index(inputTileElement) != track_element_get_ride_index(tileElement)) {
                 if (abs((int32_t)inputTileElement->base_height - (int32_t)tileElement->base_height) <= 2) {
-                    proximity_score_increment(PROXIMITY_FOREIGN_TRACK_SIDE_CLOSE);
+                    proximity_score_increment(calcData, PROXIMITY_FOREIGN_TRACK_SIDE_CLOSE);
                 }
             }
             break;
@@ -412,9 +539,9 @@ static void ride_ratings_score_close_proximity_in_direction(rct_tile_element *in
         case TILE_ELEMENT_TYPE_LARGE_SCENERY:
             if (tileElement->base_height < inputTileElement->clearance_height) {
                 if (inputTileElement->base_height > tileElement->clearance_height) {
-                    proximity_score_increment(PROXIMITY_SCENERY_SIDE_ABOVE);
+                    proximity_score_increment(calcData, PROXIMITY_SCENERY_SIDE_ABOVE);
                 } else {
-                    proximity_score_increment(PROXIMITY_SCENERY_SIDE_BELOW);
+                    proximity_score_increment(calcData, PROXIMITY_SCENERY_SIDE_BELOW);
                 }
             }
             break;
@@ -423,7 +550,7 @@ static void ride_ratings_score_close_proximity_in_direction(rct_tile_element *in
 
 }
 
-static void ride_ratings_score_close_proximity_loops_helper(rct_tile_element *inputTileElement, int32_t x, int32_t y)
+static void ride_ratings_score_close_proximity_loops_helper(rct_ride_rating_calc_data * calcData, rct_tile_element *inputTileElement, int32_t x, int32_t y)
 {
     rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
     do {
@@ -433,7 +560,7 @@ static void ride_ratings_score_close_proximity_loops_helper(rct_tile_element *in
             int32_t zDiff = (int32_t)tileElement->base_height - (int32_t)inputTileElement->base_height;
             if (zDiff >= 0 && zDiff <= 16)
             {
-                proximity_score_increment(PROXIMITY_PATH_TROUGH_VERTICAL_LOOP);
+                proximity_score_increment(calcData, PROXIMITY_PATH_TROUGH_VERTICAL_LOOP);
             }
         } break;
 
@@ -445,11 +572,11 @@ static void ride_ratings_score_close_proximity_loops_helper(rct_tile_element *in
                 int32_t zDiff = (int32_t)tileElement->base_height - (int32_t)inputTileElement->base_height;
                 if (zDiff >= 0 && zDiff <= 16)
                 {
-                    proximity_score_increment(PROXIMITY_TRACK_THROUGH_VERTICAL_LOOP);
+                    proximity_score_increment(calcData, PROXIMITY_TRACK_THROUGH_VERTICAL_LOOP);
                     if (track_element_get_type(tileElement) == TRACK_ELEM_LEFT_VERTICAL_LOOP ||
                         track_element_get_type(tileElement) == TRACK_ELEM_RIGHT_VERTICAL_LOOP)
                     {
-                        proximity_score_increment(PROXIMITY_INTERSECTING_VERTICAL_LOOP);
+                        proximity_score_increment(calcData, PROXIMITY_INTERSECTING_VERTICAL_LOOP);
                     }
                 }
             }
@@ -462,18 +589,18 @@ static void ride_ratings_score_close_proximity_loops_helper(rct_tile_element *in
  *
  *  rct2: 0x006B62DA
  */
-static void ride_ratings_score_close_proximity_loops(rct_tile_element *inputTileElement)
+static void ride_ratings_score_close_proximity_loops(rct_ride_rating_calc_data * calcData, rct_tile_element *inputTileElement)
 {
     int32_t trackType = track_element_get_type(inputTileElement);
     if (trackType == TRACK_ELEM_LEFT_VERTICAL_LOOP || trackType == TRACK_ELEM_RIGHT_VERTICAL_LOOP) {
-        int32_t x = gRideRatingsCalcData.proximity_x;
-        int32_t y = gRideRatingsCalcData.proximity_y;
-        ride_ratings_score_close_proximity_loops_helper(inputTileElement, x, y);
+        int32_t x = calcData->proximity_x;
+        int32_t y = calcData->proximity_y;
+        ride_ratings_score_close_proximity_loops_helper(calcData, inputTileElement, x, y);
 
         int32_t direction = tile_element_get_direction(inputTileElement);
-        x = gRideRatingsCalcData.proximity_x + CoordsDirectionDelta[direction].x;
-        y = gRideRatingsCalcData.proximity_y + CoordsDirectionDelta[direction].y;
-        ride_ratings_score_close_proximity_loops_helper(inputTileElement, x, y);
+        x = calcData->proximity_x + CoordsDirectionDelta[direction].x;
+        y = calcData->proximity_y + CoordsDirectionDelta[direction].y;
+        ride_ratings_score_close_proximity_loops_helper(calcData, inputTileElement, x, y);
     }
 }
 
@@ -481,39 +608,39 @@ static void ride_ratings_score_close_proximity_loops(rct_tile_element *inputTile
  *
  *  rct2: 0x006B5F9D
  */
-static void ride_ratings_score_close_proximity(rct_tile_element *inputTileElement)
+static void ride_ratings_score_close_proximity(rct_ride_rating_calc_data * calcData, rct_tile_element *inputTileElement)
 {
-    if (gRideRatingsCalcData.station_flags & RIDE_RATING_STATION_FLAG_NO_ENTRANCE) {
+    if (calcData->station_flags & RIDE_RATING_STATION_FLAG_NO_ENTRANCE) {
         return;
     }
 
-    gRideRatingsCalcData.proximity_total++;
-    int32_t x = gRideRatingsCalcData.proximity_x;
-    int32_t y = gRideRatingsCalcData.proximity_y;
+    calcData->proximity_total++;
+    int32_t x = calcData->proximity_x;
+    int32_t y = calcData->proximity_y;
     rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
     do {
         int32_t waterHeight;
         switch (tileElement->GetType()) {
         case TILE_ELEMENT_TYPE_SURFACE:
-            gRideRatingsCalcData.proximity_base_height = tileElement->base_height;
-            if (tileElement->base_height * 8 == gRideRatingsCalcData.proximity_z) {
-                proximity_score_increment(PROXIMITY_SURFACE_TOUCH);
+            calcData->proximity_base_height = tileElement->base_height;
+            if (tileElement->base_height * 8 == calcData->proximity_z) {
+                proximity_score_increment(calcData, PROXIMITY_SURFACE_TOUCH);
             }
             waterHeight = surface_get_water_height(tileElement);
             if (waterHeight != 0) {
                 int32_t z = waterHeight * 16;
-                if (z <= gRideRatingsCalcData.proximity_z) {
-                    proximity_score_increment(PROXIMITY_WATER_OVER);
-                    if (z == gRideRatingsCalcData.proximity_z) {
-                        proximity_score_increment(PROXIMITY_WATER_TOUCH);
+                if (z <= calcData->proximity_z) {
+                    proximity_score_increment(calcData, PROXIMITY_WATER_OVER);
+                    if (z == calcData->proximity_z) {
+                        proximity_score_increment(calcData, PROXIMITY_WATER_TOUCH);
                     }
                     z += 16;
-                    if (z == gRideRatingsCalcData.proximity_z) {
-                        proximity_score_increment(PROXIMITY_WATER_LOW);
+                    if (z == calcData->proximity_z) {
+                        proximity_score_increment(calcData, PROXIMITY_WATER_LOW);
                     }
                     z += 112;
-                    if (z <= gRideRatingsCalcData.proximity_z) {
-                        proximity_score_increment(PROXIMITY_WATER_HIGH);
+                    if (z <= calcData->proximity_z) {
+                        proximity_score_increment(calcData, PROXIMITY_WATER_HIGH);
                     }
                 }
             }
@@ -522,21 +649,21 @@ static void ride_ratings_score_close_proximity(rct_tile_element *inputTileElemen
             // Bonus for normal path
             if (footpath_element_get_type(tileElement) != 0) {
                 if (tileElement->clearance_height == inputTileElement->base_height) {
-                    proximity_score_increment(PROXIMITY_PATH_TOUCH_ABOVE);
+                    proximity_score_increment(calcData, PROXIMITY_PATH_TOUCH_ABOVE);
                 }
                 if (tileElement->base_height == inputTileElement->clearance_height) {
-                    proximity_score_increment(PROXIMITY_PATH_TOUCH_UNDER);
+                    proximity_score_increment(calcData, PROXIMITY_PATH_TOUCH_UNDER);
                 }
             } else {
                 // Bonus for path in first object entry
                 if (tileElement->clearance_height <= inputTileElement->base_height) {
-                    proximity_score_increment(PROXIMITY_PATH_ZERO_OVER);
+                    proximity_score_increment(calcData, PROXIMITY_PATH_ZERO_OVER);
                 }
                 if (tileElement->clearance_height == inputTileElement->base_height) {
-                    proximity_score_increment(PROXIMITY_PATH_ZERO_TOUCH_ABOVE);
+                    proximity_score_increment(calcData, PROXIMITY_PATH_ZERO_TOUCH_ABOVE);
                 }
                 if (tileElement->base_height == inputTileElement->clearance_height) {
-                    proximity_score_increment(PROXIMITY_PATH_ZERO_TOUCH_UNDER);
+                    proximity_score_increment(calcData, PROXIMITY_PATH_ZERO_TOUCH_UNDER);
                 }
             }
             break;
@@ -547,26 +674,26 @@ static void ride_ratings_score_close_proximity(rct_tile_element *inputTileElemen
                 int32_t sequence = tile_element_get_track_sequence(tileElement);
                 if (sequence == 3 || sequence == 6) {
                     if (tileElement->base_height - inputTileElement->clearance_height <= 10) {
-                        proximity_score_increment(PROXIMITY_THROUGH_VERTICAL_LOOP);
+                        proximity_score_increment(calcData, PROXIMITY_THROUGH_VERTICAL_LOOP);
                     }
                 }
             }
             if (track_element_get_ride_index(inputTileElement) != track_element_get_ride_index(tileElement)) {
-                proximity_score_increment(PROXIMITY_FOREIGN_TRACK_ABOVE_OR_BELOW);
+                proximity_score_increment(calcData, PROXIMITY_FOREIGN_TRACK_ABOVE_OR_BELOW);
                 if (tileElement->clearance_height == inputTileElement->base_height) {
-                    proximity_score_increment(PROXIMITY_FOREIGN_TRACK_TOUCH_ABOVE);
+                    proximity_score_increment(calcData, PROXIMITY_FOREIGN_TRACK_TOUCH_ABOVE);
                 }
                 if (tileElement->clearance_height + 2 <= inputTileElement->base_height) {
                     if (tileElement->clearance_height + 10 >= inputTileElement->base_height) {
-                        proximity_score_increment(PROXIMITY_FOREIGN_TRACK_CLOSE_ABOVE);
+                        proximity_score_increment(calcData, PROXIMITY_FOREIGN_TRACK_CLOSE_ABOVE);
                     }
                 }
                 if (inputTileElement->clearance_height == tileElement->base_height) {
-                    proximity_score_increment(PROXIMITY_FOREIGN_TRACK_TOUCH_ABOVE);
+                    proximity_score_increment(calcData, PROXIMITY_FOREIGN_TRACK_TOUCH_ABOVE);
                 }
                 if (inputTileElement->clearance_height + 2 == tileElement->base_height) {
                     if ((uint8_t)(inputTileElement->clearance_height + 10) >= tileElement->base_height) {
-                        proximity_score_increment(PROXIMITY_FOREIGN_TRACK_CLOSE_ABOVE);
+                        proximity_score_increment(calcData, PROXIMITY_FOREIGN_TRACK_CLOSE_ABOVE);
                     }
                 }
             } else {
@@ -577,31 +704,31 @@ static void ride_ratings_score_close_proximity(rct_tile_element *inputTileElemen
                     trackType == TRACK_ELEM_BEGIN_STATION
                 );
                 if (tileElement->clearance_height == inputTileElement->base_height) {
-                    proximity_score_increment(PROXIMITY_OWN_TRACK_TOUCH_ABOVE);
+                    proximity_score_increment(calcData, PROXIMITY_OWN_TRACK_TOUCH_ABOVE);
                     if (isStation) {
-                        proximity_score_increment(PROXIMITY_OWN_STATION_TOUCH_ABOVE);
+                        proximity_score_increment(calcData, PROXIMITY_OWN_STATION_TOUCH_ABOVE);
                     }
                 }
                 if (tileElement->clearance_height + 2 <= inputTileElement->base_height) {
                     if (tileElement->clearance_height + 10 >= inputTileElement->base_height) {
-                        proximity_score_increment(PROXIMITY_OWN_TRACK_CLOSE_ABOVE);
+                        proximity_score_increment(calcData, PROXIMITY_OWN_TRACK_CLOSE_ABOVE);
                         if (isStation) {
-                            proximity_score_increment(PROXIMITY_OWN_STATION_CLOSE_ABOVE);
+                            proximity_score_increment(calcData, PROXIMITY_OWN_STATION_CLOSE_ABOVE);
                         }
                     }
                 }
 
                 if (inputTileElement->clearance_height == tileElement->base_height) {
-                    proximity_score_increment(PROXIMITY_OWN_TRACK_TOUCH_ABOVE);
+                    proximity_score_increment(calcData, PROXIMITY_OWN_TRACK_TOUCH_ABOVE);
                     if (isStation) {
-                        proximity_score_increment(PROXIMITY_OWN_STATION_TOUCH_ABOVE);
+                        proximity_score_increment(calcData, PROXIMITY_OWN_STATION_TOUCH_ABOVE);
                     }
                 }
                 if (inputTileElement->clearance_height + 2 <= tileElement->base_height) {
                     if (inputTileElement->clearance_height + 10 >= tileElement->base_height) {
-                        proximity_score_increment(PROXIMITY_OWN_TRACK_CLOSE_ABOVE);
+                        proximity_score_increment(calcData, PROXIMITY_OWN_TRACK_CLOSE_ABOVE);
                         if (isStation) {
-                            proximity_score_increment(PROXIMITY_OWN_STATION_CLOSE_ABOVE);
+                            proximity_score_increment(calcData, PROXIMITY_OWN_STATION_CLOSE_ABOVE);
                         }
                     }
                 }
@@ -611,26 +738,26 @@ static void ride_ratings_score_close_proximity(rct_tile_element *inputTileElemen
     } while (!(tileElement++)->IsLastForTile());
 
     uint8_t direction = tile_element_get_direction(inputTileElement);
-    ride_ratings_score_close_proximity_in_direction(inputTileElement, (direction + 1) & 3);
-    ride_ratings_score_close_proximity_in_direction(inputTileElement, (direction - 1) & 3);
-    ride_ratings_score_close_proximity_loops(inputTileElement);
+    ride_ratings_score_close_proximity_in_direction(calcData, inputTileElement, (direction + 1) & 3);
+    ride_ratings_score_close_proximity_in_direction(calcData, inputTileElement, (direction - 1) & 3);
+    ride_ratings_score_close_proximity_loops(calcData, inputTileElement);
 
-    switch (gRideRatingsCalcData.proximity_track_type) {
+    switch (calcData->proximity_track_type) {
     case TRACK_ELEM_BRAKES:
-        gRideRatingsCalcData.num_brakes++;
+        calcData->num_brakes++;
         break;
     case TRACK_ELEM_LEFT_REVERSER:
     case TRACK_ELEM_RIGHT_REVERSER:
-        gRideRatingsCalcData.num_reversers++;
+        calcData->num_reversers++;
         break;
     }
 }
 
-static void ride_ratings_calculate(Ride *ride)
+static void ride_ratings_calculate(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     auto calcFunc = ride_ratings_get_calculate_func(ride->type);
     if (calcFunc != nullptr) {
-        calcFunc(ride);
+        calcFunc(ride, calcData);
     }
 
 #ifdef ORIGINAL_RATINGS
@@ -736,7 +863,7 @@ static void ride_ratings_calculate_value(Ride *ride)
  * inputs
  * - edi: ride ptr
  */
-static uint16_t ride_compute_upkeep(Ride *ride)
+static uint16_t ride_compute_upkeep(Ride *ride, const rct_ride_rating_calc_data * calcData)
 {
     // data stored at 0x0057E3A8, incrementing 18 bytes at a time
     uint16_t upkeep = initialUpkeepCosts[ride->type];
@@ -772,10 +899,10 @@ static uint16_t ride_compute_upkeep(Ride *ride)
     if (ride->type == RIDE_TYPE_REVERSER_ROLLER_COASTER) {
         reverserMaintenanceCost = 10;
     }
-    upkeep += reverserMaintenanceCost * gRideRatingsCalcData.num_reversers;
+    upkeep += reverserMaintenanceCost * calcData->num_reversers;
 
     // Add maintenance cost for brake track pieces
-    upkeep += 20 * gRideRatingsCalcData.num_brakes;
+    upkeep += 20 * calcData->num_brakes;
 
     // these seem to be adhoc adjustments to a ride's upkeep/cost, times
     // various variables set on the ride itself.
@@ -916,9 +1043,9 @@ static uint32_t get_proximity_score_helper_3(uint16_t x, uint16_t resultIfNotZer
  *
  *  rct2: 0x0065E277
  */
-static uint32_t ride_ratings_get_proximity_score()
+static uint32_t ride_ratings_get_proximity_score(const rct_ride_rating_calc_data * calcData)
 {
-    const uint16_t * scores = gRideRatingsCalcData.proximity_scores;
+    const uint16_t * scores = calcData->proximity_scores;
 
     uint32_t result = 0;
     result += get_proximity_score_helper_1(scores[PROXIMITY_WATER_OVER                  ]    ,      60, 0x00AAAA);
@@ -1436,10 +1563,10 @@ static void ride_ratings_apply_rotations(rating_tuple *ratings, Ride *ride, int3
         ride->rotations * nauseaMultiplier);
 }
 
-static void ride_ratings_apply_proximity(rating_tuple *ratings, int32_t excitementMultiplier)
+static void ride_ratings_apply_proximity(rating_tuple *ratings, const rct_ride_rating_calc_data * calcData, int32_t excitementMultiplier)
 {
     ride_ratings_add(ratings,
-        (ride_ratings_get_proximity_score() * excitementMultiplier) >> 16,
+        (ride_ratings_get_proximity_score(calcData) * excitementMultiplier) >> 16,
         0,
         0);
 }
@@ -1523,7 +1650,7 @@ static void ride_ratings_apply_first_length_penalty(rating_tuple *ratings, Ride
 
 #pragma region Ride rating calculation functions
 
-static void ride_ratings_calculate_spiral_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_spiral_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1543,7 +1670,7 @@ static void ride_ratings_calculate_spiral_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 28235, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 43690, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if ((ride->inversions & 0x1F) == 0)
@@ -1562,14 +1689,14 @@ static void ride_ratings_calculate_spiral_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_stand_up_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_stand_up_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1589,7 +1716,7 @@ static void ride_ratings_calculate_stand_up_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 34952, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 12850, 28398, 30427);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(&ratings, calcData, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 12, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -1601,14 +1728,14 @@ static void ride_ratings_calculate_stand_up_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_suspended_swinging_coaster(Ride *ride)
+static void ride_ratings_calculate_suspended_swinging_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1628,7 +1755,7 @@ static void ride_ratings_calculate_suspended_swinging_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 48036);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6971);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xC0000, 2, 2, 2);
@@ -1642,14 +1769,14 @@ static void ride_ratings_calculate_suspended_swinging_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_inverted_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_inverted_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1669,7 +1796,7 @@ static void ride_ratings_calculate_inverted_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 29552, 57186);
     ride_ratings_apply_drops(&ratings, ride, 29127, 39009, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 15291, 35108);
-    ride_ratings_apply_proximity(&ratings, 15657);
+    ride_ratings_apply_proximity(&ratings, calcData, 15657);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
 
     if ((ride->inversions & 0x1F) == 0)
@@ -1686,14 +1813,14 @@ static void ride_ratings_calculate_inverted_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_junior_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_junior_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1713,7 +1840,7 @@ static void ride_ratings_calculate_junior_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -1725,14 +1852,14 @@ static void ride_ratings_calculate_junior_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_miniature_railway(Ride *ride)
+static void ride_ratings_calculate_miniature_railway(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1748,7 +1875,7 @@ static void ride_ratings_calculate_miniature_railway(Ride *ride)
     ride_ratings_apply_average_speed(&ratings, ride, 291271, 436906);
     ride_ratings_apply_duration(&ratings, ride, 150, 26214);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, -6425, 6553, 23405);
-    ride_ratings_apply_proximity(&ratings, 8946);
+    ride_ratings_apply_proximity(&ratings, calcData, 8946);
     ride_ratings_apply_scenery(&ratings, ride, 20915);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xC80000, 2, 2, 2);
 
@@ -1757,7 +1884,7 @@ static void ride_ratings_calculate_miniature_railway(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     int32_t edx = get_num_of_sheltered_eighths(ride);
@@ -1768,7 +1895,7 @@ static void ride_ratings_calculate_miniature_railway(Ride *ride)
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_monorail(Ride *ride)
+static void ride_ratings_calculate_monorail(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1784,7 +1911,7 @@ static void ride_ratings_calculate_monorail(Ride *ride)
     ride_ratings_apply_average_speed(&ratings, ride, 291271, 218453);
     ride_ratings_apply_duration(&ratings, ride, 150, 21845);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 5140, 6553, 18724);
-    ride_ratings_apply_proximity(&ratings, 8946);
+    ride_ratings_apply_proximity(&ratings, calcData, 8946);
     ride_ratings_apply_scenery(&ratings, ride, 16732);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xAA0000, 2, 2, 2);
 
@@ -1793,7 +1920,7 @@ static void ride_ratings_calculate_monorail(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     int32_t edx = get_num_of_sheltered_eighths(ride);
@@ -1804,7 +1931,7 @@ static void ride_ratings_calculate_monorail(Ride *ride)
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_mini_suspended_coaster(Ride *ride)
+static void ride_ratings_calculate_mini_suspended_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1824,7 +1951,7 @@ static void ride_ratings_calculate_mini_suspended_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 34179, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 58254, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 19275, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 13943);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x80000, 2, 2, 2);
@@ -1837,14 +1964,14 @@ static void ride_ratings_calculate_mini_suspended_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_boat_hire(Ride *ride)
+static void ride_ratings_calculate_boat_hire(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->unreliability_factor = 7;
     set_unreliability_factor(ride);
@@ -1861,7 +1988,7 @@ static void ride_ratings_calculate_boat_hire(Ride *ride)
         ride_ratings_add(&ratings, RIDE_RATING(0,20), 0, 0);
     }
 
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(&ratings, calcData, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 22310);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -1869,14 +1996,14 @@ static void ride_ratings_calculate_boat_hire(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 0 << 5;
 }
 
-static void ride_ratings_calculate_wooden_wild_mouse(Ride *ride)
+static void ride_ratings_calculate_wooden_wild_mouse(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1896,7 +2023,7 @@ static void ride_ratings_calculate_wooden_wild_mouse(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(&ratings, calcData, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -1911,14 +2038,14 @@ static void ride_ratings_calculate_wooden_wild_mouse(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_steeplechase(Ride *ride)
+static void ride_ratings_calculate_steeplechase(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1938,7 +2065,7 @@ static void ride_ratings_calculate_steeplechase(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 4, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x80000, 2, 2, 2);
@@ -1952,14 +2079,14 @@ static void ride_ratings_calculate_steeplechase(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_car_ride(Ride *ride)
+static void ride_ratings_calculate_car_ride(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1978,7 +2105,7 @@ static void ride_ratings_calculate_car_ride(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 11437);
     ride_ratings_apply_drops(&ratings, ride, 8738, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 12850, 6553, 4681);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(&ratings, calcData, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xC80000, 8, 2, 2);
 
@@ -1987,14 +2114,14 @@ static void ride_ratings_calculate_car_ride(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_launched_freefall(Ride *ride)
+static void ride_ratings_calculate_launched_freefall(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2030,7 +2157,7 @@ static void ride_ratings_calculate_launched_freefall(Ride *ride)
     }
 #endif
 
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 25098);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -2038,14 +2165,14 @@ static void ride_ratings_calculate_launched_freefall(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_bobsleigh_coaster(Ride *ride)
+static void ride_ratings_calculate_bobsleigh_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2065,7 +2192,7 @@ static void ride_ratings_calculate_bobsleigh_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xC0000, 2, 2, 2);
     ride_ratings_apply_max_lateral_g_penalty(&ratings, ride, FIXED_2DP(1,20), 2, 2, 2);
@@ -2077,14 +2204,14 @@ static void ride_ratings_calculate_bobsleigh_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_observation_tower(Ride *ride)
+static void ride_ratings_calculate_observation_tower(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2098,7 +2225,7 @@ static void ride_ratings_calculate_observation_tower(Ride *ride)
         ((ride_get_total_length(ride) >> 16) * 45875) >> 16,
         0,
         ((ride_get_total_length(ride) >> 16) * 26214) >> 16);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 83662);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -2106,7 +2233,7 @@ static void ride_ratings_calculate_observation_tower(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
@@ -2117,7 +2244,7 @@ static void ride_ratings_calculate_observation_tower(Ride *ride)
         ride->excitement /= 4;
 }
 
-static void ride_ratings_calculate_looping_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_looping_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2137,7 +2264,7 @@ static void ride_ratings_calculate_looping_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if ((ride->inversions & 0x1F) == 0)
@@ -2156,14 +2283,14 @@ static void ride_ratings_calculate_looping_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_dinghy_slide(Ride *ride)
+static void ride_ratings_calculate_dinghy_slide(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2183,7 +2310,7 @@ static void ride_ratings_calculate_dinghy_slide(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(&ratings, calcData, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 12, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -2195,14 +2322,14 @@ static void ride_ratings_calculate_dinghy_slide(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_mine_train_coaster(Ride *ride)
+static void ride_ratings_calculate_mine_train_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2222,7 +2349,7 @@ static void ride_ratings_calculate_mine_train_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 19275, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 21472);
+    ride_ratings_apply_proximity(&ratings, calcData, 21472);
     ride_ratings_apply_scenery(&ratings, ride, 16732);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -2236,14 +2363,14 @@ static void ride_ratings_calculate_mine_train_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_chairlift(Ride *ride)
+static void ride_ratings_calculate_chairlift(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2260,7 +2387,7 @@ static void ride_ratings_calculate_chairlift(Ride *ride)
     ride_ratings_apply_duration(&ratings, ride, 150, 26214);
     ride_ratings_apply_turns(&ratings, ride, 7430, 3476, 4574);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, -19275, 21845, 23405);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(&ratings, calcData, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 25098);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0x960000, 2, 2, 2);
 
@@ -2274,7 +2401,7 @@ static void ride_ratings_calculate_chairlift(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     int32_t edx = get_num_of_sheltered_eighths(ride);
@@ -2285,7 +2412,7 @@ static void ride_ratings_calculate_chairlift(Ride *ride)
     ride->inversions |= edx << 5;
 }
 
-static void ride_ratings_calculate_corkscrew_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_corkscrew_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2305,7 +2432,7 @@ static void ride_ratings_calculate_corkscrew_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if ((ride->inversions & 0x1F) == 0)
@@ -2324,14 +2451,14 @@ static void ride_ratings_calculate_corkscrew_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_maze(Ride *ride)
+static void ride_ratings_calculate_maze(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2354,14 +2481,14 @@ static void ride_ratings_calculate_maze(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 0 << 5;
 }
 
-static void ride_ratings_calculate_spiral_slide(Ride *ride)
+static void ride_ratings_calculate_spiral_slide(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2386,14 +2513,14 @@ static void ride_ratings_calculate_spiral_slide(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 2 << 5;
 }
 
-static void ride_ratings_calculate_go_karts(Ride *ride)
+static void ride_ratings_calculate_go_karts(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2421,7 +2548,7 @@ static void ride_ratings_calculate_go_karts(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 4458, 3476, 5718);
     ride_ratings_apply_drops(&ratings, ride, 8738, 5461, 6553);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 2570, 8738, 2340);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(&ratings, calcData, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 16732);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -2429,7 +2556,7 @@ static void ride_ratings_calculate_go_karts(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     int32_t edx = get_num_of_sheltered_eighths(ride);
@@ -2441,7 +2568,7 @@ static void ride_ratings_calculate_go_karts(Ride *ride)
         ride->excitement /= 2;
 }
 
-static void ride_ratings_calculate_log_flume(Ride *ride)
+static void ride_ratings_calculate_log_flume(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2458,7 +2585,7 @@ static void ride_ratings_calculate_log_flume(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 22291, 20860, 4574);
     ride_ratings_apply_drops(&ratings, ride, 69905, 62415, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(&ratings, calcData, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 2, 2, 2, 2);
 
@@ -2467,14 +2594,14 @@ static void ride_ratings_calculate_log_flume(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_river_rapids(Ride *ride)
+static void ride_ratings_calculate_river_rapids(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2491,7 +2618,7 @@ static void ride_ratings_calculate_river_rapids(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 22598, 5718);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 31314);
+    ride_ratings_apply_proximity(&ratings, calcData, 31314);
     ride_ratings_apply_scenery(&ratings, ride, 13943);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 2, 2, 2, 2);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xC80000, 2, 2, 2);
@@ -2501,14 +2628,14 @@ static void ride_ratings_calculate_river_rapids(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_dodgems(Ride *ride)
+static void ride_ratings_calculate_dodgems(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2544,14 +2671,14 @@ static void ride_ratings_calculate_dodgems(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 7 << 5;
 }
 
-static void ride_ratings_calculate_pirate_ship(Ride *ride)
+static void ride_ratings_calculate_pirate_ship(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2573,14 +2700,14 @@ static void ride_ratings_calculate_pirate_ship(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 0 << 5;
 }
 
-static void ride_ratings_calculate_inverter_ship(Ride *ride)
+static void ride_ratings_calculate_inverter_ship(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2602,32 +2729,32 @@ static void ride_ratings_calculate_inverter_ship(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 0 << 5;
 }
 
-static void ride_ratings_calculate_food_stall(Ride *ride)
+static void ride_ratings_calculate_food_stall(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_drink_stall(Ride *ride)
+static void ride_ratings_calculate_drink_stall(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_shop(Ride *ride)
+static void ride_ratings_calculate_shop(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_merry_go_round(Ride *ride)
+static void ride_ratings_calculate_merry_go_round(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2643,26 +2770,26 @@ static void ride_ratings_calculate_merry_go_round(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 7 << 5;
 }
 
-static void ride_ratings_calculate_information_kiosk(Ride *ride)
+static void ride_ratings_calculate_information_kiosk(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_toilets(Ride *ride)
+static void ride_ratings_calculate_toilets(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_ferris_wheel(Ride *ride)
+static void ride_ratings_calculate_ferris_wheel(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2678,14 +2805,14 @@ static void ride_ratings_calculate_ferris_wheel(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 0 << 5;
 }
 
-static void ride_ratings_calculate_motion_simulator(Ride *ride)
+static void ride_ratings_calculate_motion_simulator(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2709,14 +2836,14 @@ static void ride_ratings_calculate_motion_simulator(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 7 << 5;
 }
 
-static void ride_ratings_calculate_3d_cinema(Ride *ride)
+static void ride_ratings_calculate_3d_cinema(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2749,14 +2876,14 @@ static void ride_ratings_calculate_3d_cinema(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 7 << 5;
 }
 
-static void ride_ratings_calculate_top_spin(Ride *ride)
+static void ride_ratings_calculate_top_spin(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2791,14 +2918,14 @@ static void ride_ratings_calculate_top_spin(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 0 << 5;
 }
 
-static void ride_ratings_calculate_space_rings(Ride *ride)
+static void ride_ratings_calculate_space_rings(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2814,14 +2941,14 @@ static void ride_ratings_calculate_space_rings(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 0 << 5;
 }
 
-static void ride_ratings_calculate_reverse_freefall_coaster(Ride *ride)
+static void ride_ratings_calculate_reverse_freefall_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2836,7 +2963,7 @@ static void ride_ratings_calculate_reverse_freefall_coaster(Ride *ride)
     ride_ratings_apply_max_speed(&ratings, ride, 436906, 436906, 320398);
     ride_ratings_apply_gforces(&ratings, ride, 24576, 41704, 59578);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 12850, 28398, 11702);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(&ratings, calcData, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 34, 2, 2, 2);
 
@@ -2845,14 +2972,14 @@ static void ride_ratings_calculate_reverse_freefall_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_lift(Ride *ride)
+static void ride_ratings_calculate_lift(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     int32_t totalLength;
 
@@ -2871,7 +2998,7 @@ static void ride_ratings_calculate_lift(Ride *ride)
         0,
         (totalLength * 26214) >> 16);
 
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(&ratings, calcData, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 83662);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -2879,7 +3006,7 @@ static void ride_ratings_calculate_lift(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
@@ -2889,7 +3016,7 @@ static void ride_ratings_calculate_lift(Ride *ride)
         ride->excitement /= 4;
 }
 
-static void ride_ratings_calculate_vertical_drop_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_vertical_drop_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2908,7 +3035,7 @@ static void ride_ratings_calculate_vertical_drop_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 58254, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 20, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -2921,20 +3048,20 @@ static void ride_ratings_calculate_vertical_drop_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_cash_machine(Ride *ride)
+static void ride_ratings_calculate_cash_machine(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_twist(Ride *ride)
+static void ride_ratings_calculate_twist(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2950,14 +3077,14 @@ static void ride_ratings_calculate_twist(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 0 << 5;
 }
 
-static void ride_ratings_calculate_haunted_house(Ride *ride)
+static void ride_ratings_calculate_haunted_house(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2975,14 +3102,14 @@ static void ride_ratings_calculate_haunted_house(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 0xE0;
 }
 
-static void ride_ratings_calculate_flying_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_flying_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3002,7 +3129,7 @@ static void ride_ratings_calculate_flying_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if ((ride->inversions & 0x1F) == 0)
@@ -3021,14 +3148,14 @@ static void ride_ratings_calculate_flying_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_virginia_reel(Ride *ride)
+static void ride_ratings_calculate_virginia_reel(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3048,7 +3175,7 @@ static void ride_ratings_calculate_virginia_reel(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 52012, 26075, 45749);
     ride_ratings_apply_drops(&ratings, ride, 43690, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(&ratings, calcData, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xD20000, 2, 2, 2);
     ride_ratings_apply_num_drops_penalty(&ratings, ride, 2, 2, 2, 2);
@@ -3059,14 +3186,14 @@ static void ride_ratings_calculate_virginia_reel(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_splash_boats(Ride *ride)
+static void ride_ratings_calculate_splash_boats(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3083,7 +3210,7 @@ static void ride_ratings_calculate_splash_boats(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 22291, 20860, 4574);
     ride_ratings_apply_drops(&ratings, ride, 87381, 93622, 62259);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(&ratings, calcData, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
 
@@ -3092,14 +3219,14 @@ static void ride_ratings_calculate_splash_boats(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_mini_helicopters(Ride *ride)
+static void ride_ratings_calculate_mini_helicopters(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3118,7 +3245,7 @@ static void ride_ratings_calculate_mini_helicopters(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 4574);
     ride_ratings_apply_drops(&ratings, ride, 8738, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 12850, 6553, 4681);
-    ride_ratings_apply_proximity(&ratings, 8946);
+    ride_ratings_apply_proximity(&ratings, calcData, 8946);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xA00000, 2, 2, 2);
 
@@ -3127,14 +3254,14 @@ static void ride_ratings_calculate_mini_helicopters(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 6 << 5;
 }
 
-static void ride_ratings_calculate_lay_down_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_lay_down_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3154,7 +3281,7 @@ static void ride_ratings_calculate_lay_down_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if ((ride->inversions & 0x1F) == 0) {
@@ -3176,14 +3303,14 @@ static void ride_ratings_calculate_lay_down_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_suspended_monorail(Ride *ride)
+static void ride_ratings_calculate_suspended_monorail(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3199,7 +3326,7 @@ static void ride_ratings_calculate_suspended_monorail(Ride *ride)
     ride_ratings_apply_average_speed(&ratings, ride, 291271, 218453);
     ride_ratings_apply_duration(&ratings, ride, 150, 21845);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 5140, 6553, 18724);
-    ride_ratings_apply_proximity(&ratings, 12525);
+    ride_ratings_apply_proximity(&ratings, calcData, 12525);
     ride_ratings_apply_scenery(&ratings, ride, 25098);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xAA0000, 2, 2, 2);
 
@@ -3208,7 +3335,7 @@ static void ride_ratings_calculate_suspended_monorail(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     int32_t edx = get_num_of_sheltered_eighths(ride);
@@ -3219,7 +3346,7 @@ static void ride_ratings_calculate_suspended_monorail(Ride *ride)
     ride->inversions |= edx << 5;
 }
 
-static void ride_ratings_calculate_reverser_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_reverser_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3235,7 +3362,7 @@ static void ride_ratings_calculate_reverser_roller_coaster(Ride *ride)
     ride_ratings_apply_max_speed(&ratings, ride, 44281, 88562, 35424);
     ride_ratings_apply_average_speed(&ratings, ride, 364088, 655360);
 
-    int32_t numReversers = std::min<uint16_t>(gRideRatingsCalcData.num_reversers, 6);
+    int32_t numReversers = std::min<uint16_t>(calcData->num_reversers, 6);
     ride_rating reverserRating = numReversers * RIDE_RATING(0,20);
     ride_ratings_add(&ratings,
         reverserRating,
@@ -3247,10 +3374,10 @@ static void ride_ratings_calculate_reverser_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(&ratings, calcData, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
 
-    if (gRideRatingsCalcData.num_reversers < 1) {
+    if (calcData->num_reversers < 1) {
         ratings.excitement /= 8;
     }
 
@@ -3263,14 +3390,14 @@ static void ride_ratings_calculate_reverser_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_heartline_twister_coaster(Ride *ride)
+static void ride_ratings_calculate_heartline_twister_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3290,7 +3417,7 @@ static void ride_ratings_calculate_heartline_twister_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 52150, 57186);
     ride_ratings_apply_drops(&ratings, ride, 29127, 53052, 55705);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 34952, 35108);
-    ride_ratings_apply_proximity(&ratings, 9841);
+    ride_ratings_apply_proximity(&ratings, calcData, 9841);
     ride_ratings_apply_scenery(&ratings, ride, 3904);
 
     if ((ride->inversions & 0x1F) == 0)
@@ -3304,14 +3431,14 @@ static void ride_ratings_calculate_heartline_twister_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_mini_golf(Ride *ride)
+static void ride_ratings_calculate_mini_golf(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3324,7 +3451,7 @@ static void ride_ratings_calculate_mini_golf(Ride *ride)
     ride_ratings_apply_length(&ratings, ride, 6000, 873);
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 5140, 6553, 4681);
-    ride_ratings_apply_proximity(&ratings, 15657);
+    ride_ratings_apply_proximity(&ratings, calcData, 15657);
     ride_ratings_apply_scenery(&ratings, ride, 27887);
 
     // Apply golf holes factor
@@ -3345,20 +3472,20 @@ static void ride_ratings_calculate_mini_golf(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_first_aid(Ride *ride)
+static void ride_ratings_calculate_first_aid(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_circus_show(Ride *ride)
+static void ride_ratings_calculate_circus_show(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3376,14 +3503,14 @@ static void ride_ratings_calculate_circus_show(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 7 << 5;
 }
 
-static void ride_ratings_calculate_ghost_train(Ride *ride)
+static void ride_ratings_calculate_ghost_train(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3401,7 +3528,7 @@ static void ride_ratings_calculate_ghost_train(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 11437);
     ride_ratings_apply_drops(&ratings, ride, 8738, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 6553, 4681);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(&ratings, calcData, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xB40000, 2, 2, 2);
 
@@ -3410,14 +3537,14 @@ static void ride_ratings_calculate_ghost_train(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_twister_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_twister_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3437,7 +3564,7 @@ static void ride_ratings_calculate_twister_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if ((ride->inversions & 0x1F) == 0)
@@ -3456,14 +3583,14 @@ static void ride_ratings_calculate_twister_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_wooden_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_wooden_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3483,7 +3610,7 @@ static void ride_ratings_calculate_wooden_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(&ratings, calcData, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 12, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -3497,14 +3624,14 @@ static void ride_ratings_calculate_wooden_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_side_friction_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_side_friction_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3524,7 +3651,7 @@ static void ride_ratings_calculate_side_friction_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(&ratings, calcData, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x50000, 2, 2, 2);
@@ -3537,14 +3664,14 @@ static void ride_ratings_calculate_side_friction_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_wild_mouse(Ride *ride)
+static void ride_ratings_calculate_wild_mouse(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3564,7 +3691,7 @@ static void ride_ratings_calculate_wild_mouse(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(&ratings, calcData, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -3578,14 +3705,14 @@ static void ride_ratings_calculate_wild_mouse(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_multi_dimension_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_multi_dimension_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3605,7 +3732,7 @@ static void ride_ratings_calculate_multi_dimension_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if ((ride->inversions & 0x1F) == 0)
@@ -3624,14 +3751,14 @@ static void ride_ratings_calculate_multi_dimension_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_giga_coaster(Ride *ride)
+static void ride_ratings_calculate_giga_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3651,7 +3778,7 @@ static void ride_ratings_calculate_giga_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 28235, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 43690, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if ((ride->inversions & 0x1F) == 0)
@@ -3670,14 +3797,14 @@ static void ride_ratings_calculate_giga_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_roto_drop(Ride *ride)
+static void ride_ratings_calculate_roto_drop(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3694,7 +3821,7 @@ static void ride_ratings_calculate_roto_drop(Ride *ride)
         lengthFactor * 2,
         lengthFactor * 2);
 
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(&ratings, calcData, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 25098);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -3702,14 +3829,14 @@ static void ride_ratings_calculate_roto_drop(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_flying_saucers(Ride *ride)
+static void ride_ratings_calculate_flying_saucers(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3748,14 +3875,14 @@ static void ride_ratings_calculate_flying_saucers(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 0 << 5;
 }
 
-static void ride_ratings_calculate_crooked_house(Ride *ride)
+static void ride_ratings_calculate_crooked_house(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3773,14 +3900,14 @@ static void ride_ratings_calculate_crooked_house(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 0xE0;
 }
 
-static void ride_ratings_calculate_monorail_cycles(Ride *ride)
+static void ride_ratings_calculate_monorail_cycles(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3799,7 +3926,7 @@ static void ride_ratings_calculate_monorail_cycles(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 4574);
     ride_ratings_apply_drops(&ratings, ride, 8738, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 5140, 6553, 2340);
-    ride_ratings_apply_proximity(&ratings, 8946);
+    ride_ratings_apply_proximity(&ratings, calcData, 8946);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0x8C0000, 2, 2, 2);
 
@@ -3808,14 +3935,14 @@ static void ride_ratings_calculate_monorail_cycles(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_compact_inverted_coaster(Ride *ride)
+static void ride_ratings_calculate_compact_inverted_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3835,7 +3962,7 @@ static void ride_ratings_calculate_compact_inverted_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 29552, 57186);
     ride_ratings_apply_drops(&ratings, ride, 29127, 39009, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 15291, 35108);
-    ride_ratings_apply_proximity(&ratings, 15657);
+    ride_ratings_apply_proximity(&ratings, calcData, 15657);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
 
     if ((ride->inversions & 0x1F) == 0)
@@ -3852,14 +3979,14 @@ static void ride_ratings_calculate_compact_inverted_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_water_coaster(Ride *ride)
+static void ride_ratings_calculate_water_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3879,7 +4006,7 @@ static void ride_ratings_calculate_water_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -3894,14 +4021,14 @@ static void ride_ratings_calculate_water_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_air_powered_vertical_coaster(Ride *ride)
+static void ride_ratings_calculate_air_powered_vertical_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3916,7 +4043,7 @@ static void ride_ratings_calculate_air_powered_vertical_coaster(Ride *ride)
     ride_ratings_apply_max_speed(&ratings, ride, 509724, 364088, 320398);
     ride_ratings_apply_gforces(&ratings, ride, 24576, 35746, 59578);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 21845, 11702);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(&ratings, calcData, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 34, 2, 1, 1);
 
@@ -3926,14 +4053,14 @@ static void ride_ratings_calculate_air_powered_vertical_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_inverted_hairpin_coaster(Ride *ride)
+static void ride_ratings_calculate_inverted_hairpin_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3953,7 +4080,7 @@ static void ride_ratings_calculate_inverted_hairpin_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(&ratings, calcData, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -3968,14 +4095,14 @@ static void ride_ratings_calculate_inverted_hairpin_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_magic_carpet(Ride *ride)
+static void ride_ratings_calculate_magic_carpet(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3997,14 +4124,14 @@ static void ride_ratings_calculate_magic_carpet(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 0 << 5;
 }
 
-static void ride_ratings_calculate_submarine_ride(Ride *ride)
+static void ride_ratings_calculate_submarine_ride(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->unreliability_factor = 7;
     set_unreliability_factor(ride);
@@ -4014,7 +4141,7 @@ static void ride_ratings_calculate_submarine_ride(Ride *ride)
     rating_tuple ratings;
     ride_ratings_set(&ratings, RIDE_RATING(2,20), RIDE_RATING(1,80), RIDE_RATING(1,40));
     ride_ratings_apply_length(&ratings, ride, 6000, 764);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(&ratings, calcData, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 22310);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -4022,14 +4149,14 @@ static void ride_ratings_calculate_submarine_ride(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 0 << 5;
 }
 
-static void ride_ratings_calculate_river_rafts(Ride *ride)
+static void ride_ratings_calculate_river_rafts(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4045,7 +4172,7 @@ static void ride_ratings_calculate_river_rafts(Ride *ride)
     ride_ratings_apply_duration(&ratings, ride, 500, 13107);
     ride_ratings_apply_turns(&ratings, ride, 22291, 20860, 4574);
     ride_ratings_apply_drops(&ratings, ride, 78643, 93622, 62259);
-    ride_ratings_apply_proximity(&ratings, 13420);
+    ride_ratings_apply_proximity(&ratings, calcData, 13420);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -4053,14 +4180,14 @@ static void ride_ratings_calculate_river_rafts(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_enterprise(Ride *ride)
+static void ride_ratings_calculate_enterprise(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -4086,14 +4213,14 @@ static void ride_ratings_calculate_enterprise(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= 3 << 5;
 }
 
-static void ride_ratings_calculate_inverted_impulse_coaster(Ride *ride)
+static void ride_ratings_calculate_inverted_impulse_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4113,7 +4240,7 @@ static void ride_ratings_calculate_inverted_impulse_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 29552, 57186);
     ride_ratings_apply_drops(&ratings, ride, 29127, 39009, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 15291, 35108);
-    ride_ratings_apply_proximity(&ratings, 15657);
+    ride_ratings_apply_proximity(&ratings, calcData, 15657);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 20, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -4124,14 +4251,14 @@ static void ride_ratings_calculate_inverted_impulse_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_mini_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_mini_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4151,7 +4278,7 @@ static void ride_ratings_calculate_mini_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 12, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -4164,14 +4291,14 @@ static void ride_ratings_calculate_mini_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_mine_ride(Ride *ride)
+static void ride_ratings_calculate_mine_ride(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4191,7 +4318,7 @@ static void ride_ratings_calculate_mine_ride(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 19275, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 21472);
+    ride_ratings_apply_proximity(&ratings, calcData, 21472);
     ride_ratings_apply_scenery(&ratings, ride, 16732);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0x10E0000, 2, 2, 2);
 
@@ -4201,14 +4328,14 @@ static void ride_ratings_calculate_mine_ride(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
     ride->inversions |= get_num_of_sheltered_eighths(ride) << 5;
 }
 
-static void ride_ratings_calculate_lim_launched_roller_coaster(Ride *ride)
+static void ride_ratings_calculate_lim_launched_roller_coaster(Ride *ride, rct_ride_rating_calc_data * calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4228,7 +4355,7 @@ static void ride_ratings_calculate_lim_launched_roller_coaster(Ride *ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(&ratings, calcData, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if ((ride->inversions & 0x1F) == 0)
@@ -4247,7 +4374,7 @@ static void ride_ratings_calculate_lim_launched_roller_coaster(Ride *ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->inversions &= 0x1F;
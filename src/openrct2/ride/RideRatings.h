@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <vector>
 #include "../common.h"
 
 using ride_rating = fixed16_2dp;
@@ -55,5 +56,8 @@ struct rct_ride_rating_calc_data {
 extern rct_ride_rating_calc_data gRideRatingsCalcData;
 
 void ride_ratings_update_ride(int rideIndex);
+void ride_ratings_update_rides(const std::vector<uint8_t> &rideIndices);
+void ride_ratings_update_all_rides();
+void ride_ratings_invalidate(int32_t rideIndex);
 void ride_ratings_update_all();
 
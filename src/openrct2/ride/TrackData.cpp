@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <array>
 #include "../core/Util.hpp"
 #include "Track.h"
 #include "TrackData.h"
@@ -29716,6 +29717,63 @@ constexpr const rct_vehicle_info_list * const * gTrackVehicleInfo[17] = {
     TrackVehicleInfoList_8BAD28,
 };
 
+/**
+ * Copies a list of pointers to vehicle info lists into an array of the lists themselves, so that looking up the
+ * moves for a track piece does not have to follow the extra pointer.
+ */
+template<size_t N>
+static constexpr std::array<rct_vehicle_info_list, N> CopyVehicleInfoLists(const rct_vehicle_info_list * const (&lists)[N])
+{
+    std::array<rct_vehicle_info_list, N> result{};
+    for (size_t i = 0; i < N; i++)
+    {
+        result[i] = *lists[i];
+    }
+    return result;
+}
+
+static constexpr const auto TrackVehicleInfoLists_8B8F98 = CopyVehicleInfoLists(TrackVehicleInfoList_8B8F98);
+static constexpr const auto TrackVehicleInfoLists_8BBAB8 = CopyVehicleInfoLists(TrackVehicleInfoList_8BBAB8);
+static constexpr const auto TrackVehicleInfoLists_8BC588 = CopyVehicleInfoLists(TrackVehicleInfoList_8BC588);
+static constexpr const auto TrackVehicleInfoLists_8BCBD8 = CopyVehicleInfoLists(TrackVehicleInfoList_8BCBD8);
+static constexpr const auto TrackVehicleInfoLists_8BD228 = CopyVehicleInfoLists(TrackVehicleInfoList_8BD228);
+static constexpr const auto TrackVehicleInfoLists_8BD878 = CopyVehicleInfoLists(TrackVehicleInfoList_8BD878);
+static constexpr const auto TrackVehicleInfoLists_8BDBB8 = CopyVehicleInfoLists(TrackVehicleInfoList_8BDBB8);
+static constexpr const auto TrackVehicleInfoLists_8BDEF8 = CopyVehicleInfoLists(TrackVehicleInfoList_8BDEF8);
+static constexpr const auto TrackVehicleInfoLists_8BE238 = CopyVehicleInfoLists(TrackVehicleInfoList_8BE238);
+static constexpr const auto TrackVehicleInfoLists_9334D0 = CopyVehicleInfoLists(TrackVehicleInfoList_9334D0);
+static constexpr const auto TrackVehicleInfoLists_9341B0 = CopyVehicleInfoLists(TrackVehicleInfoList_9341B0);
+static constexpr const auto TrackVehicleInfoLists_934E90 = CopyVehicleInfoLists(TrackVehicleInfoList_934E90);
+static constexpr const auto TrackVehicleInfoLists_935B70 = CopyVehicleInfoLists(TrackVehicleInfoList_935B70);
+static constexpr const auto TrackVehicleInfoLists_936850 = CopyVehicleInfoLists(TrackVehicleInfoList_936850);
+static constexpr const auto TrackVehicleInfoLists_937530 = CopyVehicleInfoLists(TrackVehicleInfoList_937530);
+static constexpr const auto TrackVehicleInfoLists_8B9F98 = CopyVehicleInfoLists(TrackVehicleInfoList_8B9F98);
+static constexpr const auto TrackVehicleInfoLists_8BAD28 = CopyVehicleInfoLists(TrackVehicleInfoList_8BAD28);
+
+#define TRACK_VEHICLE_INFO_SET(VAR) { static_cast<uint16_t>(VAR.size()), VAR.data() }
+
+constexpr const rct_vehicle_info_set gTrackVehicleInfoSets[17] = {
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_8B8F98),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_8BBAB8),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_8BC588),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_8BCBD8),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_8BD228),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_8BD878),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_8BDBB8),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_8BDEF8),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_8BE238),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_9334D0),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_9341B0),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_934E90),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_935B70),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_936850),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_937530),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_8B9F98),
+    TRACK_VEHICLE_INFO_SET(TrackVehicleInfoLists_8BAD28),
+};
+
+#undef TRACK_VEHICLE_INFO_SET
+
 /** rct2: 0x00993D1C */
 const int16_t AlternativeTrackTypes[256] = {
     TRACK_ELEM_FLAT_COVERED,                        // TRACK_ELEM_FLAT
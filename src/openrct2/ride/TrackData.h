@@ -60,6 +60,15 @@ struct rct_vehicle_info_list
 
 extern const rct_vehicle_info_list * const * const gTrackVehicleInfo[17];
 
+// The vehicle info lists of a vehicle type (var_CD), indexed by track type and direction
+struct rct_vehicle_info_set
+{
+    uint16_t                        count;
+    const rct_vehicle_info_list * lists;
+};
+
+extern const rct_vehicle_info_set gTrackVehicleInfoSets[17];
+
 extern const int16_t AlternativeTrackTypes[256];
 
 extern const money32 TrackPricing[256];
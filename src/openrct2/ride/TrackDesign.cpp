@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <memory>
 #include "../audio/audio.h"
 #include "../Cheats.h"
 #include "../core/File.h"
@@ -42,9 +43,6 @@
 
 struct map_backup
 {
-    rct_tile_element tile_elements[MAX_TILE_ELEMENTS];
-    rct_tile_element * tile_pointers[MAX_TILE_TILE_ELEMENT_POINTERS];
-    rct_tile_element * next_free_tile_element;
     uint16_t          map_size_units;
     uint16_t          map_size_units_minus_2;
     uint16_t          map_size;
@@ -70,11 +68,15 @@ static bool _trackDesignPlaceStateSceneryUnavailable = false;
 static bool _trackDesignPlaceStateHasScenery         = false;
 static bool _trackDesignPlaceStatePlaceScenery       = true;
 
+// A surface element for every tile plus room for the elements of the design
+static constexpr const size_t TrackDesignPreviewMaxTileElements = MAX_TILE_TILE_ELEMENT_POINTERS + 0x8000;
+static std::unique_ptr<TileElementStorage> _trackDesignPreviewTileElements;
+
 static rct_track_td6 * track_design_open_from_buffer(uint8_t * src, size_t srcLength);
 
-static map_backup * track_design_preview_backup_map();
+static map_backup track_design_preview_backup_map();
 
-static void track_design_preview_restore_map(map_backup * backup);
+static void track_design_preview_restore_map(const map_backup &backup);
 
 static void track_design_preview_clear_map();
 
@@ -2216,12 +2218,8 @@ void game_command_place_maze_design(
  */
 void track_design_draw_preview(rct_track_td6 * td6, uint8_t * pixels)
 {
-    // Make a copy of the map
-    map_backup * mapBackup = track_design_preview_backup_map();
-    if (mapBackup == nullptr)
-    {
-        return;
-    }
+    // Switch to the preview map
+    map_backup mapBackup = track_design_preview_backup_map();
     track_design_preview_clear_map();
 
     if (gScreenFlags & SCREEN_FLAGS_TRACK_MANAGER)
@@ -2323,57 +2321,38 @@ void track_design_draw_preview(rct_track_td6 * td6, uint8_t * pixels)
 }
 
 /**
- * Create a backup of the map as it will be cleared for drawing the track
- * design preview.
+ * Switches to the private map used for drawing track design previews so
+ * that the park's map does not have to be copied and cleared.
  *  rct2: 0x006D1C68
  */
-static map_backup * track_design_preview_backup_map()
+static map_backup track_design_preview_backup_map()
 {
-    map_backup * backup = (map_backup *) malloc(sizeof(map_backup));
-    if (backup != nullptr)
-    {
-        memcpy(
-            backup->tile_elements,
-            gTileElements,
-            sizeof(backup->tile_elements)
-        );
-        memcpy(
-            backup->tile_pointers,
-            gTileElementTilePointers,
-            sizeof(backup->tile_pointers)
-        );
-        backup->next_free_tile_element  = gNextFreeTileElement;
-        backup->map_size_units         = gMapSizeUnits;
-        backup->map_size_units_minus_2 = gMapSizeMinus2;
-        backup->map_size               = gMapSize;
-        backup->current_rotation       = get_current_rotation();
+    map_backup backup;
+    backup.map_size_units         = gMapSizeUnits;
+    backup.map_size_units_minus_2 = gMapSizeMinus2;
+    backup.map_size               = gMapSize;
+    backup.current_rotation       = get_current_rotation();
+
+    if (_trackDesignPreviewTileElements == nullptr)
+    {
+        _trackDesignPreviewTileElements = std::make_unique<TileElementStorage>(
+            TrackDesignPreviewMaxTileElements, TrackDesignPreviewMaxTileElements);
     }
+    map_set_tile_element_storage(_trackDesignPreviewTileElements.get());
     return backup;
 }
 
 /**
- * Restores the map from a backup.
+ * Switches back to the park's map.
  *  rct2: 0x006D2378
  */
-static void track_design_preview_restore_map(map_backup * backup)
+static void track_design_preview_restore_map(const map_backup &backup)
 {
-    memcpy(
-        gTileElements,
-        backup->tile_elements,
-        sizeof(backup->tile_elements)
-    );
-    memcpy(
-        gTileElementTilePointers,
-        backup->tile_pointers,
-        sizeof(backup->tile_pointers)
-    );
-    gNextFreeTileElement = backup->next_free_tile_element;
-    gMapSizeUnits       = backup->map_size_units;
-    gMapSizeMinus2      = backup->map_size_units_minus_2;
-    gMapSize            = backup->map_size;
-    gCurrentRotation    = backup->current_rotation;
-
-    free(backup);
+    map_set_tile_element_storage(nullptr);
+    gMapSizeUnits       = backup.map_size_units;
+    gMapSizeMinus2      = backup.map_size_units_minus_2;
+    gMapSize            = backup.map_size;
+    gCurrentRotation    = backup.current_rotation;
 }
 
 /**
@@ -2399,8 +2378,12 @@ static void track_design_preview_clear_map()
         tile_element->properties.surface.terrain      = 0;
         tile_element->properties.surface.grass_length = GRASS_LENGTH_CLEAR_0;
         tile_element->properties.surface.ownership    = OWNERSHIP_OWNED;
+        gTileElementTilePointers[i]                   = tile_element;
     }
-    map_update_tile_pointers();
+    // Set up the tile pointers directly, map_update_tile_pointers would also invalidate the state derived
+    // from the park's map
+    gNextFreeTileElement = &gTileElements[MAX_TILE_TILE_ELEMENT_POINTERS];
+    map_rebuild_tile_element_index();
 }
 
 bool track_design_are_entrance_and_exit_placed()
@@ -21,6 +21,7 @@
 #include "../localisation/Localisation.h"
 #include "../management/NewsItem.h"
 #include "../platform/platform.h"
+#include "../Profiling.h"
 #include "../rct12/RCT12.h"
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
@@ -758,73 +759,39 @@ static const struct
 
 // clang-format on
 
-static bool vehicle_move_info_valid(int32_t cd, int32_t typeAndDirection, int32_t offset)
+static const rct_vehicle_info_list * vehicle_get_move_info_list(int32_t cd, int32_t typeAndDirection)
 {
-    if (cd >= static_cast<int32_t>(Util::CountOf(gTrackVehicleInfo)))
+    if (cd >= static_cast<int32_t>(Util::CountOf(gTrackVehicleInfoSets)))
     {
-        return false;
-    }
-    int32_t size = 0;
-    switch (cd)
-    {
-    case 0:
-        size = 1024;
-        break;
-    case 1:
-        size = 692;
-        break;
-    case 2:
-    case 3:
-    case 4:
-        size = 404;
-        break;
-    case 5:
-    case 6:
-    case 7:
-    case 8:
-        size = 208;
-        break;
-    case 9:
-    case 10:
-    case 11:
-    case 12:
-    case 13:
-    case 14:
-        size = 824;
-        break;
-    case 15:
-    case 16:
-        size = 868;
-        break;
-    }
-    if (typeAndDirection >= size)
-    {
-        return false;
+        return nullptr;
     }
-    if (offset >= gTrackVehicleInfo[cd][typeAndDirection]->size)
+    const rct_vehicle_info_set * infoSet = &gTrackVehicleInfoSets[cd];
+    if (typeAndDirection >= infoSet->count)
     {
-        return false;
+        return nullptr;
     }
-    return true;
+    return &infoSet->lists[typeAndDirection];
 }
 
 const rct_vehicle_info * vehicle_get_move_info(int32_t cd, int32_t typeAndDirection, int32_t offset)
 {
-    if (!vehicle_move_info_valid(cd, typeAndDirection, offset))
+    const rct_vehicle_info_list * list = vehicle_get_move_info_list(cd, typeAndDirection);
+    if (list == nullptr || offset >= list->size)
     {
         static constexpr const rct_vehicle_info zero = {};
         return &zero;
     }
-    return &gTrackVehicleInfo[cd][typeAndDirection]->info[offset];
+    return &list->info[offset];
 }
 
 uint16_t vehicle_get_move_info_size(int32_t cd, int32_t typeAndDirection)
 {
-    if (!vehicle_move_info_valid(cd, typeAndDirection, 0))
+    const rct_vehicle_info_list * list = vehicle_get_move_info_list(cd, typeAndDirection);
+    if (list == nullptr)
     {
         return 0;
     }
-    return gTrackVehicleInfo[cd][typeAndDirection]->size;
+    return list->size;
 }
 
 rct_vehicle * try_get_vehicle(uint16_t spriteIndex)
@@ -1334,6 +1301,7 @@ void vehicle_sounds_update()
  */
 void vehicle_update_all()
 {
+    PROFILE_SCOPE("vehicle_update_all");
     uint16_t        sprite_index;
     rct_vehicle * vehicle;
 
@@ -3094,6 +3062,7 @@ void vehicle_update_test_finish(rct_vehicle * vehicle)
     totalTime           = std::max(totalTime, 1u);
     ride->average_speed = ride->average_speed / totalTime;
 
+    ride_ratings_invalidate(vehicle->ride);
     window_invalidate_by_number(WC_RIDE, vehicle->ride);
 }
 
@@ -10,6 +10,7 @@
 #ifndef _SCENARIO_H_
 #define _SCENARIO_H_
 
+#include <functional>
 #include "../common.h"
 #include "../management/Finance.h"
 #include "../management/Research.h"
@@ -289,6 +290,36 @@ struct rct_s6_data {
     uint8_t pad_13CE778[434];
 };
 assert_struct_size(rct_s6_data, 0x46b44a);
+
+/**
+ * Header of the chunk OpenRCT2 appends to S6 files when there are sprites beyond RCT2_MAX_SPRITES.
+ * References to those sprites are cut from the rest of the file so that readers that stop before
+ * this chunk see a consistent park. The header is followed by the extra sprites, then the original
+ * versions of the cut sprites and ride references.
+ */
+struct rct_s6_extended_sprites {
+    uint32_t num_sprites;
+    uint32_t num_cut_sprites;
+    uint32_t num_cut_rides;
+    uint16_t sprite_lists_head[NUM_SPRITE_LISTS];
+    uint16_t sprite_lists_count[NUM_SPRITE_LISTS];
+};
+assert_struct_size(rct_s6_extended_sprites, 36);
+
+struct rct_s6_cut_sprite {
+    uint16_t index;
+    rct_sprite sprite;
+};
+
+struct rct_s6_cut_ride {
+    uint8_t index;
+    uint16_t vehicles[RCT2_MAX_VEHICLES_PER_RIDE];
+    uint16_t race_winner;
+    uint16_t mechanic;
+    uint16_t cable_lift;
+    uint16_t last_peep_in_queue[RCT12_MAX_STATIONS_PER_RIDE];
+};
+assert_struct_size(rct_s6_cut_ride, 79);
 #pragma pack(pop)
 
 enum {
@@ -395,6 +426,9 @@ uint32_t scenario_rand_max(uint32_t max);
 
 bool scenario_prepare_for_save();
 int32_t scenario_save(const utf8 * path, int32_t flags);
+bool scenario_save_async(const utf8 * path, int32_t flags, std::function<void()> beforeWrite = nullptr);
+bool scenario_save_async_in_progress();
+void scenario_save_async_update();
 void scenario_remove_trackless_rides(rct_s6_data *s6);
 void scenario_fix_ghosts(rct_s6_data *s6);
 void scenario_failure();
@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <bitset>
 #include "../Cheats.h"
 #include "../Context.h"
 #include "../core/Guard.hpp"
@@ -32,6 +33,7 @@
 
 void footpath_interrupt_peeps(int32_t x, int32_t y, int32_t z);
 void footpath_update_queue_entrance_banner(int32_t x, int32_t y, rct_tile_element *tileElement);
+static void footpath_invalidate_wide_flags_around(int32_t x, int32_t y);
 
 uint8_t gFootpathProvisionalFlags;
 LocationXYZ16 gFootpathProvisionalPosition;
@@ -284,6 +286,7 @@ static money32 footpath_element_insert(int32_t type, int32_t x, int32_t y, int32
             if ((gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR) && !(flags & GAME_COMMAND_FLAG_GHOST))
                 automatically_set_peep_spawn({x, y, tileElement->base_height * 8});
 
+            footpath_invalidate_wide_flags(x, y);
             loc_6A6620(flags, x, y, tileElement);
         }
     }
@@ -396,6 +399,7 @@ static money32 footpath_element_update(int32_t x, int32_t y, rct_tile_element *t
         footpath_element_set_path_scenery(tileElement, pathItemType);
         tileElement->flags &= ~TILE_ELEMENT_FLAG_BROKEN;
 
+        footpath_invalidate_wide_flags(x, y);
         loc_6A6620(flags, x, y, tileElement);
     }
 
@@ -694,6 +698,7 @@ static money32 footpath_place_from_track(int32_t type, int32_t x, int32_t y, int
             if (flags & (1 << 6))
                 tileElement->flags |= TILE_ELEMENT_FLAG_GHOST;
 
+            footpath_invalidate_wide_flags(x, y);
             map_invalidate_tile_full(x, y);
         }
     }
@@ -1461,6 +1466,7 @@ void footpath_connect_edges(int32_t x, int32_t y, rct_tile_element *tileElement,
     rct_neighbour neighbour;
 
     footpath_update_queue_chains();
+    footpath_invalidate_wide_flags_around(x, y);
 
     neighbour_list_init(&neighbourList);
 
@@ -1944,18 +1950,6 @@ void footpath_element_set_direction(rct_tile_element * tileElement, uint8_t dire
 *  clears the wide footpath flag for all footpaths
 *  at location
 */
-static void footpath_clear_wide(int32_t x, int32_t y)
-{
-    rct_tile_element *tileElement = map_get_first_element_at(x / 32, y / 32);
-    do
-    {
-        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
-            continue;
-        footpath_element_set_wide(tileElement, false);
-    }
-    while (!(tileElement++)->IsLastForTile());
-}
-
 /**
 *
 *  rct2: 0x006A8ACF
@@ -1981,22 +1975,179 @@ static rct_tile_element* footpath_can_be_wide(int32_t x, int32_t y, uint8_t heig
 }
 
 
+/**
+ * Calculates whether a footpath element should be wide from the footpath elements on the neighbouring tiles.
+ * Only the wide flags of the tiles that precede this one in the update order are read.
+ */
+static bool footpath_element_should_be_wide(int32_t x, int32_t y, const rct_tile_element * tileElement)
+{
+    if (footpath_element_is_queue(tileElement))
+        return false;
+
+    if (footpath_element_is_sloped(tileElement))
+        return false;
+
+    if ((tileElement->properties.path.edges & FOOTPATH_PROPERTIES_EDGES_EDGES_MASK) == 0)
+        return false;
+
+    uint8_t height = tileElement->base_height;
+
+    // pathList is a list of elements, set by sub_6A8ACF adjacent to x,y
+    // Spanned from 0x00F3EFA8 to 0x00F3EFC7 (8 elements) in the original
+    rct_tile_element *pathList[8];
+
+    x -= 0x20;
+    y -= 0x20;
+    pathList[0] = footpath_can_be_wide(x, y, height);
+    y += 0x20;
+    pathList[1] = footpath_can_be_wide(x, y, height);
+    y += 0x20;
+    pathList[2] = footpath_can_be_wide(x, y, height);
+    x += 0x20;
+    pathList[3] = footpath_can_be_wide(x, y, height);
+    x += 0x20;
+    pathList[4] = footpath_can_be_wide(x, y, height);
+    y -= 0x20;
+    pathList[5] = footpath_can_be_wide(x, y, height);
+    y -= 0x20;
+    pathList[6] = footpath_can_be_wide(x, y, height);
+    x -= 0x20;
+    pathList[7] = footpath_can_be_wide(x, y, height);
+    y += 0x20;
+
+    uint8_t F3EFA5 = 0;
+    if (tileElement->properties.path.edges & EDGE_NW) {
+        F3EFA5 |= 0x80;
+        if (pathList[7] != nullptr) {
+            if (footpath_element_is_wide(pathList[7])) {
+                F3EFA5 &= ~0x80;
+            }
+        }
+    }
+
+    if (tileElement->properties.path.edges & EDGE_NE) {
+        F3EFA5 |= 0x2;
+        if (pathList[1] != nullptr) {
+            if (footpath_element_is_wide(pathList[1])) {
+                F3EFA5 &= ~0x2;
+            }
+        }
+    }
+
+    if (tileElement->properties.path.edges & EDGE_SE) {
+        F3EFA5 |= 0x8;
+        /* In the following:
+         * footpath_element_is_wide(pathList[3])
+         * is always false due to the tile update order
+         * in combination with reset tiles.
+         * Commented out since it will never occur. */
+        //if (pathList[3] != nullptr) {
+        //  if (footpath_element_is_wide(pathList[3])) {
+        //      F3EFA5 &= ~0x8;
+        //  }
+        //}
+    }
+
+    if (tileElement->properties.path.edges & EDGE_SW) {
+        F3EFA5 |= 0x20;
+        /* In the following:
+         * footpath_element_is_wide(pathList[5])
+         * is always false due to the tile update order
+         * in combination with reset tiles.
+         * Commented out since it will never occur. */
+        //if (pathList[5] != nullptr) {
+        //  if (footpath_element_is_wide(pathList[5])) {
+        //      F3EFA5 &= ~0x20;
+        //  }
+        //}
+    }
+
+    if ((F3EFA5 & 0x80) && (pathList[7] != nullptr) && !(footpath_element_is_wide(pathList[7]))) {
+        if ((F3EFA5 & 2) &&
+            (pathList[0] != nullptr) && (!footpath_element_is_wide(pathList[0])) &&
+            ((pathList[0]->properties.path.edges & 6) == 6) && // N E
+            (pathList[1] != nullptr) && (!footpath_element_is_wide(pathList[1]))) {
+            F3EFA5 |= 0x1;
+        }
+
+        /* In the following:
+         * footpath_element_is_wide(pathList[5])
+         * is always false due to the tile update order
+         * in combination with reset tiles.
+         * Short circuit the logic appropriately. */
+        if ((F3EFA5 & 0x20) &&
+            (pathList[6] != nullptr) && (!footpath_element_is_wide(pathList[6])) &&
+            ((pathList[6]->properties.path.edges & 3) == 3) && // N W
+            (pathList[5] != nullptr) && (true || !footpath_element_is_wide(pathList[5]))) {
+            F3EFA5 |= 0x40;
+        }
+    }
+
+
+    /* In the following:
+      * footpath_element_is_wide(pathList[2])
+      * footpath_element_is_wide(pathList[3])
+     * are always false due to the tile update order
+     * in combination with reset tiles.
+     * Short circuit the logic appropriately. */
+    if ((F3EFA5 & 0x8) && (pathList[3] != nullptr) && (true || !footpath_element_is_wide(pathList[3]))) {
+        if ((F3EFA5 & 2) &&
+            (pathList[2] != nullptr) && (true || !footpath_element_is_wide(pathList[2])) &&
+            ((pathList[2]->properties.path.edges & 0xC) == 0xC) &&
+            (pathList[1] != nullptr) && (!footpath_element_is_wide(pathList[1]))) {
+            F3EFA5 |= 0x4;
+        }
+
+        /* In the following:
+         * footpath_element_is_wide(pathList[4])
+         * footpath_element_is_wide(pathList[5])
+         * are always false due to the tile update order
+         * in combination with reset tiles.
+         * Short circuit the logic appropriately. */
+        if ((F3EFA5 & 0x20) &&
+            (pathList[4] != nullptr) && (true || !footpath_element_is_wide(pathList[4])) &&
+            ((pathList[4]->properties.path.edges & 9) == 9) &&
+            (pathList[5] != nullptr) && (true || !footpath_element_is_wide(pathList[5]))) {
+            F3EFA5 |= 0x10;
+        }
+    }
+
+    if ((F3EFA5 & 0x80) && (F3EFA5 & (0x40 | 0x1)))
+        F3EFA5 &= ~0x80;
+
+    if ((F3EFA5 & 0x2) && (F3EFA5 & (0x4 | 0x1)))
+        F3EFA5 &= ~0x2;
+
+    if ((F3EFA5 & 0x8) && (F3EFA5 & (0x10 | 0x4)))
+        F3EFA5 &= ~0x8;
+
+    if ((F3EFA5 & 0x20) && (F3EFA5 & (0x40 | 0x10)))
+        F3EFA5 &= ~0x20;
+
+if (!(F3EFA5 & (0x2 | 0x8 | 0x20 | 0x80))) {
+        uint8_t e = tileElement->properties.path.edges;
+        if ((e != 0b10101111) && (e != 0b01011111) && (e != 0b11101111))
+            return true;
+    }
+    return false;
+}
+
 /**
 *
 *  rct2: 0x006A87BB
+*  returns true if the wide flag of any footpath element on the tile was changed
 */
-void footpath_update_path_wide_flags(int32_t x, int32_t y)
+bool footpath_update_path_wide_flags(int32_t x, int32_t y)
 {
     if (x < 0x20)
-        return;
+        return false;
     if (y < 0x20)
-        return;
+        return false;
     if (x > 0x1FDF)
-        return;
+        return false;
     if (y > 0x1FDF)
-        return;
+        return false;
 
-    footpath_clear_wide(x, y);
     /* Rather than clearing the wide flag of the following tiles and
      * checking the state of them later, leave them intact and assume
      * they were cleared. Consequently only the wide flag for this single
@@ -2015,160 +2166,145 @@ void footpath_update_path_wide_flags(int32_t x, int32_t y)
     //footpath_clear_wide(x, y);
     //y -= 0x20;
 
+    bool changed = false;
     rct_tile_element *tileElement = map_get_first_element_at(x / 32, y / 32);
     do {
         if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
             continue;
 
-        if (footpath_element_is_queue(tileElement))
-            continue;
-
-        if (footpath_element_is_sloped(tileElement))
-            continue;
+        bool isWide = footpath_element_should_be_wide(x, y, tileElement);
+        if (isWide != footpath_element_is_wide(tileElement)) {
+            footpath_element_set_wide(tileElement, isWide);
+            changed = true;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+    return changed;
+}
 
-        if ((tileElement->properties.path.edges & FOOTPATH_PROPERTIES_EDGES_EDGES_MASK) == 0)
-            continue;
+// Tiles whose wide flags need to be recalculated, with a bit per map row so that rows without any
+// pending tiles can be skipped quickly.
+static std::bitset<MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL> _widePathPendingTiles;
+static std::bitset<MAXIMUM_MAP_SIZE_TECHNICAL> _widePathPendingRows;
+static int32_t _widePathVerifyX;
+static int32_t _widePathVerifyY;
 
-        uint8_t height = tileElement->base_height;
-
-        // pathList is a list of elements, set by sub_6A8ACF adjacent to x,y
-        // Spanned from 0x00F3EFA8 to 0x00F3EFC7 (8 elements) in the original
-        rct_tile_element *pathList[8];
-
-        x -= 0x20;
-        y -= 0x20;
-        pathList[0] = footpath_can_be_wide(x, y, height);
-        y += 0x20;
-        pathList[1] = footpath_can_be_wide(x, y, height);
-        y += 0x20;
-        pathList[2] = footpath_can_be_wide(x, y, height);
-        x += 0x20;
-        pathList[3] = footpath_can_be_wide(x, y, height);
-        x += 0x20;
-        pathList[4] = footpath_can_be_wide(x, y, height);
-        y -= 0x20;
-        pathList[5] = footpath_can_be_wide(x, y, height);
-        y -= 0x20;
-        pathList[6] = footpath_can_be_wide(x, y, height);
-        x -= 0x20;
-        pathList[7] = footpath_can_be_wide(x, y, height);
-        y += 0x20;
-
-        uint8_t F3EFA5 = 0;
-        if (tileElement->properties.path.edges & EDGE_NW) {
-            F3EFA5 |= 0x80;
-            if (pathList[7] != nullptr) {
-                if (footpath_element_is_wide(pathList[7])) {
-                    F3EFA5 &= ~0x80;
-                }
-            }
+static void footpath_invalidate_wide_flags_range(int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
+    // The outer ring of tiles is never made wide, see footpath_update_path_wide_flags
+    left = std::max(left, 1);
+    top = std::max(top, 1);
+    right = std::min(right, MAXIMUM_MAP_SIZE_TECHNICAL - 2);
+    bottom = std::min(bottom, MAXIMUM_MAP_SIZE_TECHNICAL - 2);
+    for (int32_t y = top; y <= bottom; y++)
+    {
+        for (int32_t x = left; x <= right; x++)
+        {
+            _widePathPendingTiles[y * MAXIMUM_MAP_SIZE_TECHNICAL + x] = true;
         }
+        _widePathPendingRows[y] = true;
+    }
+}
 
-        if (tileElement->properties.path.edges & EDGE_NE) {
-            F3EFA5 |= 0x2;
-            if (pathList[1] != nullptr) {
-                if (footpath_element_is_wide(pathList[1])) {
-                    F3EFA5 &= ~0x2;
-                }
-            }
-        }
+/**
+ * Marks the wide flags around a tile as out of date after footpath elements on it have been added,
+ * removed or modified. The tile's neighbours are included as their wide flags depend on this tile.
+ */
+void footpath_invalidate_wide_flags(int32_t x, int32_t y)
+{
+    int32_t tileX = x / 32;
+    int32_t tileY = y / 32;
+    footpath_invalidate_wide_flags_range(tileX - 1, tileY - 1, tileX + 1, tileY + 1);
+}
 
-        if (tileElement->properties.path.edges & EDGE_SE) {
-            F3EFA5 |= 0x8;
-            /* In the following:
-             * footpath_element_is_wide(pathList[3])
-             * is always false due to the tile update order
-             * in combination with reset tiles.
-             * Commented out since it will never occur. */
-            //if (pathList[3] != nullptr) {
-            //  if (footpath_element_is_wide(pathList[3])) {
-            //      F3EFA5 &= ~0x8;
-            //  }
-            //}
-        }
-
-        if (tileElement->properties.path.edges & EDGE_SW) {
-            F3EFA5 |= 0x20;
-            /* In the following:
-             * footpath_element_is_wide(pathList[5])
-             * is always false due to the tile update order
-             * in combination with reset tiles.
-             * Commented out since it will never occur. */
-            //if (pathList[5] != nullptr) {
-            //  if (footpath_element_is_wide(pathList[5])) {
-            //      F3EFA5 &= ~0x20;
-            //  }
-            //}
-        }
-
-        if ((F3EFA5 & 0x80) && (pathList[7] != nullptr) && !(footpath_element_is_wide(pathList[7]))) {
-            if ((F3EFA5 & 2) &&
-                (pathList[0] != nullptr) && (!footpath_element_is_wide(pathList[0])) &&
-                ((pathList[0]->properties.path.edges & 6) == 6) && // N E
-                (pathList[1] != nullptr) && (!footpath_element_is_wide(pathList[1]))) {
-                F3EFA5 |= 0x1;
-            }
+/**
+ * Connecting or disconnecting edges also changes the edges and corners of footpaths up to two tiles
+ * away (queues are disconnected from the path beyond the neighbour), so invalidate a wider area.
+ */
+static void footpath_invalidate_wide_flags_around(int32_t x, int32_t y)
+{
+    int32_t tileX = x / 32;
+    int32_t tileY = y / 32;
+    footpath_invalidate_wide_flags_range(tileX - 3, tileY - 3, tileX + 3, tileY + 3);
+}
 
-            /* In the following:
-             * footpath_element_is_wide(pathList[5])
-             * is always false due to the tile update order
-             * in combination with reset tiles.
-             * Short circuit the logic appropriately. */
-            if ((F3EFA5 & 0x20) &&
-                (pathList[6] != nullptr) && (!footpath_element_is_wide(pathList[6])) &&
-                ((pathList[6]->properties.path.edges & 3) == 3) && // N W
-                (pathList[5] != nullptr) && (true || !footpath_element_is_wide(pathList[5]))) {
-                F3EFA5 |= 0x40;
-            }
-        }
+void footpath_invalidate_all_wide_flags()
+{
+    _widePathPendingTiles.set();
+    _widePathPendingRows.set();
+}
 
+/**
+ * Recalculates the wide flags of all pending tiles. Tiles are visited in the same order as the original
+ * full map sweep so the result does not depend on when or how often a tile was invalidated. Whenever a
+ * tile's wide flags change, the following tiles that read them are recalculated too.
+ */
+void footpath_update_wide_flags()
+{
+    if (_widePathPendingRows.none())
+        return;
 
-        /* In the following:
-          * footpath_element_is_wide(pathList[2])
-          * footpath_element_is_wide(pathList[3])
-         * are always false due to the tile update order
-         * in combination with reset tiles.
-         * Short circuit the logic appropriately. */
-        if ((F3EFA5 & 0x8) && (pathList[3] != nullptr) && (true || !footpath_element_is_wide(pathList[3]))) {
-            if ((F3EFA5 & 2) &&
-                (pathList[2] != nullptr) && (true || !footpath_element_is_wide(pathList[2])) &&
-                ((pathList[2]->properties.path.edges & 0xC) == 0xC) &&
-                (pathList[1] != nullptr) && (!footpath_element_is_wide(pathList[1]))) {
-                F3EFA5 |= 0x4;
-            }
+    for (int32_t y = 1; y < MAXIMUM_MAP_SIZE_TECHNICAL - 1; y++)
+    {
+        if (!_widePathPendingRows[y])
+            continue;
 
-            /* In the following:
-             * footpath_element_is_wide(pathList[4])
-             * footpath_element_is_wide(pathList[5])
-             * are always false due to the tile update order
-             * in combination with reset tiles.
-             * Short circuit the logic appropriately. */
-            if ((F3EFA5 & 0x20) &&
-                (pathList[4] != nullptr) && (true || !footpath_element_is_wide(pathList[4])) &&
-                ((pathList[4]->properties.path.edges & 9) == 9) &&
-                (pathList[5] != nullptr) && (true || !footpath_element_is_wide(pathList[5]))) {
-                F3EFA5 |= 0x10;
+        for (int32_t x = 1; x < MAXIMUM_MAP_SIZE_TECHNICAL - 1; x++)
+        {
+            size_t index = y * MAXIMUM_MAP_SIZE_TECHNICAL + x;
+            if (!_widePathPendingTiles[index])
+                continue;
+
+            _widePathPendingTiles[index] = false;
+            if (footpath_update_path_wide_flags(x * 32, y * 32))
+            {
+                footpath_invalidate_wide_flags_range(x + 1, y, x + 1, y);
+                footpath_invalidate_wide_flags_range(x - 1, y + 1, x + 1, y + 1);
             }
         }
+        _widePathPendingRows[y] = false;
+    }
+}
 
-        if ((F3EFA5 & 0x80) && (F3EFA5 & (0x40 | 0x1)))
-            F3EFA5 &= ~0x80;
-
-        if ((F3EFA5 & 0x2) && (F3EFA5 & (0x4 | 0x1)))
-            F3EFA5 &= ~0x2;
-
-        if ((F3EFA5 & 0x8) && (F3EFA5 & (0x10 | 0x4)))
-            F3EFA5 &= ~0x8;
+/**
+ * Recalculates the wide flags of the given number of tiles, continuing from where the previous call
+ * stopped, and logs any that differ from the stored ones. Nothing is corrected so that running the
+ * check can not change the game state.
+ */
+void footpath_verify_wide_flags(int32_t numTiles)
+{
+    int32_t x = _widePathVerifyX;
+    int32_t y = _widePathVerifyY;
+    for (int32_t i = 0; i < numTiles; i++)
+    {
+        if (x >= 1 && y >= 1 && x < MAXIMUM_MAP_SIZE_TECHNICAL - 1 && y < MAXIMUM_MAP_SIZE_TECHNICAL - 1)
+        {
+            rct_tile_element * tileElement = map_get_first_element_at(x, y);
+            do
+            {
+                if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+                    continue;
 
-        if ((F3EFA5 & 0x20) && (F3EFA5 & (0x40 | 0x10)))
-            F3EFA5 &= ~0x20;
+                if (footpath_element_should_be_wide(x * 32, y * 32, tileElement) != footpath_element_is_wide(tileElement))
+                {
+                    log_warning("Footpath wide flag at (%d, %d, %d) is out of date", x, y, tileElement->base_height);
+                }
+            }
+            while (!(tileElement++)->IsLastForTile());
+        }
 
-        if (!(F3EFA5 & (0x2 | 0x8 | 0x20 | 0x80))) {
-            uint8_t e = tileElement->properties.path.edges;
-            if ((e != 0b10101111) && (e != 0b01011111) && (e != 0b11101111))
-                footpath_element_set_wide(tileElement, true);
+        x++;
+        if (x >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        {
+            x = 0;
+            y++;
+            if (y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+            {
+                y = 0;
+            }
         }
-    } while (!(tileElement++)->IsLastForTile());
+    }
+    _widePathVerifyX = x;
+    _widePathVerifyY = y;
 }
 
 bool footpath_is_blocked_by_vehicle(const TileCoordsXYZ& position)
@@ -2417,6 +2553,7 @@ void footpath_remove_edges_at(int32_t x, int32_t y, rct_tile_element *tileElemen
     }
 
     footpath_update_queue_entrance_banner(x, y, tileElement);
+    footpath_invalidate_wide_flags_around(x, y);
 
     bool fixCorners = false;
     for (uint8_t direction = 0; direction < 4; direction++) {
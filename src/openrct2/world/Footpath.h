@@ -141,7 +141,11 @@ void footpath_connect_edges(int32_t x, int32_t y, rct_tile_element * tileElement
 void footpath_update_queue_chains();
 bool fence_in_the_way(int32_t x, int32_t y, int32_t z0, int32_t z1, int32_t direction);
 void footpath_chain_ride_queue(int32_t rideIndex, int32_t entranceIndex, int32_t x, int32_t y, rct_tile_element * tileElement, int32_t direction);
-void footpath_update_path_wide_flags(int32_t x, int32_t y);
+bool footpath_update_path_wide_flags(int32_t x, int32_t y);
+void footpath_invalidate_wide_flags(int32_t x, int32_t y);
+void footpath_invalidate_all_wide_flags();
+void footpath_update_wide_flags();
+void footpath_verify_wide_flags(int32_t numTiles);
 bool footpath_is_blocked_by_vehicle(const TileCoordsXYZ& position);
 
 int32_t footpath_is_connected_to_map_edge(int32_t x, int32_t y, int32_t z, int32_t direction, int32_t flags);
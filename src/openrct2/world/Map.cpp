@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <bitset>
 #include "../audio/audio.h"
 #include "../Cheats.h"
 #include "../config/Config.h"
@@ -23,7 +24,9 @@
 #include "../management/Finance.h"
 #include "../network/network.h"
 #include "../OpenRCT2.h"
+#include "../Profiling.h"
 #include "../ride/RideData.h"
+#include "../ride/RidePresence.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../ride/TrackDesign.h"
@@ -69,6 +72,13 @@ const TileCoordsXY TileDirectionDelta[] = {
     { -1, -1 }
 };
 
+// Once this many tiles are waiting to be collected, the whole map is reported as changed instead
+static constexpr size_t MAX_CHANGED_TILES = 4096;
+
+static std::bitset<MAX_TILE_TILE_ELEMENT_POINTERS> _changedTileGrid;
+static std::vector<TileCoordsXY> _changedTiles;
+static bool _allTilesChanged = true;
+
 /** rct2: 0x0097B8B8 */
 const money32 TerrainPricing[] = {
     300,    // TERRAIN_GRASS
@@ -106,8 +116,21 @@ int16_t gMapSize;
 int16_t gMapSizeMaxXY;
 int16_t gMapBaseZ;
 
-rct_tile_element gTileElements[MAX_TILE_TILE_ELEMENT_POINTERS * 3];
-rct_tile_element *gTileElementTilePointers[MAX_TILE_TILE_ELEMENT_POINTERS];
+static TileElementStorage _parkTileElementStorage(MAX_TILE_TILE_ELEMENT_POINTERS * 3, MAX_TILE_ELEMENTS);
+static TileElementStorage * _tileElementStorage = &_parkTileElementStorage;
+
+constexpr uint16_t TILE_TYPE_MASK_ALL = 0xFFFF;
+// Number of tiles whose type mask is recalculated each tick to clear the bits of removed elements
+constexpr size_t TILE_INDEX_SWEEP_LENGTH = 256;
+
+static std::bitset<MAX_TILE_TILE_ELEMENT_POINTERS> _tileIndexPendingGrid;
+static std::vector<uint32_t> _tileIndexPendingTiles;
+static uint32_t _tileIndexSweepPosition;
+
+static void map_invalidate_tile_element_index(int32_t x, int32_t y);
+
+rct_tile_element *gTileElements = _parkTileElementStorage.Elements.data();
+rct_tile_element **gTileElementTilePointers = _parkTileElementStorage.TilePointers.data();
 LocationXY16 gMapSelectionTiles[300];
 PeepSpawn gPeepSpawns[MAX_PEEP_SPAWNS];
 
@@ -253,6 +276,23 @@ rct_tile_element *map_get_nth_element_at(int32_t x, int32_t y, int32_t n)
     return nullptr;
 }
 
+/**
+ * Returns the first element of the tile or nullptr if the tile is outside the map or certainly has no element
+ * of the given type.
+ */
+static rct_tile_element * map_get_first_element_of_type_at(int32_t x, int32_t y, uint8_t type)
+{
+    rct_tile_element * tileElement = map_get_first_element_at(x, y);
+    if (tileElement == nullptr)
+        return nullptr;
+
+    uint16_t typeMask = _tileElementStorage->TileTypeMasks[x + y * MAXIMUM_MAP_SIZE_TECHNICAL];
+    if (!(typeMask & (1 << (type >> 2))))
+        return nullptr;
+
+    return tileElement;
+}
+
 void map_set_tile_elements(int32_t x, int32_t y, rct_tile_element *elements)
 {
     if (x < 0 || y < 0 || x > (MAXIMUM_MAP_SIZE_TECHNICAL - 1) || y > (MAXIMUM_MAP_SIZE_TECHNICAL - 1)) {
@@ -260,6 +300,7 @@ void map_set_tile_elements(int32_t x, int32_t y, rct_tile_element *elements)
         return;
     }
     gTileElementTilePointers[x + y * MAXIMUM_MAP_SIZE_TECHNICAL] = elements;
+    map_invalidate_tile_element_index(x, y);
 }
 
 rct_tile_element * map_get_surface_element_at(int32_t x, int32_t y)
@@ -269,7 +310,18 @@ rct_tile_element * map_get_surface_element_at(int32_t x, int32_t y)
     if (tileElement == nullptr)
         return nullptr;
 
-    // Find the first surface element
+    size_t tileIndex = x + y * MAXIMUM_MAP_SIZE_TECHNICAL;
+    uint8_t surfaceIndex = _tileElementStorage->TileSurfaceIndices[tileIndex];
+    if (surfaceIndex != TILE_SURFACE_INDEX_UNKNOWN)
+    {
+        // The tile inspector can swap elements in place, so check that it is still the surface
+        rct_tile_element * surfaceElement = tileElement + surfaceIndex;
+        if (surfaceElement->GetType() == TILE_ELEMENT_TYPE_SURFACE)
+            return surfaceElement;
+    }
+
+    // Find the first surface element, the index is only filled in by map_update_tile_element_index so that
+    // lookups stay safe to run from several threads at once
     while (tileElement->GetType() != TILE_ELEMENT_TYPE_SURFACE) {
         if (tileElement->IsLastForTile())
             return nullptr;
@@ -286,7 +338,7 @@ rct_tile_element * map_get_surface_element_at(const CoordsXY coords)
 }
 
 rct_tile_element* map_get_path_element_at(int32_t x, int32_t y, int32_t z){
-    rct_tile_element *tileElement = map_get_first_element_at(x, y);
+    rct_tile_element *tileElement = map_get_first_element_of_type_at(x, y, TILE_ELEMENT_TYPE_PATH);
 
     if (tileElement == nullptr)
         return nullptr;
@@ -307,7 +359,7 @@ rct_tile_element* map_get_path_element_at(int32_t x, int32_t y, int32_t z){
 }
 
 rct_tile_element* map_get_banner_element_at(int32_t x, int32_t y, int32_t z, uint8_t position) {
-    rct_tile_element *tileElement = map_get_first_element_at(x, y);
+    rct_tile_element *tileElement = map_get_first_element_of_type_at(x, y, TILE_ELEMENT_TYPE_BANNER);
 
     if (tileElement == nullptr)
         return nullptr;
@@ -418,12 +470,45 @@ void map_count_remaining_land_rights()
  */
 void map_strip_ghost_flag_from_elements()
 {
-    for (auto& element : gTileElements)
+    for (auto& element : _tileElementStorage->Elements)
     {
         element.flags &= ~TILE_ELEMENT_FLAG_GHOST;
     }
 }
 
+TileElementStorage::TileElementStorage(size_t capacity, size_t maxElements)
+    : Elements(capacity),
+      TilePointers(MAX_TILE_TILE_ELEMENT_POINTERS),
+      NextFreeElement(Elements.data()),
+      MaxElements(maxElements),
+      TileTypeMasks(MAX_TILE_TILE_ELEMENT_POINTERS, TILE_TYPE_MASK_ALL),
+      TileSurfaceIndices(MAX_TILE_TILE_ELEMENT_POINTERS, TILE_SURFACE_INDEX_UNKNOWN)
+{
+}
+
+TileElementStorage * map_get_tile_element_storage()
+{
+    return _tileElementStorage;
+}
+
+/**
+ * Makes the given storage the one that all map functions operate on. Passing nullptr switches back to the
+ * park's own storage. The position of the next free element is kept in the storage that is switched away from.
+ */
+void map_set_tile_element_storage(TileElementStorage * storage)
+{
+    if (storage == nullptr)
+    {
+        storage = &_parkTileElementStorage;
+    }
+
+    _tileElementStorage->NextFreeElement = gNextFreeTileElement;
+    _tileElementStorage = storage;
+    gTileElements = storage->Elements.data();
+    gTileElementTilePointers = storage->TilePointers.data();
+    gNextFreeTileElement = storage->NextFreeElement;
+}
+
 /**
  *
  *  rct2: 0x0068AFFD
@@ -446,6 +531,88 @@ void map_update_tile_pointers()
     }
 
     gNextFreeTileElement = tileElement;
+    map_rebuild_tile_element_index();
+    map_mark_all_tiles_changed();
+    ride_presence_invalidate_all();
+    footpath_invalidate_all_wide_flags();
+}
+
+static void map_index_tile(size_t tileIndex)
+{
+    rct_tile_element * tileElement = gTileElementTilePointers[tileIndex];
+    if (tileElement == TILE_UNDEFINED_TILE_ELEMENT)
+        return;
+
+    uint16_t typeMask = 0;
+    uint8_t surfaceIndex = TILE_SURFACE_INDEX_UNKNOWN;
+    size_t position = 0;
+    do {
+        uint8_t type = tileElement->GetType();
+        if (type == TILE_ELEMENT_TYPE_SURFACE && surfaceIndex == TILE_SURFACE_INDEX_UNKNOWN && position < TILE_SURFACE_INDEX_UNKNOWN)
+        {
+            surfaceIndex = (uint8_t)position;
+        }
+        typeMask |= 1 << (type >> 2);
+        position++;
+    } while (!(tileElement++)->IsLastForTile());
+
+    _tileElementStorage->TileTypeMasks[tileIndex] = typeMask;
+    _tileElementStorage->TileSurfaceIndices[tileIndex] = surfaceIndex;
+}
+
+/**
+ * Elements are inserted before their type is set, so the tile can only be indexed again once the current
+ * game command or tick has finished. Until then all lookups search the whole tile.
+ */
+static void map_invalidate_tile_element_index(int32_t x, int32_t y)
+{
+    size_t tileIndex = x + y * MAXIMUM_MAP_SIZE_TECHNICAL;
+    _tileElementStorage->TileTypeMasks[tileIndex] = TILE_TYPE_MASK_ALL;
+    _tileElementStorage->TileSurfaceIndices[tileIndex] = TILE_SURFACE_INDEX_UNKNOWN;
+    if (!_tileIndexPendingGrid[tileIndex])
+    {
+        _tileIndexPendingGrid[tileIndex] = true;
+        _tileIndexPendingTiles.push_back((uint32_t)tileIndex);
+    }
+}
+
+/**
+ * Recalculates the element types and surface position of every tile in the current tile element storage.
+ */
+void map_rebuild_tile_element_index()
+{
+    for (size_t i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    {
+        map_index_tile(i);
+    }
+
+    // The map can be reorganised while an element is inserted, keep the tiles that are waiting for their types
+    for (auto tileIndex : _tileIndexPendingTiles)
+    {
+        _tileElementStorage->TileTypeMasks[tileIndex] = TILE_TYPE_MASK_ALL;
+        _tileElementStorage->TileSurfaceIndices[tileIndex] = TILE_SURFACE_INDEX_UNKNOWN;
+    }
+}
+
+/**
+ * Indexes the tiles that had elements inserted since the last call. Removing an element leaves its type in
+ * the mask of the tile, which only makes lookups slower, so a part of the map is indexed again on every call
+ * to clear those bits over time.
+ */
+void map_update_tile_element_index()
+{
+    for (auto tileIndex : _tileIndexPendingTiles)
+    {
+        _tileIndexPendingGrid[tileIndex] = false;
+        map_index_tile(tileIndex);
+    }
+    _tileIndexPendingTiles.clear();
+
+    for (size_t i = 0; i < TILE_INDEX_SWEEP_LENGTH; i++)
+    {
+        map_index_tile(_tileIndexSweepPosition);
+        _tileIndexSweepPosition = (_tileIndexSweepPosition + 1) % MAX_TILE_TILE_ELEMENT_POINTERS;
+    }
 }
 
 /**
@@ -644,26 +811,13 @@ void map_update_path_wide_flags()
         return;
     }
 
-    // Presumably update_path_wide_flags is too computationally expensive to call for every
-    // tile every update, so gWidePathTileLoopX and gWidePathTileLoopY store the x and y
-    // progress. A maximum of 128 calls is done per update.
-    uint16_t x = gWidePathTileLoopX;
-    uint16_t y = gWidePathTileLoopY;
-    for (int32_t i = 0; i < 128; i++) {
-        footpath_update_path_wide_flags(x, y);
-
-        // Next x, y tile
-        x += 32;
-        if (x >= 8192) {
-            x = 0;
-            y += 32;
-            if (y >= 8192) {
-                y = 0;
-            }
-        }
+    // Footpath changes mark the surrounding tiles as pending rather than relying on a sweep of the whole map,
+    // so only those tiles are recalculated. With the debugging tools enabled, the stored wide flags are also
+    // checked against a full recalculation, 128 tiles per update as the original sweep did.
+    footpath_update_wide_flags();
+    if (gConfigGeneral.debugging_tools) {
+        footpath_verify_wide_flags(128);
     }
-    gWidePathTileLoopX = x;
-    gWidePathTileLoopY = y;
 }
 
 /**
@@ -2956,21 +3110,85 @@ int32_t tile_element_get_station(const rct_tile_element * tileElement)
     return (tileElement->properties.track.sequence & MAP_ELEM_TRACK_SEQUENCE_STATION_INDEX_MASK) >> 4;
 }
 
+/**
+ * Finds the tile an element belongs to by going back to the first element of the tile, which follows the
+ * last element of another tile or a freed element. Only used when removing an element from below the
+ * surface or a track element, as it searches the tile pointers.
+ * @returns SIZE_MAX if the tile could not be found.
+ */
+static size_t map_get_element_tile_index(const rct_tile_element * tileElement)
+{
+    while (tileElement > gTileElements && !(tileElement - 1)->IsLastForTile() && (tileElement - 1)->base_height != 0xFF)
+    {
+        tileElement--;
+    }
+
+    const rct_tile_element * const * tilePointers = gTileElementTilePointers;
+    for (size_t i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    {
+        if (tilePointers[i] == tileElement)
+        {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
 /**
  *
  *  rct2: 0x0068B280
  */
 void tile_element_remove(rct_tile_element *tileElement)
 {
+    // If the surface element moves, the surface position of the tile has to be found again
+    bool surfaceMoved = tileElement->GetType() == TILE_ELEMENT_TYPE_SURFACE;
+    bool isTrack = tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK;
+    size_t tileIndex = surfaceMoved || isTrack ? map_get_element_tile_index(tileElement) : SIZE_MAX;
+
+    // Only the ride presence cell of the tile needs rebuilding, ghost track is removed every tick while building
+    if (isTrack)
+    {
+        if (tileIndex != SIZE_MAX)
+        {
+            ride_presence_invalidate_tile((int32_t)(tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL), (int32_t)(tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL));
+        }
+        else
+        {
+            ride_presence_invalidate_all();
+        }
+    }
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
     if (!tileElement->IsLastForTile()){
+        rct_tile_element * removedElement = tileElement;
         do{
+            if (!surfaceMoved && (tileElement + 1)->GetType() == TILE_ELEMENT_TYPE_SURFACE)
+            {
+                surfaceMoved = true;
+                if (!isTrack)
+                {
+                    tileIndex = map_get_element_tile_index(removedElement);
+                }
+            }
             *tileElement = *(tileElement + 1);
         } while (!(++tileElement)->IsLastForTile());
     }
 
+    if (surfaceMoved)
+    {
+        if (tileIndex != SIZE_MAX)
+        {
+            map_invalidate_tile_element_index((int32_t)(tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL), (int32_t)(tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL));
+        }
+        else
+        {
+            auto& surfaceIndices = _tileElementStorage->TileSurfaceIndices;
+            std::fill(surfaceIndices.begin(), surfaceIndices.end(), TILE_SURFACE_INDEX_UNKNOWN);
+        }
+    }
+
     // Mark the latest element with the last element flag.
     (tileElement - 1)->flags |= TILE_ELEMENT_FLAG_LAST_TILE;
     tileElement->base_height = 0xFF;
@@ -2996,6 +3214,7 @@ void map_remove_all_rides()
             {
                 it.element->properties.path.type &= ~8;
                 it.element->properties.path.addition_status = 255;
+                footpath_invalidate_wide_flags(it.x * 32, it.y * 32);
             }
             break;
         case TILE_ELEMENT_TYPE_ENTRANCE:
@@ -3083,12 +3302,7 @@ void map_invalidate_selection_rect()
     bottom += 32;
     top -= 32 + 2080;
 
-    for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++) {
-        rct_viewport *viewport = &g_viewport_list[i];
-        if (viewport->width != 0) {
-            viewport_invalidate(viewport, left, top, right, bottom);
-        }
-    }
+    viewports_invalidate(left, top, right, bottom);
 }
 
 /**
@@ -3099,7 +3313,8 @@ void map_reorganise_elements()
 {
     context_setcurrentcursor(CURSOR_ZZZ);
 
-    rct_tile_element* new_tile_elements = (rct_tile_element *)malloc(3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) * sizeof(rct_tile_element));
+    const size_t capacity = _tileElementStorage->Elements.size();
+    rct_tile_element* new_tile_elements = (rct_tile_element *)malloc(capacity * sizeof(rct_tile_element));
     rct_tile_element* new_elements_pointer = new_tile_elements;
 
     if (new_tile_elements == nullptr) {
@@ -3123,7 +3338,7 @@ void map_reorganise_elements()
 
     num_elements = (uint32_t)(new_elements_pointer - new_tile_elements);
     memcpy(gTileElements, new_tile_elements, num_elements * sizeof(rct_tile_element));
-    memset(gTileElements + num_elements, 0, (3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) - num_elements) * sizeof(rct_tile_element));
+    memset(gTileElements + num_elements, 0, (capacity - num_elements) * sizeof(rct_tile_element));
 
     free(new_tile_elements);
 
@@ -3140,7 +3355,7 @@ bool map_check_free_elements_and_reorganise(int32_t numElements)
 {
     if (numElements != 0)
     {
-        auto tileElementEnd = &gTileElements[MAX_TILE_ELEMENTS];
+        auto tileElementEnd = &gTileElements[_tileElementStorage->MaxElements];
 
         // Check if is there is room for the required number of elements
         auto newTileElementEnd = gNextFreeTileElement + numElements;
@@ -3217,6 +3432,9 @@ rct_tile_element *tile_element_insert(int32_t x, int32_t y, int32_t z, int32_t f
     }
 
     gNextFreeTileElement = newTileElement;
+    map_invalidate_tile_element_index(x, y);
+    map_mark_tile_changed(x, y);
+    ride_presence_invalidate_tile(x, y);
     return insertedElement;
 }
 
@@ -3450,6 +3668,7 @@ int32_t map_can_construct_at(int32_t x, int32_t y, int32_t zLow, int32_t zHigh,
  */
 void map_update_tiles()
 {
+    PROFILE_SCOPE("map_update_tiles");
     int32_t ignoreScreenFlags = SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER;
     if (gScreenFlags & ignoreScreenFlags)
         return;
@@ -3825,7 +4044,7 @@ int32_t map_get_highest_z(int32_t tileX, int32_t tileY)
 
 rct_tile_element *map_get_large_scenery_segment(int32_t x, int32_t y, int32_t z, int32_t direction, int32_t sequence)
 {
-    rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
+    rct_tile_element *tileElement = map_get_first_element_of_type_at(x >> 5, y >> 5, TILE_ELEMENT_TYPE_LARGE_SCENERY);
     if (tileElement == nullptr)
     {
         return nullptr;
@@ -3847,7 +4066,7 @@ rct_tile_element *map_get_large_scenery_segment(int32_t x, int32_t y, int32_t z,
 
 rct_tile_element * map_get_park_entrance_element_at(int32_t x, int32_t y, int32_t z, bool ghost)
 {
-    rct_tile_element* tileElement = map_get_first_element_at(x >> 5, y >> 5);
+    rct_tile_element* tileElement = map_get_first_element_of_type_at(x >> 5, y >> 5, TILE_ELEMENT_TYPE_ENTRANCE);
     if (tileElement != nullptr)
     {
         do
@@ -3873,7 +4092,7 @@ rct_tile_element * map_get_park_entrance_element_at(int32_t x, int32_t y, int32_
 
 rct_tile_element * map_get_ride_entrance_element_at(int32_t x, int32_t y, int32_t z, bool ghost)
 {
-    rct_tile_element * tileElement = map_get_first_element_at(x >> 5, y >> 5);
+    rct_tile_element * tileElement = map_get_first_element_of_type_at(x >> 5, y >> 5, TILE_ELEMENT_TYPE_ENTRANCE);
     if (tileElement != nullptr)
     {
         do
@@ -3899,7 +4118,7 @@ rct_tile_element * map_get_ride_entrance_element_at(int32_t x, int32_t y, int32_
 
 rct_tile_element * map_get_ride_exit_element_at(int32_t x, int32_t y, int32_t z, bool ghost)
 {
-    rct_tile_element * tileElement = map_get_first_element_at(x >> 5, y >> 5);
+    rct_tile_element * tileElement = map_get_first_element_of_type_at(x >> 5, y >> 5, TILE_ELEMENT_TYPE_ENTRANCE);
     if (tileElement != nullptr)
     {
         do
@@ -3925,7 +4144,7 @@ rct_tile_element * map_get_ride_exit_element_at(int32_t x, int32_t y, int32_t z,
 
 rct_tile_element *map_get_small_scenery_element_at(int32_t x, int32_t y, int32_t z, int32_t type, uint8_t quadrant)
 {
-    rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
+    rct_tile_element *tileElement = map_get_first_element_of_type_at(x >> 5, y >> 5, TILE_ELEMENT_TYPE_SMALL_SCENERY);
     if (tileElement != nullptr)
     {
         do
@@ -4085,12 +4304,7 @@ static void map_invalidate_tile_under_zoom(int32_t x, int32_t y, int32_t z0, int
     x2 = x + 32;
     y2 = y + 32 - z0;
 
-    for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++) {
-        rct_viewport *viewport = &g_viewport_list[i];
-        if (viewport->width != 0 && (maxZoom == -1 || viewport->zoom <= maxZoom)) {
-            viewport_invalidate(viewport, x1, y1, x2, y2);
-        }
-    }
+    viewports_invalidate(x1, y1, x2, y2, maxZoom);
 }
 
 /**
@@ -4099,6 +4313,7 @@ static void map_invalidate_tile_under_zoom(int32_t x, int32_t y, int32_t z0, int
  */
 void map_invalidate_tile(int32_t x, int32_t y, int32_t z0, int32_t z1)
 {
+    map_mark_tile_changed(x / 32, y / 32);
     map_invalidate_tile_under_zoom(x, y, z0, z1, -1);
 }
 
@@ -4138,6 +4353,14 @@ void map_invalidate_region(const LocationXY16& mins, const LocationXY16& maxs)
 {
     int32_t x0, y0, x1, y1, left, right, top, bottom;
 
+    for (int32_t y = mins.y / 32; y <= maxs.y / 32; y++)
+    {
+        for (int32_t x = mins.x / 32; x <= maxs.x / 32; x++)
+        {
+            map_mark_tile_changed(x, y);
+        }
+    }
+
     x0 = mins.x + 16;
     y0 = mins.y + 16;
 
@@ -4151,14 +4374,7 @@ void map_invalidate_region(const LocationXY16& mins, const LocationXY16& maxs)
     bottom += 32;
     top -= 32 + 2080;
 
-    for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++)
-    {
-        rct_viewport *viewport = &g_viewport_list[i];
-        if (viewport->width != 0)
-        {
-            viewport_invalidate(viewport, left, top, right, bottom);
-        }
-    }
+    viewports_invalidate(left, top, right, bottom);
 }
 
 int32_t map_get_tile_side(int32_t mapX, int32_t mapY)
@@ -4472,6 +4688,12 @@ void game_command_modify_tile(
         break;
     }
 
+    if ((flags & GAME_COMMAND_FLAG_APPLY) && *ebx != MONEY32_UNDEFINED)
+    {
+        // Any of the instructions may have added, removed or changed a footpath element on this tile
+        footpath_invalidate_wide_flags(x * 32, y * 32);
+    }
+
     if (flags & GAME_COMMAND_FLAG_APPLY &&
             gGameCommandNestLevel == 1 &&
             !(flags & GAME_COMMAND_FLAG_GHOST) &&
@@ -4493,7 +4715,9 @@ void game_command_modify_tile(
  */
 rct_tile_element *map_get_track_element_at(int32_t x, int32_t y, int32_t z)
 {
-    rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
+    rct_tile_element *tileElement = map_get_first_element_of_type_at(x >> 5, y >> 5, TILE_ELEMENT_TYPE_TRACK);
+    if (tileElement == nullptr)
+        return nullptr;
     do {
         if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK) continue;
         if (tileElement->base_height != z) continue;
@@ -4512,7 +4736,9 @@ rct_tile_element *map_get_track_element_at(int32_t x, int32_t y, int32_t z)
  */
 rct_tile_element *map_get_track_element_at_of_type(int32_t x, int32_t y, int32_t z, int32_t trackType)
 {
-    rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
+    rct_tile_element *tileElement = map_get_first_element_of_type_at(x >> 5, y >> 5, TILE_ELEMENT_TYPE_TRACK);
+    if (tileElement == nullptr)
+        return nullptr;
     do {
         if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK) continue;
         if (tileElement->base_height != z) continue;
@@ -4532,7 +4758,7 @@ rct_tile_element *map_get_track_element_at_of_type(int32_t x, int32_t y, int32_t
  */
 rct_tile_element *map_get_track_element_at_of_type_seq(int32_t x, int32_t y, int32_t z, int32_t trackType, int32_t sequence)
 {
-    rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
+    rct_tile_element *tileElement = map_get_first_element_of_type_at(x >> 5, y >> 5, TILE_ELEMENT_TYPE_TRACK);
     do {
         if (tileElement == nullptr) break;
         if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK) continue;
@@ -4553,7 +4779,9 @@ rct_tile_element *map_get_track_element_at_of_type_seq(int32_t x, int32_t y, int
  * @param z Base height.
  */
 rct_tile_element *map_get_track_element_at_of_type_from_ride(int32_t x, int32_t y, int32_t z, int32_t trackType, int32_t rideIndex) {
-    rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
+    rct_tile_element *tileElement = map_get_first_element_of_type_at(x >> 5, y >> 5, TILE_ELEMENT_TYPE_TRACK);
+    if (tileElement == nullptr)
+        return nullptr;
     do {
         if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK) continue;
         if (tileElement->base_height != z) continue;
@@ -4573,7 +4801,9 @@ rct_tile_element *map_get_track_element_at_of_type_from_ride(int32_t x, int32_t
  * @param z Base height.
  */
 rct_tile_element *map_get_track_element_at_from_ride(int32_t x, int32_t y, int32_t z, int32_t rideIndex) {
-    rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
+    rct_tile_element *tileElement = map_get_first_element_of_type_at(x >> 5, y >> 5, TILE_ELEMENT_TYPE_TRACK);
+    if (tileElement == nullptr)
+        return nullptr;
     do {
         if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK) continue;
         if (tileElement->base_height != z) continue;
@@ -4594,7 +4824,9 @@ rct_tile_element *map_get_track_element_at_from_ride(int32_t x, int32_t y, int32
  */
 rct_tile_element *map_get_track_element_at_with_direction_from_ride(int32_t x, int32_t y, int32_t z, int32_t direction, int32_t rideIndex)
 {
-    rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
+    rct_tile_element *tileElement = map_get_first_element_of_type_at(x >> 5, y >> 5, TILE_ELEMENT_TYPE_TRACK);
+    if (tileElement == nullptr)
+        return nullptr;
     do {
         if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK) continue;
         if (tileElement->base_height != z) continue;
@@ -4631,7 +4863,9 @@ void map_offset_with_rotation(int16_t *x, int16_t *y, int16_t offsetX, int16_t o
 
 rct_tile_element *map_get_wall_element_at(int32_t x, int32_t y, int32_t z, int32_t direction)
 {
-    rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
+    rct_tile_element *tileElement = map_get_first_element_of_type_at(x >> 5, y >> 5, TILE_ELEMENT_TYPE_WALL);
+    if (tileElement == nullptr)
+        return nullptr;
     do {
         if (tileElement->GetType() != TILE_ELEMENT_TYPE_WALL)
             continue;
@@ -4708,3 +4942,52 @@ uint8_t entrance_element_get_type(const rct_tile_element * tileElement)
 {
     return (tileElement->properties.entrance.type);
 }
+
+/**
+ * Records that the contents of the given tile (in tile coordinates) have changed so that
+ * consumers such as the minimap can refresh only the tiles that need it.
+ */
+void map_mark_tile_changed(int32_t x, int32_t y)
+{
+    if (_allTilesChanged)
+        return;
+    if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return;
+
+    size_t index = y * MAXIMUM_MAP_SIZE_TECHNICAL + x;
+    if (_changedTileGrid[index])
+        return;
+
+    if (_changedTiles.size() >= MAX_CHANGED_TILES)
+    {
+        map_mark_all_tiles_changed();
+        return;
+    }
+    _changedTileGrid[index] = true;
+    _changedTiles.emplace_back(x, y);
+}
+
+void map_mark_all_tiles_changed()
+{
+    _allTilesChanged = true;
+    _changedTiles.clear();
+    _changedTileGrid.reset();
+}
+
+/**
+ * Moves the tiles that have changed since the last call into changedTiles.
+ * @returns true if the whole map should be treated as changed, in which case changedTiles is empty.
+ */
+bool map_take_changed_tiles(std::vector<TileCoordsXY>& changedTiles)
+{
+    bool allTilesChanged = _allTilesChanged;
+    _allTilesChanged = false;
+
+    changedTiles.clear();
+    std::swap(changedTiles, _changedTiles);
+    for (const auto& tile : changedTiles)
+    {
+        _changedTileGrid[tile.y * MAXIMUM_MAP_SIZE_TECHNICAL + tile.x] = false;
+    }
+    return allTilesChanged;
+}
@@ -11,6 +11,7 @@
 #define _MAP_H_
 
 #include <initializer_list>
+#include <vector>
 #include "../common.h"
 #include "Location.hpp"
 #include "TileElement.h"
@@ -99,8 +100,30 @@ extern uint8_t        gMapSelectArrowDirection;
 
 extern uint8_t gMapGroundFlags;
 
-extern rct_tile_element gTileElements[MAX_TILE_TILE_ELEMENT_POINTERS * 3];
-extern rct_tile_element *gTileElementTilePointers[MAX_TILE_TILE_ELEMENT_POINTERS];
+/**
+ * Holds the tile elements of a map and the pointer to the first element of each tile. The park has its own
+ * storage, other maps such as the track design preview can use a separate, smaller one. gTileElements,
+ * gTileElementTilePointers and gNextFreeTileElement always refer to the current storage.
+ */
+struct TileElementStorage
+{
+    std::vector<rct_tile_element> Elements;
+    std::vector<rct_tile_element *> TilePointers;
+    rct_tile_element * NextFreeElement = nullptr;
+    // Number of elements that can be used, may be less than the size of Elements
+    size_t MaxElements = 0;
+    // Bit (1 << (type >> 2)) is set for every element type that may be on the tile
+    std::vector<uint16_t> TileTypeMasks;
+    // Position of the surface element within each tile, TILE_SURFACE_INDEX_UNKNOWN if it has to be searched for
+    std::vector<uint8_t> TileSurfaceIndices;
+
+    TileElementStorage(size_t capacity, size_t maxElements);
+};
+
+constexpr uint8_t TILE_SURFACE_INDEX_UNKNOWN = 0xFF;
+
+extern rct_tile_element *gTileElements;
+extern rct_tile_element **gTileElementTilePointers;
 
 extern LocationXY16 gMapSelectionTiles[300];
 extern PeepSpawn gPeepSpawns[MAX_PEEP_SPAWNS];
@@ -128,6 +151,10 @@ void map_init(int32_t size);
 void map_count_remaining_land_rights();
 void map_strip_ghost_flag_from_elements();
 void map_update_tile_pointers();
+void map_rebuild_tile_element_index();
+void map_update_tile_element_index();
+TileElementStorage * map_get_tile_element_storage();
+void map_set_tile_element_storage(TileElementStorage * storage);
 rct_tile_element *map_get_first_element_at(int32_t x, int32_t y);
 rct_tile_element *map_get_nth_element_at(int32_t x, int32_t y, int32_t n);
 void map_set_tile_elements(int32_t x, int32_t y, rct_tile_element *elements);
@@ -235,6 +262,10 @@ void map_invalidate_tile_full(int32_t x, int32_t y);
 void map_invalidate_element(int32_t x, int32_t y, rct_tile_element *tileElement);
 void map_invalidate_region(const LocationXY16& mins, const LocationXY16& maxs);
 
+void map_mark_tile_changed(int32_t x, int32_t y);
+void map_mark_all_tiles_changed();
+bool map_take_changed_tiles(std::vector<TileCoordsXY>& changedTiles);
+
 int32_t map_get_tile_side(int32_t mapX, int32_t mapY);
 int32_t map_get_tile_quadrant(int32_t mapX, int32_t mapY);
 
@@ -10,6 +10,7 @@
 #include "../Cheats.h"
 #include "../Context.h"
 #include "../config/Config.h"
+#include "../core/JobPool.hpp"
 #include "../core/Math.hpp"
 #include "../core/Memory.hpp"
 #include "../core/Util.hpp"
@@ -28,6 +29,7 @@
 #include "../OpenRCT2.h"
 #include "../peep/Peep.h"
 #include "../peep/Staff.h"
+#include "../Profiling.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
 #include "../ride/ShopItem.h"
@@ -63,6 +65,9 @@ uint8_t gGuestsInParkHistory[32];
 // If this value is more than or equal to 0, the park rating is forced to this value. Used for cheat
 static int32_t _forcedParkRating = -1;
 
+// Kept for the whole session so that the park statistics do not start new threads every update
+static std::unique_ptr<JobPool> _parkJobPool;
+
 /**
  * In a difficult guest generation scenario, no guests will be generated if over this value.
  */
@@ -567,25 +572,51 @@ void Park::Initialise()
 
 void Park::Update(const Date &date)
 {
+    PROFILE_SCOPE("Park::Update");
     // Every ~13 seconds
     if (gCurrentTicks % 512 == 0)
     {
-        gParkRating = CalculateParkRating();
-        gParkValue = CalculateParkValue();
+        // Every ~102 seconds
+        bool updateParkSize = gCurrentTicks % 4096 == 0;
+
+        // These only read the guests, rides, litter and map, and none of them reads a value another one
+        // produces, so they are calculated at the same time. The results are stored in the original order
+        // afterwards, before the company value and guest generation probability which depend on them.
+        int32_t parkRating = 0;
+        money32 parkValue = 0;
+        money16 totalRideValueForMoney = 0;
+        uint32_t suggestedGuestMaximum = 0;
+        int32_t parkSize = 0;
+        if (_parkJobPool == nullptr)
+        {
+            _parkJobPool = std::make_unique<JobPool>();
+        }
+        _parkJobPool->AddTask([this, &parkRating]() { parkRating = CalculateParkRating(); });
+        _parkJobPool->AddTask([this, &parkValue]() { parkValue = CalculateParkValue(); });
+        _parkJobPool->AddTask([this, &totalRideValueForMoney]() { totalRideValueForMoney = CalculateTotalRideValueForMoney(); });
+        _parkJobPool->AddTask([this, &suggestedGuestMaximum]() { suggestedGuestMaximum = CalculateSuggestedMaxGuests(); });
+        if (updateParkSize)
+        {
+            _parkJobPool->AddTask([this, &parkSize]() { parkSize = CalculateParkSize(); });
+        }
+        _parkJobPool->Join();
+
+        gParkRating = parkRating;
+        gParkValue = parkValue;
         gCompanyValue = CalculateCompanyValue();
-        gTotalRideValueForMoney = CalculateTotalRideValueForMoney();
-        _suggestedGuestMaximum = CalculateSuggestedMaxGuests();
+        gTotalRideValueForMoney = totalRideValueForMoney;
+        _suggestedGuestMaximum = suggestedGuestMaximum;
         _guestGenerationProbability = CalculateGuestGenerationProbability();
 
         window_invalidate_by_class(WC_FINANCES);
         auto intent = Intent(INTENT_ACTION_UPDATE_PARK_RATING);
         context_broadcast_intent(&intent);
-    }
-    // Every ~102 seconds
-    if (gCurrentTicks % 4096 == 0)
-    {
-        gParkSize = CalculateParkSize();
-        window_invalidate_by_class(WC_PARK_INFORMATION);
+
+        if (updateParkSize)
+        {
+            gParkSize = parkSize;
+            window_invalidate_by_class(WC_PARK_INFORMATION);
+        }
     }
     // Every new week
     if (date.IsWeekStart())
@@ -612,11 +643,6 @@ int32_t Park::CalculateParkSize() const
         }
     } while (tile_element_iterator_next(&it));
 
-    if (tiles != gParkSize) {
-        gParkSize = tiles;
-        window_invalidate_by_class(WC_PARK_INFORMATION);
-    }
-
     return tiles;
 }
 
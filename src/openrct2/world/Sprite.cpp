@@ -9,6 +9,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
 #include "../audio/audio.h"
 #include "../Cheats.h"
 #include "../core/Crypt.h"
@@ -20,15 +23,20 @@
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
 #include "../OpenRCT2.h"
+#include "../Profiling.h"
 #include "../scenario/Scenario.h"
 #include "Fountain.h"
 #include "Sprite.h"
 
 uint16_t gSpriteListHead[6];
 uint16_t gSpriteListCount[6];
-static rct_sprite _spriteList[MAX_SPRITES];
 
-static bool _spriteFlashingList[MAX_SPRITES];
+// Sprites are kept in fixed size chunks so that growing the list never moves
+// existing sprites, any rct_sprite pointers held elsewhere stay valid. The chunks
+// holding the first MAX_SPRITES are never freed.
+static std::vector<std::unique_ptr<rct_sprite[]>> _spriteChunks;
+
+static std::vector<bool> _spriteFlashingList;
 
 #define SPATIAL_INDEX_LOCATION_NULL 0x10000
 
@@ -49,25 +57,99 @@ const rct_string_id litterNames[12] = {
     STR_SHOP_ITEM_SINGULAR_EMPTY_BOWL_BLUE
 };
 
-static LocationXYZ16 _spritelocations1[MAX_SPRITES];
-static LocationXYZ16 _spritelocations2[MAX_SPRITES];
+static std::vector<LocationXYZ16> _spritelocations1;
+static std::vector<LocationXYZ16> _spritelocations2;
 
 static size_t GetSpatialIndexOffset(int32_t x, int32_t y);
 
 rct_sprite *try_get_sprite(size_t spriteIndex)
 {
     rct_sprite * sprite = nullptr;
-    if (spriteIndex < MAX_SPRITES)
+    if (spriteIndex < sprite_get_capacity())
     {
-        sprite = &_spriteList[spriteIndex];
+        sprite = &_spriteChunks[spriteIndex / SPRITE_CHUNK_SIZE][spriteIndex % SPRITE_CHUNK_SIZE];
     }
     return sprite;
 }
 
 rct_sprite *get_sprite(size_t sprite_idx)
 {
-    openrct2_assert(sprite_idx < MAX_SPRITES, "Tried getting sprite %u", sprite_idx);
-    return &_spriteList[sprite_idx];
+    openrct2_assert(sprite_idx < sprite_get_capacity(), "Tried getting sprite %u", sprite_idx);
+    return &_spriteChunks[sprite_idx / SPRITE_CHUNK_SIZE][sprite_idx % SPRITE_CHUNK_SIZE];
+}
+
+size_t sprite_get_capacity()
+{
+    return _spriteChunks.size() * SPRITE_CHUNK_SIZE;
+}
+
+/**
+ * Allocates or frees chunks so that the sprite list can hold the given number of
+ * sprites. New sprites are zeroed and are not linked into any sprite list.
+ */
+void sprite_set_capacity(size_t capacity)
+{
+    capacity = Math::Clamp<size_t>(MAX_SPRITES, capacity, MAX_SPRITES_EXTENDED);
+    size_t numChunks = (capacity + SPRITE_CHUNK_SIZE - 1) / SPRITE_CHUNK_SIZE;
+    _spriteChunks.resize(numChunks);
+    for (auto &chunk : _spriteChunks)
+    {
+        if (chunk == nullptr)
+        {
+            chunk = std::make_unique<rct_sprite[]>(SPRITE_CHUNK_SIZE);
+        }
+    }
+
+    capacity = sprite_get_capacity();
+    _spriteFlashingList.resize(capacity);
+    _spritelocations1.resize(capacity);
+    _spritelocations2.resize(capacity);
+}
+
+/**
+ * Returns the number of sprites that can still be created, including the ones
+ * the sprite list is yet to grow by.
+ */
+size_t sprite_get_num_available()
+{
+    return gSpriteListCount[SPRITE_LIST_NULL] + (MAX_SPRITES_EXTENDED - sprite_get_capacity());
+}
+
+/**
+ * Adds another chunk of sprites to the end of the sprite list and puts them at the
+ * front of the null list.
+ */
+static bool sprite_list_grow()
+{
+    size_t oldCapacity = sprite_get_capacity();
+    if (oldCapacity >= MAX_SPRITES_EXTENDED)
+    {
+        return false;
+    }
+
+    sprite_set_capacity(oldCapacity + SPRITE_CHUNK_SIZE);
+    size_t newCapacity = sprite_get_capacity();
+
+    uint16_t oldHead = gSpriteListHead[SPRITE_LIST_NULL];
+    for (size_t i = oldCapacity; i < newCapacity; i++)
+    {
+        rct_unk_sprite *spr = &get_sprite(i)->unknown;
+        spr->sprite_identifier = SPRITE_IDENTIFIER_NULL;
+        spr->sprite_index = (uint16_t)i;
+        spr->linked_list_type_offset = SPRITE_LIST_NULL * 2;
+        spr->next_in_quadrant = SPRITE_INDEX_NULL;
+        spr->previous = i == oldCapacity ? SPRITE_INDEX_NULL : (uint16_t)(i - 1);
+        spr->next = i == newCapacity - 1 ? oldHead : (uint16_t)(i + 1);
+    }
+    if (oldHead != SPRITE_INDEX_NULL)
+    {
+        get_sprite(oldHead)->unknown.previous = (uint16_t)(newCapacity - 1);
+    }
+    gSpriteListHead[SPRITE_LIST_NULL] = (uint16_t)oldCapacity;
+    gSpriteListCount[SPRITE_LIST_NULL] += (uint16_t)(newCapacity - oldCapacity);
+
+    log_verbose("Sprite list grown to %u sprites", (uint32_t)newCapacity);
+    return true;
 }
 
 uint16_t sprite_get_first_in_quadrant(int32_t x, int32_t y)
@@ -80,18 +162,13 @@ static void invalidate_sprite_max_zoom(rct_sprite *sprite, int32_t maxZoom)
 {
     if (sprite->unknown.sprite_left == LOCATION_NULL) return;
 
-    for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++) {
-        rct_viewport *viewport = &g_viewport_list[i];
-        if (viewport->width != 0 && viewport->zoom <= maxZoom) {
-            viewport_invalidate(
-                viewport,
-                sprite->unknown.sprite_left,
-                sprite->unknown.sprite_top,
-                sprite->unknown.sprite_right,
-                sprite->unknown.sprite_bottom
-            );
-        }
-    }
+    viewports_invalidate(
+        sprite->unknown.sprite_left,
+        sprite->unknown.sprite_top,
+        sprite->unknown.sprite_right,
+        sprite->unknown.sprite_bottom,
+        maxZoom
+    );
 }
 
 /**
@@ -130,7 +207,13 @@ void invalidate_sprite_2(rct_sprite *sprite)
 void reset_sprite_list()
 {
     gSavedAge = 0;
-    memset(_spriteList, 0, sizeof(rct_sprite) * MAX_SPRITES);
+
+    // Only the chunks beyond MAX_SPRITES are freed, the base sprites keep their addresses for the life of the process
+    sprite_set_capacity(MAX_SPRITES);
+    for (auto &chunk : _spriteChunks)
+    {
+        std::memset(chunk.get(), 0, SPRITE_CHUNK_SIZE * sizeof(rct_sprite));
+    }
 
     for (int32_t i = 0; i < NUM_SPRITE_LISTS; i++) {
         gSpriteListHead[i] = SPRITE_INDEX_NULL;
@@ -140,7 +223,7 @@ void reset_sprite_list()
 
     rct_sprite* previous_spr = (rct_sprite*)SPRITE_INDEX_NULL;
 
-    for (int32_t i = 0; i < MAX_SPRITES; ++i){
+    for (int32_t i = 0; i < (int32_t)sprite_get_capacity(); ++i){
         rct_sprite *spr = get_sprite(i);
         spr->unknown.sprite_identifier = SPRITE_IDENTIFIER_NULL;
         spr->unknown.sprite_index = i;
@@ -159,7 +242,7 @@ void reset_sprite_list()
         previous_spr = spr;
     }
 
-    gSpriteListCount[SPRITE_LIST_NULL] = MAX_SPRITES;
+    gSpriteListCount[SPRITE_LIST_NULL] = (uint16_t)sprite_get_capacity();
 
     reset_sprite_spatial_index();
 }
@@ -173,7 +256,7 @@ void reset_sprite_list()
 void reset_sprite_spatial_index()
 {
     std::fill_n(gSpriteSpatialIndex, Util::CountOf(gSpriteSpatialIndex), SPRITE_INDEX_NULL);
-    for (size_t i = 0; i < MAX_SPRITES; i++) {
+    for (size_t i = 0; i < sprite_get_capacity(); i++) {
         rct_sprite *spr = get_sprite(i);
         if (spr->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL) {
             size_t index = GetSpatialIndexOffset(spr->unknown.x, spr->unknown.y);
@@ -219,7 +302,7 @@ const char * sprite_checksum()
         }
 
         _spriteHashAlg->Clear();
-        for (size_t i = 0; i < MAX_SPRITES; i++)
+        for (size_t i = 0; i < sprite_get_capacity(); i++)
         {
             auto sprite = get_sprite(i);
             if (sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL && sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_MISC)
@@ -324,11 +407,11 @@ rct_sprite *create_sprite(uint8_t bl)
     if ((bl & 2) != 0) {
         // 69EC96;
         uint16_t cx = 0x12C - gSpriteListCount[SPRITE_LIST_MISC];
-        if (cx >= gSpriteListCount[SPRITE_LIST_NULL]) {
+        if (cx >= gSpriteListCount[SPRITE_LIST_NULL] && !sprite_list_grow()) {
             return nullptr;
         }
         linkedListTypeOffset = SPRITE_LIST_MISC * 2;
-    } else if (gSpriteListCount[SPRITE_LIST_NULL] == 0) {
+    } else if (gSpriteListCount[SPRITE_LIST_NULL] == 0 && !sprite_list_grow()) {
         return nullptr;
     }
 
@@ -538,6 +621,7 @@ static void sprite_misc_update(rct_sprite *sprite)
  */
 void sprite_misc_update_all()
 {
+    PROFILE_SCOPE("sprite_misc_update_all");
     rct_sprite *sprite;
     uint16_t spriteIndex;
 
@@ -757,12 +841,12 @@ static bool sprite_should_tween(rct_sprite *sprite)
     return false;
 }
 
-static void store_sprite_locations(LocationXYZ16 * sprite_locations)
+static void store_sprite_locations(std::vector<LocationXYZ16> &sprite_locations)
 {
-    for (uint16_t i = 0; i < MAX_SPRITES; i++) {
+    for (size_t i = 0; i < sprite_locations.size(); i++) {
         // skip going through `get_sprite` to not get stalled on assert,
         // this can get very expensive for busy parks with uncap FPS option on
-        const rct_sprite *sprite = &_spriteList[i];
+        const rct_sprite *sprite = &_spriteChunks[i / SPRITE_CHUNK_SIZE][i % SPRITE_CHUNK_SIZE];
         sprite_locations[i].x = sprite->unknown.x;
         sprite_locations[i].y = sprite->unknown.y;
         sprite_locations[i].z = sprite->unknown.z;
@@ -783,7 +867,7 @@ void sprite_position_tween_all(float alpha)
 {
     const float inv = (1.0f - alpha);
 
-    for (uint16_t i = 0; i < MAX_SPRITES; i++) {
+    for (size_t i = 0; i < sprite_get_capacity(); i++) {
         rct_sprite * sprite = get_sprite(i);
         if (sprite_should_tween(sprite)) {
             LocationXYZ16 posA = _spritelocations1[i];
@@ -807,7 +891,7 @@ void sprite_position_tween_all(float alpha)
  */
 void sprite_position_tween_restore()
 {
-    for (uint16_t i = 0; i < MAX_SPRITES; i++) {
+    for (size_t i = 0; i < sprite_get_capacity(); i++) {
         rct_sprite * sprite = get_sprite(i);
         if (sprite_should_tween(sprite)) {
             invalidate_sprite_2(sprite);
@@ -820,7 +904,7 @@ void sprite_position_tween_restore()
 
 void sprite_position_tween_reset()
 {
-    for (uint16_t i = 0; i < MAX_SPRITES; i++) {
+    for (size_t i = 0; i < sprite_get_capacity(); i++) {
         rct_sprite * sprite = get_sprite(i);
         _spritelocations1[i].x =
         _spritelocations2[i].x = sprite->unknown.x;
@@ -833,13 +917,13 @@ void sprite_position_tween_reset()
 
 void sprite_set_flashing(rct_sprite *sprite, bool flashing)
 {
-    assert(sprite->unknown.sprite_index < MAX_SPRITES);
+    assert(sprite->unknown.sprite_index < sprite_get_capacity());
     _spriteFlashingList[sprite->unknown.sprite_index] = flashing;
 }
 
 bool sprite_get_flashing(rct_sprite *sprite)
 {
-    assert(sprite->unknown.sprite_index < MAX_SPRITES);
+    assert(sprite->unknown.sprite_index < sprite_get_capacity());
     return _spriteFlashingList[sprite->unknown.sprite_index];
 }
 
@@ -973,7 +1057,7 @@ int32_t check_for_sprite_list_cycles(bool fix)
 int32_t fix_disjoint_sprites()
 {
     // Find reachable sprites
-    bool reachable[MAX_SPRITES] = { false };
+    std::vector<bool> reachable(sprite_get_capacity(), false);
     uint16_t sprite_idx = gSpriteListHead[SPRITE_LIST_NULL];
     rct_sprite * null_list_tail = nullptr;
     while (sprite_idx != SPRITE_INDEX_NULL)
@@ -987,7 +1071,7 @@ int32_t fix_disjoint_sprites()
     int32_t count = 0;
 
     // Find all null sprites
-    for (sprite_idx = 0; sprite_idx < MAX_SPRITES; sprite_idx++)
+    for (sprite_idx = 0; sprite_idx < sprite_get_capacity(); sprite_idx++)
     {
         rct_sprite * spr = get_sprite(sprite_idx);
         if (spr->unknown.sprite_identifier == SPRITE_IDENTIFIER_NULL)
@@ -15,7 +15,9 @@
 #include "../ride/Vehicle.h"
 
 #define SPRITE_INDEX_NULL       0xFFFF
-#define MAX_SPRITES             10000
+#define MAX_SPRITES             10000   // Sprites allocated up front, also the size of the S6 sprite list
+#define MAX_SPRITES_EXTENDED    50000   // Sprites the list can grow to when the first MAX_SPRITES run out
+#define SPRITE_CHUNK_SIZE       2000
 #define NUM_SPRITE_LISTS        6
 
 enum SPRITE_IDENTIFIER {
@@ -374,6 +376,9 @@ enum {
 
 rct_sprite *try_get_sprite(size_t spriteIndex);
 rct_sprite *get_sprite(size_t sprite_idx);
+size_t sprite_get_capacity();
+void sprite_set_capacity(size_t capacity);
+size_t sprite_get_num_available();
 
 extern uint16_t gSpriteListHead[6];
 extern uint16_t gSpriteListCount[6];
@@ -14,6 +14,7 @@
 #include <openrct2/interface/Viewport.h>
 #include <openrct2/object/Object.h>
 #include <openrct2/paint/tile_element/Paint.TileElement.h>
+#include <openrct2/rct2/RCT2.h>
 #include <openrct2/ride/Ride.h>
 #include <openrct2/ride/Track.h>
 #include <openrct2/world/Location.hpp>
@@ -125,8 +126,13 @@ rct_ride_entry *get_ride_entry_by_ride(Ride *ride) {
     return type;
 }
 
+size_t sprite_get_capacity() {
+    // The sprites are read straight out of RCT2's sprite list
+    return RCT2_MAX_SPRITES;
+}
+
 rct_sprite *get_sprite(size_t sprite_idx) {
-    assert(sprite_idx < MAX_SPRITES);
+    assert(sprite_idx < sprite_get_capacity());
     return &sprite_list[sprite_idx];
 }
 
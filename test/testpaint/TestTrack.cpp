@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -255,6 +256,86 @@ uint8_t TestTrack::TestPaintTrackElement(uint8_t rideType, uint8_t trackType, st
     return retVal;
 }
 
+/**
+ * Paints every sequence of the track element in all rotations, directions and a
+ * spread of heights using only the new paint functions, timing the calls and
+ * counting the paint structs and supports they generate.
+ */
+uint8_t TestTrack::BenchmarkPaintTrackElement(uint8_t rideType, uint8_t trackType, int iterations, PaintBenchmarkResult *result) {
+    *result = {};
+    if (!Utils::rideSupportsTrackType(rideType, trackType)) {
+        return TEST_FAILED;
+    }
+
+    if (rideType == RIDE_TYPE_CHAIRLIFT) {
+        if (trackType == TRACK_ELEM_BEGIN_STATION || trackType == TRACK_ELEM_MIDDLE_STATION ||
+            trackType == TRACK_ELEM_END_STATION) {
+            // These rides check neighbouring tiles for tracks
+            return TEST_SKIPPED;
+        }
+    }
+
+    rct_tile_element tileElement = {};
+    tileElement.flags |= TILE_ELEMENT_FLAG_LAST_TILE;
+    track_element_set_type(&tileElement, trackType);
+
+    rct_tile_element surfaceElement = {};
+    surfaceElement.type = TILE_ELEMENT_TYPE_SURFACE;
+    surfaceElement.base_height = 2;
+
+    gPaintSession.CurrentlyDrawnItem = &tileElement;
+    gPaintSession.SurfaceElement = &surfaceElement;
+    gPaintSession.DidPassSurface = true;
+
+    TestPaint::ResetEnvironment();
+
+    function_call callBuffer[256] = {};
+    int sequenceCount = Utils::getTrackSequenceCount(rideType, trackType);
+    for (int trackSequence = 0; trackSequence < sequenceCount; trackSequence++) {
+        for (uint16_t height = 16; height <= 208; height += 32) {
+            tileElement.base_height = height / 16;
+            for (int currentRotation = 0; currentRotation < 4; currentRotation++) {
+                gCurrentRotation = currentRotation;
+                gPaintSession.CurrentRotation = currentRotation;
+                for (int direction = 0; direction < 4; direction++) {
+                    for (int i = 0; i < iterations; i++) {
+                        PaintIntercept::ClearCalls();
+                        TestPaint::ResetTunnels();
+                        TestPaint::ResetSupportHeights();
+                        gPaintSession.WoodenSupportsPrependTo = nullptr;
+
+                        auto startTime = std::chrono::high_resolution_clock::now();
+                        CallNew(rideType, trackType, direction, trackSequence, height, &tileElement);
+                        auto endTime = std::chrono::high_resolution_clock::now();
+                        result->Nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+                    }
+
+                    int callCount = PaintIntercept::GetCalls(callBuffer);
+                    for (int i = 0; i < callCount; i++) {
+                        switch (callBuffer[i].function) {
+                            case PAINT_98196C:
+                            case PAINT_98197C:
+                            case PAINT_98198C:
+                            case PAINT_98199C:
+                                result->PaintCalls++;
+                                break;
+                            case SUPPORTS_METAL_A:
+                            case SUPPORTS_METAL_B:
+                            case SUPPORTS_WOOD_A:
+                            case SUPPORTS_WOOD_B:
+                                result->SupportCalls++;
+                                break;
+                        }
+                    }
+                    result->Cases++;
+                }
+            }
+        }
+    }
+
+    return TEST_SUCCESS;
+}
+
 static uint8_t TestTrackElementPaintCalls(uint8_t rideType, uint8_t trackType, uint8_t trackSequence, std::string *error) {
     uint16_t height = 3 * 16;
 
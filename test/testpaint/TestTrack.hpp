@@ -13,7 +13,15 @@
 
 #include <openrct2/common.h>
 
+struct PaintBenchmarkResult {
+    uint32_t Cases;
+    uint32_t PaintCalls;
+    uint32_t SupportCalls;
+    uint64_t Nanoseconds;
+};
+
 class TestTrack {
 public:
     static uint8_t TestPaintTrackElement(uint8_t rideType, uint8_t trackType, std::string *out);
+    static uint8_t BenchmarkPaintTrackElement(uint8_t rideType, uint8_t trackType, int iterations, PaintBenchmarkResult *result);
 };
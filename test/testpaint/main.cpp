@@ -415,12 +415,66 @@ static void TestGeneralSupportHeightCall() {
     assert(!success);
 }
 
+struct BenchmarkEntry {
+    uint8_t rideType;
+    int trackTypeCount;
+    PaintBenchmarkResult result;
+};
+
+static int RunBenchmarks(const std::vector<TestCase> &testCases, int iterations) {
+    Write("Benchmarking track paint functions, %d iterations per case.\n", iterations);
+    Write("%-32s %8s %8s %12s %10s %12s %12s\n", "Ride type", "Tracks", "Cases", "Paint calls", "Supports", "Total (ms)", "Per case (ns)");
+
+    std::vector<BenchmarkEntry> entries;
+    for (auto &&tc : testCases) {
+        BenchmarkEntry entry = {};
+        entry.rideType = tc.rideType;
+        for (auto &&trackType : tc.trackTypes) {
+            PaintBenchmarkResult result;
+            if (TestTrack::BenchmarkPaintTrackElement(tc.rideType, trackType, iterations, &result) != TEST_SUCCESS) {
+                continue;
+            }
+
+            entry.trackTypeCount++;
+            entry.result.Cases += result.Cases;
+            entry.result.PaintCalls += result.PaintCalls;
+            entry.result.SupportCalls += result.SupportCalls;
+            entry.result.Nanoseconds += result.Nanoseconds;
+        }
+
+        if (entry.result.Cases == 0) {
+            continue;
+        }
+
+        const PaintBenchmarkResult &r = entry.result;
+        Write("%-32s %8d %8u %12u %10u %12.3f %12.1f\n",
+            RideNames[entry.rideType], entry.trackTypeCount, r.Cases, r.PaintCalls, r.SupportCalls,
+            r.Nanoseconds / 1000000.0, (double)r.Nanoseconds / ((uint64_t)r.Cases * iterations));
+        entries.push_back(entry);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const BenchmarkEntry &a, const BenchmarkEntry &b) {
+        return a.result.Nanoseconds * b.result.Cases > b.result.Nanoseconds * a.result.Cases;
+    });
+
+    Write("\nSlowest ride types per case:\n");
+    for (size_t i = 0; i < entries.size() && i < 10; i++) {
+        const PaintBenchmarkResult &r = entries[i].result;
+        Write(Verbosity::QUIET, "%2d: %-32s %12.1f ns, %5.1f paint calls\n", (int)(i + 1), RideNames[entries[i].rideType],
+            (double)r.Nanoseconds / ((uint64_t)r.Cases * iterations), (double)r.PaintCalls / r.Cases);
+    }
+
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
     TestGeneralSupportHeightCall();
 
     std::vector<TestCase> testCases;
 
     bool generate = false;
+    bool benchmark = false;
+    int benchmarkIterations = 10;
     uint8_t specificRideType = 0xFF;
     for (int i = 0; i < argc; ++i) {
         char *arg = argv[i];
@@ -442,6 +496,15 @@ int main(int argc, char *argv[]) {
         else if (strcmp(arg, "--generate") == 0) {
             generate = true;
         }
+        else if (strcmp(arg, "--benchmark") == 0) {
+            benchmark = true;
+        }
+        else if (strcmp(arg, "--iterations") == 0) {
+            if (i + 1 < argc) {
+                i++;
+                benchmarkIterations = std::max(1, atoi(argv[i]));
+            }
+        }
     }
 
     if (generate) {
@@ -481,6 +544,13 @@ int main(int argc, char *argv[]) {
         testCases.push_back(testCase);
     }
 
+    if (benchmark) {
+        openrct2_setup_rct2_segment();
+        PaintIntercept::InitHooks();
+
+        return RunBenchmarks(testCases, benchmarkIterations);
+    }
+
     int testCaseCount = (int) testCases.size();
     int testCount = 0;
     for (auto &&tc : testCases) {
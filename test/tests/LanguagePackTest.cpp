@@ -7,8 +7,13 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <cstring>
+#include "openrct2/core/File.h"
+#include "openrct2/core/Path.hpp"
 #include "openrct2/localisation/LanguagePack.h"
 #include "openrct2/localisation/StringIds.h"
+#include "openrct2/platform/platform.h"
+#include "openrct2/platform/Platform2.h"
 #include <gtest/gtest.h>
 
 class LanguagePackTest : public testing::Test
@@ -70,6 +75,86 @@ TEST_F(LanguagePackTest, language_pack_multibyte)
     delete lang;
 }
 
+/**
+ * A directory of its own in the system temporary directory that is removed again even when an assertion fails.
+ */
+class TemporaryDirectory final
+{
+private:
+    std::string _path;
+
+public:
+    explicit TemporaryDirectory(const char * name)
+    {
+        std::string basePath;
+        for (const char * variable : { "TMPDIR", "TEMP", "TMP" })
+        {
+            basePath = Platform::GetEnvironmentVariable(variable);
+            if (!basePath.empty())
+            {
+                break;
+            }
+        }
+        _path = Path::Combine(basePath.empty() ? "/tmp" : basePath, name);
+        if (Path::DirectoryExists(_path))
+        {
+            platform_directory_delete(_path.c_str());
+        }
+        Path::CreateDirectory(_path);
+    }
+
+    ~TemporaryDirectory()
+    {
+        platform_directory_delete(_path.c_str());
+    }
+
+    std::string GetFilePath(const char * fileName) const
+    {
+        return Path::Combine(_path, fileName);
+    }
+};
+
+TEST_F(LanguagePackTest, language_pack_compiled)
+{
+    TemporaryDirectory directory("openrct2_language_pack_compiled");
+    std::string languagePathString = directory.GetFilePath("language.txt");
+    std::string cachePathString = directory.GetFilePath("language.dat");
+    const utf8 * languagePath = languagePathString.c_str();
+    const utf8 * cachePath = cachePathString.c_str();
+    File::WriteAllBytes(languagePath, LanguageEnGB, strlen(LanguageEnGB));
+
+    // The first load compiles the language file, the second one reads the cache
+    ILanguagePack * compiled = LanguagePackFactory::FromFile(0, languagePath, cachePath);
+    ASSERT_NE(compiled, nullptr);
+    ASSERT_TRUE(File::Exists(cachePath));
+    ILanguagePack * cached = LanguagePackFactory::FromFile(0, languagePath, cachePath);
+    ASSERT_NE(cached, nullptr);
+    ASSERT_EQ(cached->GetCount(), compiled->GetCount());
+    for (rct_string_id i = 0; i < compiled->GetCount(); i++)
+    {
+        ASSERT_STREQ(cached->GetString(i), compiled->GetString(i));
+    }
+    ASSERT_EQ(cached->GetScenarioOverrideStringId("Arid Heights", 2), 0x7002);
+    ASSERT_STREQ(cached->GetString(0x7000), "Arid Heights scenario string");
+    ASSERT_EQ(cached->GetObjectOverrideStringId("CONDORRD", 1), 0x6001);
+    ASSERT_STREQ(cached->GetString(0x6001), "ride description");
+    cached->SetString(2, "Corkscrew Roller Coaster");
+    ASSERT_STREQ(cached->GetString(2), "Corkscrew Roller Coaster");
+    cached->RemoveString(2);
+    ASSERT_EQ(cached->GetString(2), nullptr);
+    delete cached;
+    delete compiled;
+
+    // A changed language file must not be served from the old cache
+    const utf8 * changedLanguage = "STR_0000    :Changed\n";
+    File::WriteAllBytes(languagePath, changedLanguage, strlen(changedLanguage));
+    ILanguagePack * changed = LanguagePackFactory::FromFile(0, languagePath, cachePath);
+    ASSERT_NE(changed, nullptr);
+    ASSERT_EQ(changed->GetCount(), 1);
+    ASSERT_STREQ(changed->GetString(0), "Changed");
+    delete changed;
+}
+
 const utf8 * LanguagePackTest::LanguageEnGB = "# STR_XXXX part is read and XXXX becomes the string id number.\n"
                                               "# Everything after the colon and before the new line will be saved as the "
                                               "string.\n"
@@ -0,0 +1,81 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/object/Object.h>
+
+/**
+ * The checksum as RCT2 calculates it, summing every 32nd byte once for each of the 32 offsets.
+ * Objects are matched by this checksum when joining a server, so the optimised one must never differ.
+ */
+static int32_t CalculateChecksumStrided(const rct_object_entry * entry, const void * data, size_t dataLength)
+{
+    const uint8_t * entryBytePtr = (const uint8_t *)entry;
+
+    uint32_t checksum = 0xF369A75B;
+    checksum ^= entryBytePtr[0];
+    checksum = rol32(checksum, 11);
+    for (int32_t i = 4; i < 12; i++)
+    {
+        checksum ^= entryBytePtr[i];
+        checksum = rol32(checksum, 11);
+    }
+
+    const uint8_t * dataBytes = (const uint8_t *)data;
+    const size_t dataLength32 = dataLength - (dataLength & 31);
+    for (size_t i = 0; i < 32; i++)
+    {
+        for (size_t j = i; j < dataLength32; j += 32)
+        {
+            checksum ^= dataBytes[j];
+        }
+        checksum = rol32(checksum, 11);
+    }
+    for (size_t i = dataLength32; i < dataLength; i++)
+    {
+        checksum ^= dataBytes[i];
+        checksum = rol32(checksum, 11);
+    }
+    return (int32_t)checksum;
+}
+
+TEST(ObjectChecksum, MatchesStridedChecksum)
+{
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<int32_t> byteDistribution(0, 255);
+
+    rct_object_entry entry = {};
+    for (auto &ch : entry.name)
+    {
+        ch = (char)byteDistribution(random);
+    }
+    entry.flags = random();
+    entry.checksum = random();
+
+    // Lengths below 32 only have a tail, the others a mix of whole blocks and a tail of every size
+    const size_t lengths[] = { 0, 1, 7, 31, 32, 33, 63, 64, 65, 95, 100, 1000, 1024, 4097, 65537 };
+    for (size_t length : lengths)
+    {
+        std::vector<uint8_t> data(length);
+        for (auto &b : data)
+        {
+            b = (uint8_t)byteDistribution(random);
+        }
+
+        // Misalign the data as well, the fold reads it eight bytes at a time
+        std::vector<uint8_t> misaligned(length + 1);
+        std::copy(data.begin(), data.end(), misaligned.begin() + 1);
+
+        int32_t expected = CalculateChecksumStrided(&entry, data.data(), data.size());
+        ASSERT_EQ(object_calculate_checksum(&entry, data.data(), data.size()), expected) << "length " << length;
+        ASSERT_EQ(object_calculate_checksum(&entry, misaligned.data() + 1, length), expected) << "length " << length;
+    }
+}
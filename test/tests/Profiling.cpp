@@ -0,0 +1,122 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <openrct2/Profiling.h>
+
+class Profiling : public testing::Test
+{
+protected:
+    static constexpr double SlowMilliseconds = 10.0;
+
+    void SetUp() override
+    {
+        profiling_start();
+    }
+
+    void TearDown() override
+    {
+        profiling_stop();
+    }
+
+    // Records a scope that takes at least SlowMilliseconds
+    static void SlowScope(const char * name)
+    {
+        ProfileScope scope(name);
+        auto end = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(SlowMilliseconds);
+        while (std::chrono::steady_clock::now() < end)
+        {
+        }
+    }
+
+    // Records a scope 100 times, with the given number of those calls being slow
+    static void RepeatScope(const char * name, int32_t slowCalls)
+    {
+        for (int32_t i = 0; i < 100; i++)
+        {
+            if (i < slowCalls)
+            {
+                SlowScope(name);
+            }
+            else
+            {
+                ProfileScope scope(name);
+            }
+        }
+    }
+};
+
+constexpr double Profiling::SlowMilliseconds;
+
+TEST_F(Profiling, ReportFollowsCallTree)
+{
+    {
+        ProfileScope outer("Outer");
+        RepeatScope("Leaf", 0);
+        {
+            ProfileScope middle("Middle");
+            RepeatScope("Leaf", 0);
+        }
+    }
+    {
+        ProfileScope other("Other");
+        ProfileScope leaf("Leaf");
+    }
+    profiling_stop();
+    {
+        ProfileScope ignored("Ignored");
+    }
+
+    // Each scope follows the scope it was called from, and scopes with the same name are kept apart by their caller
+    auto report = profiling_get_report();
+    ASSERT_EQ(report.size(), 6U);
+    const std::pair<const char *, uint32_t> expected[] = {
+        { "Outer", 0 }, { "Leaf", 1 }, { "Middle", 1 }, { "Leaf", 2 }, { "Other", 0 }, { "Leaf", 1 },
+    };
+    const uint64_t expectedCalls[] = { 1, 100, 1, 100, 1, 1 };
+    for (size_t i = 0; i < report.size(); i++)
+    {
+        ASSERT_EQ(report[i].name, expected[i].first);
+        ASSERT_EQ(report[i].depth, expected[i].second);
+        ASSERT_EQ(report[i].calls, expectedCalls[i]);
+    }
+    ASSERT_EQ(profiling_get_event_count(), 204U);
+    ASSERT_GE(report[0].total_milliseconds, report[1].total_milliseconds + report[2].total_milliseconds);
+}
+
+TEST_F(Profiling, ReportUsesNearestRankPercentiles)
+{
+    // Of 100 sorted calls the 50th, 95th and 99th are the percentiles, so the slow calls only show up in the
+    // percentiles that rank them
+    RepeatScope("OneSlow", 1);
+    RepeatScope("FiveSlow", 5);
+    RepeatScope("SixSlow", 6);
+    profiling_stop();
+
+    auto report = profiling_get_report();
+    ASSERT_EQ(report.size(), 3U);
+
+    ASSERT_EQ(report[0].name, "OneSlow");
+    ASSERT_LT(report[0].p95_milliseconds, SlowMilliseconds);
+    ASSERT_LT(report[0].p99_milliseconds, SlowMilliseconds);
+    ASSERT_GE(report[0].max_milliseconds, SlowMilliseconds);
+
+    ASSERT_EQ(report[1].name, "FiveSlow");
+    ASSERT_LT(report[1].p50_milliseconds, SlowMilliseconds);
+    ASSERT_LT(report[1].p95_milliseconds, SlowMilliseconds);
+    ASSERT_GE(report[1].p99_milliseconds, SlowMilliseconds);
+
+    ASSERT_EQ(report[2].name, "SixSlow");
+    ASSERT_LT(report[2].p50_milliseconds, SlowMilliseconds);
+    ASSERT_GE(report[2].p95_milliseconds, SlowMilliseconds);
+    ASSERT_GE(report[2].p99_milliseconds, SlowMilliseconds);
+    ASSERT_GE(report[2].total_milliseconds, 6 * SlowMilliseconds);
+    ASSERT_NEAR(report[2].mean_milliseconds, report[2].total_milliseconds / 100, 0.000001);
+}
@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include <string>
+#include <vector>
 #include <gtest/gtest.h>
 #include <openrct2/audio/AudioContext.h>
 #include <openrct2/Context.h>
@@ -16,6 +17,7 @@
 #include <openrct2/core/String.hpp>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ride/Ride.h>
+#include <openrct2/ride/RideRatings.h>
 #include "TestData.h"
 
 #include <openrct2/platform/platform.h>
@@ -51,6 +53,20 @@ protected:
         }
     }
 
+    std::vector<std::string> GetAllRatings()
+    {
+        std::vector<std::string> ratings;
+        for (int rideId = 0; rideId < MAX_RIDES; rideId++)
+        {
+            Ride * ride = get_ride(rideId);
+            if (ride->type != RIDE_TYPE_NULL)
+            {
+                ratings.push_back(FormatRatings(ride) + String::StdFormat(" value %d", (int)ride->value));
+            }
+        }
+        return ratings;
+    }
+
     std::string FormatRatings(Ride * ride)
     {
         rating_tuple ratings = ride->ratings;
@@ -101,3 +117,43 @@ TEST_F(RideRatings, all)
         }
     }
 }
+
+TEST_F(RideRatings, batch)
+{
+    std::string path = TestData::GetParkPath("bpb.sv6");
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    core_init();
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    load_from_sv6(path.c_str());
+    ASSERT_EQ(gRideCount, 134);
+
+    CalculateRatingsForAllRides();
+    auto expectedRatings = GetAllRatings();
+
+    // Rate the same rides of a freshly loaded park as one batch, which spreads them over the job pool
+    load_from_sv6(path.c_str());
+    ASSERT_EQ(gRideCount, 134);
+
+    std::vector<uint8_t> rideIndices;
+    for (int rideId = 0; rideId < MAX_RIDES; rideId++)
+    {
+        if (get_ride(rideId)->type != RIDE_TYPE_NULL)
+        {
+            rideIndices.push_back((uint8_t)rideId);
+        }
+    }
+    ride_ratings_update_rides(rideIndices);
+
+    auto batchRatings = GetAllRatings();
+    ASSERT_EQ(batchRatings.size(), expectedRatings.size());
+    for (size_t i = 0; i < batchRatings.size(); i++)
+    {
+        ASSERT_STREQ(batchRatings[i].c_str(), expectedRatings[i].c_str());
+    }
+}
@@ -0,0 +1,220 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/actions/GuestSetNameAction.hpp>
+#include <openrct2/actions/StaffSetNameAction.hpp>
+#include <openrct2/Context.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/localisation/Localisation.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/peep/Peep.h>
+#include <openrct2/rct12/SawyerChunkReader.h>
+#include <openrct2/rct2/S6Exporter.h>
+#include <openrct2/ride/Ride.h>
+#include <openrct2/ride/Station.h>
+#include <openrct2/world/Sprite.h>
+
+using namespace OpenRCT2;
+
+class SpriteList : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        gOpenRCT2Headless   = true;
+        gOpenRCT2NoGraphics = true;
+        _context            = CreateContext();
+        bool initialised    = _context->Initialise();
+        ASSERT_TRUE(initialised);
+    }
+
+    void SetUp() override
+    {
+        reset_sprite_list();
+    }
+
+    // Creates sprites until one is beyond the sprites that fit in an S6 file and turns it into a peep
+    static rct_peep * CreatePeepInExtendedList(uint8_t type)
+    {
+        rct_sprite * sprite;
+        do
+        {
+            sprite = create_sprite(SPRITE_IDENTIFIER_PEEP);
+            if (sprite == nullptr)
+            {
+                return nullptr;
+            }
+        }
+        while (sprite->unknown.sprite_index < MAX_SPRITES);
+
+        move_sprite_to_list(sprite, SPRITE_LIST_PEEP * 2);
+        rct_peep * peep = &sprite->peep;
+        peep->sprite_identifier = SPRITE_IDENTIFIER_PEEP;
+        peep->type = type;
+        peep->name_string_idx = type == PEEP_TYPE_GUEST ? STR_GUEST_X : STR_HANDYMAN_X;
+        peep->id = 1;
+        return peep;
+    }
+
+    // Reads a saved game the way RCT2 does, stopping before the extended sprites
+    static std::unique_ptr<rct_s6_data> ReadRCT2Part(MemoryStream * stream)
+    {
+        auto s6 = std::make_unique<rct_s6_data>();
+        stream->SetPosition(0);
+        auto chunkReader = SawyerChunkReader(stream);
+        chunkReader.ReadChunk(&s6->header, sizeof(s6->header));
+        chunkReader.ReadChunk(&s6->objects, sizeof(s6->objects));
+        chunkReader.ReadChunk(&s6->elapsed_months, 16);
+        chunkReader.ReadChunk(&s6->tile_elements, sizeof(s6->tile_elements));
+        chunkReader.ReadChunk(&s6->next_free_tile_element_pointer_index, 3048816);
+        return s6;
+    }
+
+    static std::string GetPeepName(rct_peep * peep)
+    {
+        char name[256];
+        set_format_arg(0, uint32_t, peep->id);
+        format_string(name, sizeof(name), peep->name_string_idx, gCommonFormatArgs);
+        return name;
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> SpriteList::_context;
+
+TEST_F(SpriteList, RenameGuestBeyondMaxSprites)
+{
+    rct_peep * peep = CreatePeepInExtendedList(PEEP_TYPE_GUEST);
+    ASSERT_NE(peep, nullptr);
+    ASSERT_GE(sprite_get_capacity(), (size_t)MAX_SPRITES + 1);
+
+    auto action = GuestSetNameAction(peep->sprite_index, "Extended Guest");
+    auto result = GameActions::Execute(&action);
+    ASSERT_EQ(result->Error, GA_ERROR::OK);
+    ASSERT_EQ(GetPeepName(peep), "Extended Guest");
+}
+
+TEST_F(SpriteList, RenameStaffBeyondMaxSprites)
+{
+    rct_peep * peep = CreatePeepInExtendedList(PEEP_TYPE_STAFF);
+    ASSERT_NE(peep, nullptr);
+
+    auto action = StaffSetNameAction(peep->sprite_index, "Extended Handyman");
+    auto result = GameActions::Execute(&action);
+    ASSERT_EQ(result->Error, GA_ERROR::OK);
+    ASSERT_EQ(GetPeepName(peep), "Extended Handyman");
+}
+
+TEST_F(SpriteList, RenameBeyondCapacityFails)
+{
+    auto action = GuestSetNameAction((uint16_t)sprite_get_capacity(), "Nobody");
+    auto result = GameActions::Query(&action);
+    ASSERT_EQ(result->Error, GA_ERROR::INVALID_PARAMETERS);
+}
+
+TEST_F(SpriteList, ResetKeepsBaseSpriteAddresses)
+{
+    rct_sprite * first = get_sprite(0);
+    rct_sprite * last = get_sprite(MAX_SPRITES - 1);
+    rct_peep * peep = CreatePeepInExtendedList(PEEP_TYPE_GUEST);
+    ASSERT_NE(peep, nullptr);
+
+    reset_sprite_list();
+    ASSERT_EQ(sprite_get_capacity(), (size_t)MAX_SPRITES);
+    ASSERT_EQ(get_sprite(0), first);
+    ASSERT_EQ(get_sprite(MAX_SPRITES - 1), last);
+    ASSERT_EQ(last->unknown.sprite_identifier, SPRITE_IDENTIFIER_NULL);
+}
+
+TEST_F(SpriteList, SaveKeepsSpritesBeyondMaxSprites)
+{
+    rct_sprite * basePeep = create_sprite(SPRITE_IDENTIFIER_PEEP);
+    ASSERT_NE(basePeep, nullptr);
+    move_sprite_to_list(basePeep, SPRITE_LIST_PEEP * 2);
+    rct_peep * extendedPeep = CreatePeepInExtendedList(PEEP_TYPE_GUEST);
+    ASSERT_NE(extendedPeep, nullptr);
+    uint16_t baseIndex = basePeep->unknown.sprite_index;
+    uint16_t extendedIndex = extendedPeep->sprite_index;
+
+    MemoryStream stream;
+    auto exporter = std::make_unique<S6Exporter>();
+    exporter->Export();
+    exporter->SaveGame(&stream);
+
+    reset_sprite_list();
+    stream.SetPosition(0);
+    auto context = GetContext();
+    auto importer = ParkImporter::CreateS6(context->GetObjectRepository(), context->GetObjectManager());
+    importer->LoadFromStream(&stream, false);
+    importer->Import();
+
+    // The extended peep was put at the front of the peep list, followed by the one within the RCT2 limit
+    ASSERT_GT(sprite_get_capacity(), (size_t)extendedIndex);
+    ASSERT_EQ(gSpriteListCount[SPRITE_LIST_PEEP], 2);
+    ASSERT_EQ(gSpriteListHead[SPRITE_LIST_PEEP], extendedIndex);
+    ASSERT_EQ(get_sprite(extendedIndex)->unknown.next, baseIndex);
+    ASSERT_EQ(get_sprite(baseIndex)->unknown.previous, extendedIndex);
+}
+
+TEST_F(SpriteList, SaveCutsQueueReferencesBeyondMaxSprites)
+{
+    rct_sprite * basePeep = create_sprite(SPRITE_IDENTIFIER_PEEP);
+    ASSERT_NE(basePeep, nullptr);
+    move_sprite_to_list(basePeep, SPRITE_LIST_PEEP * 2);
+    basePeep->peep.sprite_identifier = SPRITE_IDENTIFIER_PEEP;
+    rct_peep * extendedPeep = CreatePeepInExtendedList(PEEP_TYPE_GUEST);
+    ASSERT_NE(extendedPeep, nullptr);
+    uint16_t baseIndex = basePeep->unknown.sprite_index;
+    uint16_t extendedIndex = extendedPeep->sprite_index;
+
+    // The peep within the limit queues behind the extended peep, which is also the last in the queue of another station
+    Ride * ride = get_ride(0);
+    *ride = {};
+    ride->type = RIDE_TYPE_MERRY_GO_ROUND;
+    for (int32_t i = 0; i < MAX_STATIONS; i++)
+    {
+        ride->station_starts[i].xy = RCT_XY8_UNDEFINED;
+        ride_clear_entrance_location(ride, i);
+        ride_clear_exit_location(ride, i);
+        ride->last_peep_in_queue[i] = SPRITE_INDEX_NULL;
+    }
+    ride->last_peep_in_queue[0] = baseIndex;
+    ride->last_peep_in_queue[1] = extendedIndex;
+    basePeep->peep.next_in_queue = extendedIndex;
+    extendedPeep->next_in_queue = SPRITE_INDEX_NULL;
+
+    MemoryStream stream;
+    auto exporter = std::make_unique<S6Exporter>();
+    exporter->Export();
+    exporter->SaveGame(&stream);
+
+    // RCT2 must not be able to follow either queue into the extended sprites
+    auto s6 = ReadRCT2Part(&stream);
+    ASSERT_EQ(s6->rides[0].last_peep_in_queue[0], baseIndex);
+    ASSERT_EQ(s6->rides[0].last_peep_in_queue[1], SPRITE_INDEX_NULL);
+    ASSERT_EQ(s6->sprites[baseIndex].peep.next_in_queue, SPRITE_INDEX_NULL);
+
+    // Importing the whole file puts both queues back
+    reset_sprite_list();
+    stream.SetPosition(0);
+    auto context = GetContext();
+    auto importer = ParkImporter::CreateS6(context->GetObjectRepository(), context->GetObjectManager());
+    importer->LoadFromStream(&stream, false);
+    importer->Import();
+
+    ride = get_ride(0);
+    ASSERT_EQ(ride->last_peep_in_queue[0], baseIndex);
+    ASSERT_EQ(ride->last_peep_in_queue[1], extendedIndex);
+    ASSERT_EQ(get_sprite(baseIndex)->peep.next_in_queue, extendedIndex);
+    ride->type = RIDE_TYPE_NULL;
+}